@@ -0,0 +1,164 @@
+#include <migraphx/allocator.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/env.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <mutex>
+#include <sys/mman.h>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_HUGE_PAGES)
+
+const std::size_t huge_page_size = 2 * 1024 * 1024;
+
+static std::size_t round_up(std::size_t n, std::size_t m) { return (n + m - 1) / m * m; }
+
+std::string aligned_allocator::name() const { return "aligned_allocator"; }
+
+char* aligned_allocator::allocate(std::size_t bytes) const
+{
+    bytes = std::max<std::size_t>(bytes, 1);
+    if(pages == huge_pages::explicit_pages and bytes >= huge_page_threshold)
+    {
+        auto n  = round_up(bytes, huge_page_size);
+        auto* p = mmap(
+            nullptr, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if(p != MAP_FAILED)
+            return static_cast<char*>(p);
+        // The huge page pool is exhausted or not reserved so use default pages with a hint
+        p = mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(p == MAP_FAILED)
+            return nullptr;
+        madvise(p, n, MADV_HUGEPAGE);
+        return static_cast<char*>(p);
+    }
+    void* p    = nullptr;
+    auto align = std::max(alignment, sizeof(void*));
+    auto n     = bytes;
+    if(pages == huge_pages::transparent and bytes >= huge_page_threshold)
+    {
+        // Allocate whole huge pages so the advice doesn't cover memory past the block
+        align = std::max(align, huge_page_size);
+        n     = round_up(bytes, huge_page_size);
+    }
+    if(posix_memalign(&p, align, n) != 0)
+        return nullptr;
+    if(pages == huge_pages::transparent and bytes >= huge_page_threshold)
+        madvise(p, n, MADV_HUGEPAGE);
+    return static_cast<char*>(p);
+}
+
+void aligned_allocator::deallocate(char* p, std::size_t bytes) const
+{
+    if(p == nullptr)
+        return;
+    bytes = std::max<std::size_t>(bytes, 1);
+    if(pages == huge_pages::explicit_pages and bytes >= huge_page_threshold)
+        munmap(p, round_up(bytes, huge_page_size));
+    else
+        std::free(p); // NOLINT
+}
+
+std::ostream& operator<<(std::ostream& os, const allocation_stats& s)
+{
+    os << "Allocations: " << s.allocations << ", Deallocations: " << s.deallocations;
+    os << ", Bytes in use: " << s.bytes_in_use << ", Peak bytes: " << s.peak_bytes;
+    os << ", Total bytes: " << s.total_bytes;
+    return os;
+}
+
+static allocator default_allocator()
+{
+    aligned_allocator a;
+    auto pages = string_value_of(MIGRAPHX_HUGE_PAGES{});
+    if(pages == "transparent")
+        a.pages = huge_pages::transparent;
+    else if(pages == "explicit")
+        a.pages = huge_pages::explicit_pages;
+    else if(not pages.empty() and pages != "none")
+        MIGRAPHX_THROW("Unknown value for MIGRAPHX_HUGE_PAGES: " + pages);
+    return a;
+}
+
+struct allocator_state
+{
+    std::mutex m;
+    allocator current = default_allocator();
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> deallocations{0};
+    std::atomic<std::size_t> bytes_in_use{0};
+    std::atomic<std::size_t> peak_bytes{0};
+    std::atomic<std::size_t> total_bytes{0};
+
+    void record_allocation(std::size_t bytes)
+    {
+        allocations++;
+        total_bytes += bytes;
+        auto in_use = bytes_in_use += bytes;
+        auto peak   = peak_bytes.load();
+        while(in_use > peak and not peak_bytes.compare_exchange_weak(peak, in_use))
+            ;
+    }
+
+    void record_deallocation(std::size_t bytes)
+    {
+        deallocations++;
+        bytes_in_use -= bytes;
+    }
+};
+
+static allocator_state& get_allocator_state()
+{
+    // Never destroyed so buffers released during static destruction can still be recorded
+    static auto* state = new allocator_state{}; // NOLINT
+    return *state;
+}
+
+allocator get_allocator()
+{
+    auto& state = get_allocator_state();
+    std::lock_guard<std::mutex> lock(state.m);
+    return state.current;
+}
+
+void set_allocator(allocator a)
+{
+    auto& state = get_allocator_state();
+    std::lock_guard<std::mutex> lock(state.m);
+    state.current = std::move(a);
+}
+
+allocation_stats get_allocation_stats()
+{
+    auto& state = get_allocator_state();
+    allocation_stats result;
+    result.allocations   = state.allocations;
+    result.deallocations = state.deallocations;
+    result.bytes_in_use  = state.bytes_in_use;
+    result.peak_bytes    = state.peak_bytes;
+    result.total_bytes   = state.total_bytes;
+    return result;
+}
+
+std::shared_ptr<char> allocate_buffer(std::size_t bytes)
+{
+    auto a  = get_allocator();
+    auto* p = a.allocate(bytes);
+    if(p == nullptr)
+        MIGRAPHX_THROW("Failed to allocate " + std::to_string(bytes) + " bytes with " + a.name());
+    std::memset(p, 0, bytes);
+    get_allocator_state().record_allocation(bytes);
+    // The deleter keeps the allocator that owns the buffer alive
+    return {p, [=](char* x) {
+                a.deallocate(x, bytes);
+                get_allocator_state().record_deallocation(bytes);
+            }};
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
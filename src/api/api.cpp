@@ -10,8 +10,10 @@
 #include <migraphx/ref/target.hpp>
 #include <migraphx/load_save.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/run_queue.hpp>
 #include <migraphx/json.hpp>
 #include <migraphx/convert_to_json.hpp>
+#include <migraphx/dlpack.hpp>
 #include <algorithm>
 
 namespace migraphx {
@@ -177,8 +179,57 @@ bool equal(const T& x, const T& y)
     return x == y;
 }
 
+argument argument_from_dlpack(void* t)
+{
+    return from_dlpack(static_cast<dlpack::managed_tensor*>(t));
+}
+
+void* argument_to_dlpack(const argument& a) { return to_dlpack(a); }
+
 std::vector<argument> run(program& p, const parameter_map& params) { return p.eval(params); }
 
+migraphx_run_status to_run_status(run_status s) { return static_cast<migraphx_run_status>(s); }
+
+run_status to_run_status(migraphx_run_status s) { return static_cast<run_status>(s); }
+
+bool wait_for(const run_request& r, size_t milliseconds)
+{
+    return r.wait_for(std::chrono::milliseconds{milliseconds});
+}
+
+run_queue make_run_queue(const program& p, size_t workers, size_t capacity)
+{
+    run_queue_options options;
+    options.workers  = workers;
+    options.capacity = capacity;
+    return run_queue{p, options};
+}
+
+run_callback make_run_callback(migraphx_run_callback callback, void* data)
+{
+    if(callback == nullptr)
+        return nullptr;
+    return [=](run_status s) { callback(to_run_status(s), data); };
+}
+
+run_request submit(run_queue& q,
+                   const parameter_map& params,
+                   const std::vector<argument>& outputs,
+                   migraphx_run_callback callback,
+                   void* data)
+{
+    return q.submit(params, outputs, make_run_callback(callback, data));
+}
+
+run_request try_submit(run_queue& q,
+                       const parameter_map& params,
+                       const std::vector<argument>& outputs,
+                       migraphx_run_callback callback,
+                       void* data)
+{
+    return q.try_submit(params, outputs, make_run_callback(callback, data));
+}
+
 std::vector<shape> get_output_shapes(program& p) { return p.get_output_shapes(); }
 
 void print_program(const program& p) { std::cout << p << std::endl; }
@@ -300,6 +351,26 @@ struct migraphx_program
     migraphx::program object;
 };
 
+extern "C" struct migraphx_run_request;
+struct migraphx_run_request
+{
+    template <class... Ts>
+    migraphx_run_request(Ts&&... xs) : object(std::forward<Ts>(xs)...)
+    {
+    }
+    migraphx::run_request object;
+};
+
+extern "C" struct migraphx_run_queue;
+struct migraphx_run_queue
+{
+    template <class... Ts>
+    migraphx_run_queue(Ts&&... xs) : object(std::forward<Ts>(xs)...)
+    {
+    }
+    migraphx::run_queue object;
+};
+
 extern "C" struct migraphx_operation;
 struct migraphx_operation
 {
@@ -474,6 +545,15 @@ migraphx_argument_create(migraphx_argument_t* argument, const_migraphx_shape_t s
     });
 }
 
+extern "C" migraphx_status migraphx_argument_create_from_dlpack(migraphx_argument_t* argument,
+                                                                void* dltensor)
+{
+    return migraphx::try_([&] {
+        *argument = object_cast<migraphx_argument_t>(
+            allocate<migraphx::argument>(migraphx::argument_from_dlpack((dltensor))));
+    });
+}
+
 extern "C" migraphx_status migraphx_argument_shape(const_migraphx_shape_t* out,
                                                    const_migraphx_argument_t argument)
 {
@@ -493,6 +573,16 @@ extern "C" migraphx_status migraphx_argument_buffer(char** out, const_migraphx_a
     });
 }
 
+extern "C" migraphx_status migraphx_argument_to_dlpack(void** out,
+                                                       const_migraphx_argument_t argument)
+{
+    return migraphx::try_([&] {
+        if(argument == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter argument: Null pointer");
+        *out = migraphx::argument_to_dlpack((argument->object));
+    });
+}
+
 extern "C" migraphx_status
 migraphx_argument_equal(bool* out, const_migraphx_argument_t argument, const_migraphx_argument_t x)
 {
@@ -609,6 +699,26 @@ extern "C" migraphx_status migraphx_arguments_destroy(migraphx_arguments_t argum
     return migraphx::try_([&] { destroy((arguments)); });
 }
 
+extern "C" migraphx_status migraphx_arguments_create(migraphx_arguments_t* arguments)
+{
+    return migraphx::try_([&] {
+        *arguments =
+            object_cast<migraphx_arguments_t>(allocate<std::vector<migraphx::argument>>());
+    });
+}
+
+extern "C" migraphx_status migraphx_arguments_add(migraphx_arguments_t arguments,
+                                                  const_migraphx_argument_t argument)
+{
+    return migraphx::try_([&] {
+        if(arguments == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter arguments: Null pointer");
+        if(argument == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter argument: Null pointer");
+        (arguments->object).push_back((argument->object));
+    });
+}
+
 extern "C" migraphx_status migraphx_arguments_size(size_t* out, migraphx_arguments_t arguments)
 {
     return migraphx::try_([&] {
@@ -757,6 +867,142 @@ migraphx_program_equal(bool* out, const_migraphx_program_t program, const_migrap
     });
 }
 
+extern "C" migraphx_status migraphx_run_request_destroy(migraphx_run_request_t run_request)
+{
+    return migraphx::try_([&] { destroy((run_request)); });
+}
+
+extern "C" migraphx_status migraphx_run_request_status(migraphx_run_status* out,
+                                                       const_migraphx_run_request_t run_request)
+{
+    return migraphx::try_([&] {
+        if(out == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter out: Null pointer");
+        if(run_request == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_request: Null pointer");
+        *out = migraphx::to_run_status((run_request->object).status());
+    });
+}
+
+extern "C" migraphx_status migraphx_run_request_done(bool* out,
+                                                     const_migraphx_run_request_t run_request)
+{
+    return migraphx::try_([&] {
+        if(run_request == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_request: Null pointer");
+        *out = (run_request->object).done();
+    });
+}
+
+extern "C" migraphx_status migraphx_run_request_wait(const_migraphx_run_request_t run_request)
+{
+    return migraphx::try_([&] {
+        if(run_request == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_request: Null pointer");
+        (run_request->object).wait();
+    });
+}
+
+extern "C" migraphx_status migraphx_run_request_wait_for(bool* out,
+                                                         const_migraphx_run_request_t run_request,
+                                                         size_t milliseconds)
+{
+    return migraphx::try_([&] {
+        if(run_request == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_request: Null pointer");
+        *out = migraphx::wait_for((run_request->object), (milliseconds));
+    });
+}
+
+extern "C" migraphx_status migraphx_run_request_get(migraphx_arguments_t* out,
+                                                    const_migraphx_run_request_t run_request)
+{
+    return migraphx::try_([&] {
+        if(run_request == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_request: Null pointer");
+        *out = allocate<migraphx_arguments_t>((run_request->object).get());
+    });
+}
+
+extern "C" migraphx_status migraphx_run_queue_destroy(migraphx_run_queue_t run_queue)
+{
+    return migraphx::try_([&] { destroy((run_queue)); });
+}
+
+extern "C" migraphx_status migraphx_run_queue_create(migraphx_run_queue_t* run_queue,
+                                                     const_migraphx_program_t program,
+                                                     size_t workers,
+                                                     size_t capacity)
+{
+    return migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        *run_queue = object_cast<migraphx_run_queue_t>(allocate<migraphx::run_queue>(
+            migraphx::make_run_queue((program->object), (workers), (capacity))));
+    });
+}
+
+extern "C" migraphx_status migraphx_run_queue_submit(migraphx_run_request_t* out,
+                                                     migraphx_run_queue_t run_queue,
+                                                     migraphx_program_parameters_t params,
+                                                     migraphx_arguments_t outputs,
+                                                     migraphx_run_callback callback,
+                                                     void* data)
+{
+    return migraphx::try_([&] {
+        if(run_queue == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_queue: Null pointer");
+        if(params == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter params: Null pointer");
+        if(outputs == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter outputs: Null pointer");
+        *out = allocate<migraphx_run_request_t>(migraphx::submit(
+            (run_queue->object), (params->object), (outputs->object), (callback), (data)));
+    });
+}
+
+extern "C" migraphx_status migraphx_run_queue_try_submit(migraphx_run_request_t* out,
+                                                         migraphx_run_queue_t run_queue,
+                                                         migraphx_program_parameters_t params,
+                                                         migraphx_arguments_t outputs,
+                                                         migraphx_run_callback callback,
+                                                         void* data)
+{
+    return migraphx::try_([&] {
+        if(run_queue == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_queue: Null pointer");
+        if(params == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter params: Null pointer");
+        if(outputs == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter outputs: Null pointer");
+        *out = allocate<migraphx_run_request_t>(migraphx::try_submit(
+            (run_queue->object), (params->object), (outputs->object), (callback), (data)));
+    });
+}
+
+extern "C" migraphx_status migraphx_run_queue_cancel(bool* out,
+                                                     migraphx_run_queue_t run_queue,
+                                                     const_migraphx_run_request_t request)
+{
+    return migraphx::try_([&] {
+        if(run_queue == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_queue: Null pointer");
+        if(request == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter request: Null pointer");
+        *out = (run_queue->object).cancel((request->object));
+    });
+}
+
+extern "C" migraphx_status migraphx_run_queue_size(size_t* out,
+                                                   const_migraphx_run_queue_t run_queue)
+{
+    return migraphx::try_([&] {
+        if(run_queue == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter run_queue: Null pointer");
+        *out = (run_queue->object).size();
+    });
+}
+
 extern "C" migraphx_status migraphx_operation_destroy(migraphx_operation_t operation)
 {
     return migraphx::try_([&] { destroy((operation)); });
@@ -61,6 +61,19 @@ typedef struct
     const char* format;
 } migraphx_file_options;
 
+/// Status of a request submitted to a run queue
+typedef enum {
+    migraphx_run_queued,
+    migraphx_run_running,
+    migraphx_run_completed,
+    migraphx_run_failed,
+    migraphx_run_cancelled,
+    migraphx_run_rejected
+} migraphx_run_status;
+
+/// Called from a worker thread when a request finishes, data is the pointer passed on submit
+typedef void (*migraphx_run_callback)(migraphx_run_status status, void* data);
+
 typedef struct migraphx_shape* migraphx_shape_t;
 typedef const struct migraphx_shape* const_migraphx_shape_t;
 
@@ -88,6 +101,12 @@ typedef const struct migraphx_module* const_migraphx_module_t;
 typedef struct migraphx_program* migraphx_program_t;
 typedef const struct migraphx_program* const_migraphx_program_t;
 
+typedef struct migraphx_run_request* migraphx_run_request_t;
+typedef const struct migraphx_run_request* const_migraphx_run_request_t;
+
+typedef struct migraphx_run_queue* migraphx_run_queue_t;
+typedef const struct migraphx_run_queue* const_migraphx_run_queue_t;
+
 typedef struct migraphx_operation* migraphx_operation_t;
 typedef const struct migraphx_operation* const_migraphx_operation_t;
 
@@ -138,11 +157,16 @@ migraphx_status migraphx_argument_destroy(migraphx_argument_t argument);
 migraphx_status
 migraphx_argument_create(migraphx_argument_t* argument, const_migraphx_shape_t shape, void* buffer);
 
+migraphx_status migraphx_argument_create_from_dlpack(migraphx_argument_t* argument,
+                                                     void* dltensor);
+
 migraphx_status migraphx_argument_shape(const_migraphx_shape_t* out,
                                         const_migraphx_argument_t argument);
 
 migraphx_status migraphx_argument_buffer(char** out, const_migraphx_argument_t argument);
 
+migraphx_status migraphx_argument_to_dlpack(void** out, const_migraphx_argument_t argument);
+
 migraphx_status
 migraphx_argument_equal(bool* out, const_migraphx_argument_t argument, const_migraphx_argument_t x);
 
@@ -179,6 +203,11 @@ migraphx_status migraphx_program_parameters_add(migraphx_program_parameters_t pr
 
 migraphx_status migraphx_arguments_destroy(migraphx_arguments_t arguments);
 
+migraphx_status migraphx_arguments_create(migraphx_arguments_t* arguments);
+
+migraphx_status migraphx_arguments_add(migraphx_arguments_t arguments,
+                                       const_migraphx_argument_t argument);
+
 migraphx_status migraphx_arguments_size(size_t* out, migraphx_arguments_t arguments);
 
 migraphx_status
@@ -219,6 +248,49 @@ migraphx_status migraphx_program_run(migraphx_arguments_t* out,
 migraphx_status
 migraphx_program_equal(bool* out, const_migraphx_program_t program, const_migraphx_program_t x);
 
+migraphx_status migraphx_run_request_destroy(migraphx_run_request_t run_request);
+
+migraphx_status migraphx_run_request_status(migraphx_run_status* out,
+                                            const_migraphx_run_request_t run_request);
+
+migraphx_status migraphx_run_request_done(bool* out, const_migraphx_run_request_t run_request);
+
+migraphx_status migraphx_run_request_wait(const_migraphx_run_request_t run_request);
+
+migraphx_status migraphx_run_request_wait_for(bool* out,
+                                              const_migraphx_run_request_t run_request,
+                                              size_t milliseconds);
+
+migraphx_status migraphx_run_request_get(migraphx_arguments_t* out,
+                                         const_migraphx_run_request_t run_request);
+
+migraphx_status migraphx_run_queue_destroy(migraphx_run_queue_t run_queue);
+
+migraphx_status migraphx_run_queue_create(migraphx_run_queue_t* run_queue,
+                                          const_migraphx_program_t program,
+                                          size_t workers,
+                                          size_t capacity);
+
+migraphx_status migraphx_run_queue_submit(migraphx_run_request_t* out,
+                                          migraphx_run_queue_t run_queue,
+                                          migraphx_program_parameters_t params,
+                                          migraphx_arguments_t outputs,
+                                          migraphx_run_callback callback,
+                                          void* data);
+
+migraphx_status migraphx_run_queue_try_submit(migraphx_run_request_t* out,
+                                              migraphx_run_queue_t run_queue,
+                                              migraphx_program_parameters_t params,
+                                              migraphx_arguments_t outputs,
+                                              migraphx_run_callback callback,
+                                              void* data);
+
+migraphx_status migraphx_run_queue_cancel(bool* out,
+                                          migraphx_run_queue_t run_queue,
+                                          const_migraphx_run_request_t request);
+
+migraphx_status migraphx_run_queue_size(size_t* out, const_migraphx_run_queue_t run_queue);
+
 migraphx_status migraphx_operation_destroy(migraphx_operation_t operation);
 
 migraphx_status migraphx_operation_create(migraphx_operation_t* operation,
@@ -6,6 +6,8 @@
 #include <exception>
 #include <vector>
 #include <cassert>
+#include <chrono>
+#include <functional>
 #include <iostream>
 
 namespace migraphx {
@@ -322,6 +324,21 @@ struct argument : MIGRAPHX_CONST_HANDLE_BASE(argument)
         return pout;
     }
 
+    /// Export as a DLManagedTensor that shares the data, the caller must call its deleter
+    void* to_dlpack() const
+    {
+        void* pout;
+        call(&migraphx_argument_to_dlpack, &pout, this->get_handle_ptr());
+        return pout;
+    }
+
+    /// Wrap a host DLManagedTensor without copying, the argument takes ownership of the tensor
+    static argument from_dlpack(void* dltensor)
+    {
+        return argument(make<migraphx_argument>(&migraphx_argument_create_from_dlpack, dltensor),
+                        own{});
+    }
+
     /// Generate an argument using random data
     static argument generate(shape ps, size_t pseed = 0)
     {
@@ -427,6 +444,22 @@ struct arguments : MIGRAPHX_HANDLE_BASE(arguments), array_base<arguments>
 
     arguments(migraphx_arguments* p, borrow) { this->set_handle(p, borrow{}); }
 
+    arguments() { this->make_handle(&migraphx_arguments_create); }
+
+    /// Construct the arguments from initializer_list
+    arguments(std::initializer_list<argument> l)
+    {
+        this->make_handle(&migraphx_arguments_create);
+        for(auto&& a : l)
+            this->add(a);
+    }
+
+    /// Add a new argument
+    void add(const argument& pargument) const
+    {
+        call(&migraphx_arguments_add, this->get_handle_ptr(), pargument.get_handle_ptr());
+    }
+
     size_t size() const
     {
         size_t pout;
@@ -565,6 +598,127 @@ struct program : MIGRAPHX_HANDLE_BASE(program)
     friend bool operator!=(const program& px, const program& py) { return !(px == py); }
 };
 
+/// A handle to a request submitted to a run_queue
+struct run_request : MIGRAPHX_CONST_HANDLE_BASE(run_request)
+{
+    run_request(migraphx_run_request* p, own) { this->set_handle(p, own{}); }
+
+    migraphx_run_status status() const
+    {
+        migraphx_run_status pout;
+        call(&migraphx_run_request_status, &pout, this->get_handle_ptr());
+        return pout;
+    }
+
+    /// Whether the request will no longer change its status
+    bool done() const
+    {
+        bool pout;
+        call(&migraphx_run_request_done, &pout, this->get_handle_ptr());
+        return pout;
+    }
+
+    void wait() const { call(&migraphx_run_request_wait, this->get_handle_ptr()); }
+
+    /// Returns true if the request is done before the timeout
+    bool wait_for(std::chrono::milliseconds ptimeout) const
+    {
+        bool pout;
+        call(&migraphx_run_request_wait_for, &pout, this->get_handle_ptr(), ptimeout.count());
+        return pout;
+    }
+
+    /// Wait for the request and return the outputs, throws if it did not complete
+    arguments get() const
+    {
+        migraphx_arguments_t pout;
+        call(&migraphx_run_request_get, &pout, this->get_handle_ptr());
+        return arguments(pout, own{});
+    }
+};
+
+/// Evaluates a program asynchronously on a pool of workers with a bounded queue
+struct run_queue : MIGRAPHX_HANDLE_BASE(run_queue)
+{
+    /// The callback is called once from a worker thread when the request finishes
+    using callback = std::function<void(migraphx_run_status)>;
+
+    run_queue(migraphx_run_queue* p, own) { this->set_handle(p, own{}); }
+
+    run_queue(const program& pprogram, size_t pworkers = 1, size_t pcapacity = 16)
+    {
+        this->make_handle(
+            &migraphx_run_queue_create, pprogram.get_handle_ptr(), pworkers, pcapacity);
+    }
+
+    /// Submit a request, this blocks while the queue is full
+    run_request submit(const program_parameters& pparams,
+                       const arguments& poutputs = arguments{},
+                       callback pcallback        = nullptr) const
+    {
+        return this->submit_with(&migraphx_run_queue_submit, pparams, poutputs, pcallback);
+    }
+
+    /// Submit a request, it is rejected when the queue is full
+    run_request try_submit(const program_parameters& pparams,
+                           const arguments& poutputs = arguments{},
+                           callback pcallback        = nullptr) const
+    {
+        return this->submit_with(&migraphx_run_queue_try_submit, pparams, poutputs, pcallback);
+    }
+
+    /// Cancel the request if it hasn't started running
+    bool cancel(const run_request& prequest) const
+    {
+        bool pout;
+        call(&migraphx_run_queue_cancel, &pout, this->get_handle_ptr(), prequest.get_handle_ptr());
+        return pout;
+    }
+
+    /// Number of requests waiting to run
+    size_t size() const
+    {
+        size_t pout;
+        call(&migraphx_run_queue_size, &pout, this->get_handle_ptr());
+        return pout;
+    }
+
+    private:
+    template <class F>
+    run_request submit_with(F f,
+                            const program_parameters& pparams,
+                            const arguments& poutputs,
+                            callback pcallback) const
+    {
+        migraphx_run_callback c = nullptr;
+        callback* data          = nullptr;
+        if(pcallback)
+        {
+            // The callback is always called exactly once, so it can free the data
+            data = new callback(std::move(pcallback)); // NOLINT
+            c    = [](migraphx_run_status status, void* pdata) {
+                std::unique_ptr<callback> cb{static_cast<callback*>(pdata)};
+                (*cb)(status);
+            };
+        }
+        try
+        {
+            return run_request(make<migraphx_run_request>(f,
+                                                          this->get_handle_ptr(),
+                                                          pparams.get_handle_ptr(),
+                                                          poutputs.get_handle_ptr(),
+                                                          c,
+                                                          data),
+                               own{});
+        }
+        catch(...)
+        {
+            delete data; // NOLINT
+            throw;
+        }
+    }
+};
+
 struct operation : MIGRAPHX_HANDLE_BASE(operation)
 {
     operation(migraphx_operation* p, own) { this->set_handle(p, own{}); }
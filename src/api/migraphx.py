@@ -66,6 +66,17 @@ def tf_options_type_wrap(p):
         p.read = '${name} == nullptr ? migraphx::tf_options{} : migraphx::to_tf_options(*${name})'
 
 
+@api.cwrap('migraphx::run_status')
+def run_status_type_wrap(p):
+    if p.returns:
+        p.add_param('migraphx_run_status *')
+        p.bad_param('${name} == nullptr', 'Null pointer')
+        p.write = ['*${name} = migraphx::to_run_status(${result})']
+    else:
+        p.add_param('migraphx_run_status')
+        p.read = 'migraphx::to_run_status(${name})'
+
+
 def auto_handle(*args, **kwargs):
     def with_handle(f):
         return api.handle('migraphx_' + f.__name__, 'migraphx::' + f.__name__,
@@ -104,6 +115,9 @@ def shape(h):
 def argument(h):
     h.constructor('create',
                   api.params(shape='const migraphx::shape&', buffer='void*'))
+    h.constructor('create_from_dlpack',
+                  api.params(dltensor='void*'),
+                  fname='migraphx::argument_from_dlpack')
     h.method('shape',
              fname='get_shape',
              cpp_name='get_shape',
@@ -114,6 +128,10 @@ def argument(h):
              cpp_name='data',
              returns='char*',
              const=True)
+    h.method('to_dlpack',
+             invoke='migraphx::argument_to_dlpack($@)',
+             returns='void*',
+             const=True)
     h.method('equal',
              api.params(x='const migraphx::argument&'),
              invoke='migraphx::equal($@)',
@@ -160,6 +178,10 @@ def program_parameters(h):
 
 @api.handle('migraphx_arguments', 'std::vector<migraphx::argument>')
 def arguments(h):
+    h.constructor('create')
+    h.method('add',
+             api.params(argument='const migraphx::argument&'),
+             fname='push_back')
     h.method('size', returns='size_t')
     h.method('get',
              api.params(idx='size_t'),
@@ -209,6 +231,48 @@ def program(h):
              const=True)
 
 
+@auto_handle()
+def run_request(h):
+    h.method('status', returns='migraphx::run_status', const=True)
+    h.method('done', returns='bool', const=True)
+    h.method('wait', const=True)
+    h.method('wait_for',
+             api.params(milliseconds='size_t'),
+             invoke='migraphx::wait_for($@)',
+             returns='bool',
+             const=True)
+    h.method('get', returns='std::vector<migraphx::argument>', const=True)
+
+
+@auto_handle()
+def run_queue(h):
+    h.constructor('create',
+                  api.params(program='const migraphx::program&',
+                             workers='size_t',
+                             capacity='size_t'),
+                  fname='migraphx::make_run_queue')
+    h.method('submit',
+             api.params(
+                 params='std::unordered_map<std::string, migraphx::argument>',
+                 outputs='std::vector<migraphx::argument>',
+                 callback='migraphx_run_callback',
+                 data='void*'),
+             invoke='migraphx::submit($@)',
+             returns='migraphx::run_request')
+    h.method('try_submit',
+             api.params(
+                 params='std::unordered_map<std::string, migraphx::argument>',
+                 outputs='std::vector<migraphx::argument>',
+                 callback='migraphx_run_callback',
+                 data='void*'),
+             invoke='migraphx::try_submit($@)',
+             returns='migraphx::run_request')
+    h.method('cancel',
+             api.params(request='const migraphx::run_request&'),
+             returns='bool')
+    h.method('size', returns='size_t', const=True)
+
+
 @auto_handle()
 def operation(h):
     h.constructor('create',
@@ -1,4 +1,5 @@
 #include <migraphx/argument.hpp>
+#include <migraphx/allocator.hpp>
 #include <migraphx/functional.hpp>
 #include <unordered_map>
 
@@ -7,7 +8,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 argument::argument(const shape& s) : m_shape(s)
 {
-    auto buffer = make_shared_array<char>(s.bytes());
+    auto buffer = allocate_buffer(s.bytes());
     m_data      = {[=]() mutable { return buffer.get(); }};
 }
 
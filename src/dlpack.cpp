@@ -0,0 +1,121 @@
+#include <migraphx/dlpack.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static dlpack::data_type to_dlpack_type(shape::type_t t)
+{
+    switch(t)
+    {
+    case shape::bool_type: return {dlpack::bool_code, 8, 1};
+    case shape::half_type: return {dlpack::float_code, 16, 1};
+    case shape::float_type: return {dlpack::float_code, 32, 1};
+    case shape::double_type: return {dlpack::float_code, 64, 1};
+    case shape::uint8_type: return {dlpack::uint_code, 8, 1};
+    case shape::int8_type: return {dlpack::int_code, 8, 1};
+    case shape::uint16_type: return {dlpack::uint_code, 16, 1};
+    case shape::int16_type: return {dlpack::int_code, 16, 1};
+    case shape::int32_type: return {dlpack::int_code, 32, 1};
+    case shape::int64_type: return {dlpack::int_code, 64, 1};
+    case shape::uint32_type: return {dlpack::uint_code, 32, 1};
+    case shape::uint64_type: return {dlpack::uint_code, 64, 1};
+    case shape::tuple_type: break;
+    }
+    MIGRAPHX_THROW("DLPACK: Unsupported type: " + shape::name(t));
+}
+
+static shape::type_t from_dlpack_type(dlpack::data_type t)
+{
+    if(t.lanes != 1)
+        MIGRAPHX_THROW("DLPACK: Vector types are not supported");
+    auto match = std::find_if(shape::types().begin(), shape::types().end(), [&](auto x) {
+        if(x == shape::tuple_type)
+            return false;
+        auto dt = to_dlpack_type(x);
+        return dt.code == t.code and dt.bits == t.bits;
+    });
+    if(match == shape::types().end())
+        MIGRAPHX_THROW("DLPACK: Unsupported type code " + std::to_string(t.code) + " with " +
+                       std::to_string(t.bits) + " bits");
+    return *match;
+}
+
+namespace {
+// Owns the exported argument along with the shape arrays referenced by the tensor
+struct dlpack_context
+{
+    argument arg;
+    std::vector<int64_t> lens;
+    std::vector<int64_t> strides;
+    dlpack::managed_tensor tensor;
+};
+} // namespace
+
+dlpack::managed_tensor* to_dlpack(const argument& a)
+{
+    const auto& s = a.get_shape();
+    if(s.type() == shape::tuple_type)
+        MIGRAPHX_THROW("DLPACK: Tuple arguments can not be exported");
+    auto ctx = std::make_unique<dlpack_context>();
+    ctx->arg = a.share();
+    ctx->lens.assign(s.lens().begin(), s.lens().end());
+    ctx->strides.assign(s.strides().begin(), s.strides().end());
+
+    auto& t                 = ctx->tensor.dl_tensor;
+    t.data                  = ctx->arg.data();
+    t.ctx                   = {dlpack::cpu, 0};
+    t.ndim                  = static_cast<int32_t>(ctx->lens.size());
+    t.dtype                 = to_dlpack_type(s.type());
+    t.shape                 = ctx->lens.data();
+    t.strides               = ctx->strides.data();
+    t.byte_offset           = 0;
+    ctx->tensor.manager_ctx = ctx.get();
+    ctx->tensor.deleter     = [](dlpack::managed_tensor* self) {
+        delete static_cast<dlpack_context*>(self->manager_ctx); // NOLINT
+    };
+    return &ctx.release()->tensor;
+}
+
+argument from_dlpack(dlpack::managed_tensor* t)
+{
+    if(t == nullptr)
+        MIGRAPHX_THROW("DLPACK: Null tensor");
+    std::shared_ptr<dlpack::managed_tensor> owner(t, [](dlpack::managed_tensor* x) {
+        if(x->deleter != nullptr)
+            x->deleter(x);
+    });
+    const auto& dl = t->dl_tensor;
+    if(not contains({dlpack::cpu, dlpack::cuda_host, dlpack::rocm_host}, dl.ctx.device_type))
+        MIGRAPHX_THROW("DLPACK: Only host tensors are supported, got device type " +
+                       std::to_string(dl.ctx.device_type));
+    auto type = from_dlpack_type(dl.dtype);
+    shape s{type};
+    // A scalar is represented with zero dimensions
+    if(dl.ndim > 0)
+    {
+        std::vector<std::size_t> lens(dl.shape, dl.shape + dl.ndim);
+        // Null strides means the tensor is packed and row-major
+        if(dl.strides == nullptr)
+        {
+            s = shape{type, lens};
+        }
+        else
+        {
+            if(std::any_of(dl.strides, dl.strides + dl.ndim, [](auto x) { return x < 0; }))
+                MIGRAPHX_THROW("DLPACK: Negative strides are not supported");
+            s = shape{type, lens, std::vector<std::size_t>(dl.strides, dl.strides + dl.ndim)};
+        }
+    }
+    return {s, [owner] {
+                const auto& x = owner->dl_tensor;
+                return static_cast<char*>(x.data) + x.byte_offset;
+            }};
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
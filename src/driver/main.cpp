@@ -3,12 +3,15 @@
 #include "verify.hpp"
 #include "perf.hpp"
 #include "models.hpp"
+#include "msgpack_object.hpp"
 
 #include <migraphx/tf.hpp>
 #include <migraphx/onnx.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/load_save.hpp>
 #include <migraphx/json.hpp>
+#include <migraphx/msgpack.hpp>
+#include <migraphx/time.hpp>
 #include <migraphx/version.h>
 
 #include <migraphx/dead_code_elimination.hpp>
@@ -22,6 +25,7 @@
 #include <migraphx/rewrite_batchnorm.hpp>
 #include <migraphx/simplify_algebra.hpp>
 #include <migraphx/simplify_reshapes.hpp>
+#include <migraphx/sparsify_weights.hpp>
 #include <migraphx/register_target.hpp>
 
 #include <fstream>
@@ -287,14 +291,22 @@ struct compiler_target
 
 struct compiler
 {
-    static const int q_fp16 = 1;
-    static const int q_int8 = 2;
+    static const int q_fp16         = 1;
+    static const int q_int8         = 2;
+    static const int q_int8_weights = 3;
+    static const int q_int4_weights = 4;
+    static const int q_fp16_weights = 5;
     loader l;
     program_params parameters;
     compiler_target ct;
-    bool offload_copy = false;
-    bool fast_math    = true;
-    int quantize      = 0;
+    bool offload_copy             = false;
+    bool fast_math                = true;
+    int quantize                  = 0;
+    std::size_t weight_group_size = 0;
+    bool sparse_weights           = false;
+    float sparse_density          = 0.3f;
+    std::size_t sparse_block_size = 1;
+    bool sparse_verify            = false;
 
     std::vector<std::string> fill0;
     std::vector<std::string> fill1;
@@ -313,6 +325,35 @@ struct compiler
            ap.set_value(false));
         ap(quantize, {"--fp16"}, ap.help("Quantize for fp16"), ap.set_value(q_fp16));
         ap(quantize, {"--int8"}, ap.help("Quantize for int8"), ap.set_value(q_int8));
+        ap(quantize,
+           {"--int8-weights"},
+           ap.help("Quantize the weights of dot to int8"),
+           ap.set_value(q_int8_weights));
+        ap(quantize,
+           {"--int4-weights"},
+           ap.help("Quantize the weights of dot to int4"),
+           ap.set_value(q_int4_weights));
+        ap(quantize,
+           {"--fp16-weights"},
+           ap.help("Store the weights of dot as fp16 and compute in fp32"),
+           ap.set_value(q_fp16_weights));
+        ap(weight_group_size,
+           {"--weight-group-size"},
+           ap.help("Number of weights sharing a scale, or 0 for a scale per output channel"));
+        ap(sparse_weights,
+           {"--sparse-weights"},
+           ap.help("Store the weights of dot in a sparse format when they are mostly zero"),
+           ap.set_value(true));
+        ap(sparse_density,
+           {"--sparse-density"},
+           ap.help("Largest fraction of weight blocks with nonzero values to use a sparse format"));
+        ap(sparse_block_size,
+           {"--sparse-block-size"},
+           ap.help("Number of consecutive weights stored together in the sparse format"));
+        ap(sparse_verify,
+           {"--sparse-verify"},
+           ap.help("Check each sparse dot against the dense weights"),
+           ap.set_value(true));
     }
 
     auto params(const program& p) { return parameters.generate(p, ct.get_target(), offload_copy); }
@@ -332,6 +373,20 @@ struct compiler
         {
             quantize_int8(p, t, {params(p)});
         }
+        else if(quantize == q_int8_weights or quantize == q_int4_weights)
+        {
+            quantize_weights(p, quantize == q_int8_weights ? 8 : 4, weight_group_size);
+        }
+        else if(quantize == q_fp16_weights)
+        {
+            quantize_weights(p, 16);
+        }
+        if(sparse_weights)
+        {
+            run_passes(*p.get_main_module(),
+                       {sparsify_weights{sparse_density, sparse_block_size, sparse_verify},
+                        dead_code_elimination{}});
+        }
         compile_options options;
         options.offload_copy = offload_copy;
         options.fast_math    = fast_math;
@@ -353,6 +408,45 @@ struct read : command<read>
     }
 };
 
+struct load_cmd : command<load_cmd>
+{
+    loader l;
+    unsigned n = 10;
+    void parse(argument_parser& ap)
+    {
+        l.parse(ap);
+        ap(n, {"--iterations", "-n"}, ap.help("Number of times to load the program"));
+    }
+
+    void run()
+    {
+        using milliseconds = std::chrono::duration<double, std::milli>;
+        auto buffer        = save_buffer(l.load());
+        std::cout << "Saved program: " << buffer.size() << " bytes" << std::endl;
+
+        // Time loading through an unpacked msgpack object tree and through the full value tree,
+        // which both hold a copy of every literal, against loading the literals from the buffer
+        double object_ms = 0;
+        double value_ms  = 0;
+        double load_ms   = 0;
+        for(unsigned i = 0; i < n; i++)
+        {
+            object_ms += migraphx::time<milliseconds>([&] {
+                program p;
+                p.from_value(from_msgpack_object(buffer.data(), buffer.size()));
+            });
+            value_ms += migraphx::time<milliseconds>([&] {
+                program p;
+                p.from_value(from_msgpack(buffer));
+            });
+            load_ms += migraphx::time<milliseconds>([&] { load_buffer(buffer); });
+        }
+        std::cout << "Load through msgpack object: " << object_ms / n << "ms" << std::endl;
+        std::cout << "Load through value: " << value_ms / n << "ms" << std::endl;
+        std::cout << "Load: " << load_ms / n << "ms" << std::endl;
+    }
+};
+
 struct params : command<params>
 {
     loader l;
@@ -376,6 +470,8 @@ struct verify : command<verify>
     bool reduce          = false;
     bool offload_copy    = false;
     bool fast_math       = true;
+    bool bisect          = false;
+    std::size_t jobs     = 0;
     void parse(argument_parser& ap)
     {
         l.parse(ap);
@@ -395,6 +491,14 @@ struct verify : command<verify>
            ap.help("Verify each instruction"),
            ap.set_value(true));
         ap(reduce, {"-r", "--reduce"}, ap.help("Reduce program and verify"), ap.set_value(true));
+        ap(jobs,
+           {"-j", "--jobs"},
+           ap.help("Number of instructions to verify concurrently, defaults to the number of "
+                   "hardware threads"));
+        ap(bisect,
+           {"--bisect"},
+           ap.help("Stop at the first instruction that fails to verify"),
+           ap.set_value(true));
     }
 
     void run()
@@ -411,7 +515,7 @@ struct verify : command<verify>
 
         if(per_instruction)
         {
-            verify_instructions(p, t, options, tolerance);
+            verify_instructions(p, t, options, m, tolerance, jobs, bisect);
         }
         else if(reduce)
         {
@@ -465,11 +569,16 @@ struct run_cmd : command<run_cmd>
 struct perf : command<perf>
 {
     compiler c;
-    unsigned n = 100;
+    unsigned n    = 100;
+    bool counters = false;
     void parse(argument_parser& ap)
     {
         c.parse(ap);
         ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to run for perf report"));
+        ap(counters,
+           {"--counters"},
+           ap.help("Collect hardware performance counters for each instruction"),
+           ap.set_value(true));
     }
 
     void run()
@@ -479,7 +588,7 @@ struct perf : command<perf>
         std::cout << "Allocating params ... " << std::endl;
         auto m = c.params(p);
         std::cout << "Running performance report ... " << std::endl;
-        p.perf_report(std::cout, n, m);
+        p.perf_report(std::cout, n, m, counters);
     }
 };
 
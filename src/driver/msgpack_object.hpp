@@ -0,0 +1,18 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_DRIVER_MSGPACK_OBJECT_HPP
+#define MIGRAPHX_GUARD_RTGLIB_DRIVER_MSGPACK_OBJECT_HPP
+
+#include <migraphx/value.hpp>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Decodes the value from the object tree that msgpack::unpack builds, which is how values were
+/// decoded before from_msgpack parsed them directly, so loading can be compared against it
+value from_msgpack_object(const char* buffer, std::size_t size);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
+
+#endif
@@ -6,6 +6,12 @@
 #include <migraphx/verify_args.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/compile_options.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <iomanip>
+#include <thread>
+#include <unordered_map>
 
 namespace migraphx {
 namespace driver {
@@ -19,8 +25,10 @@ std::vector<argument> run_ref(program p, const parameter_map& inputs)
     return out;
 }
 
-std::vector<argument>
-run_target(program p, const target& t, const compile_options& options, const parameter_map& inputs)
+static std::vector<argument> eval_target(program& p,
+                                         const target& t,
+                                         const compile_options& options,
+                                         const parameter_map& inputs)
 {
     p.compile(t, options);
 
@@ -32,13 +40,20 @@ run_target(program p, const target& t, const compile_options& options, const par
     }
     auto gpu_out = p.eval(m);
     std::vector<argument> output(gpu_out.size());
-    std::cout << p << std::endl;
     std::transform(gpu_out.begin(), gpu_out.end(), output.begin(), [&](auto& argu) {
         return options.offload_copy ? argu : t.copy_from(argu);
     });
     return output;
 }
 
+std::vector<argument>
+run_target(program p, const target& t, const compile_options& options, const parameter_map& inputs)
+{
+    auto output = eval_target(p, t, options, inputs);
+    std::cout << p << std::endl;
+    return output;
+}
+
 void verify_program(const std::string& name,
                     const program& p,
                     const target& t,
@@ -58,48 +73,177 @@ void verify_program(const std::string& name,
     // std::cout << "gpu: " << y << std::endl;
 }
 
-void verify_instructions(const program& prog,
-                         const target& t,
-                         compile_options options,
-                         double tolerance)
+// Run the program on ref once, returning the result of every instruction in the main module
+static std::vector<argument> run_ref_instructions(program p, const parameter_map& inputs)
 {
-    const auto* mm_prog = prog.get_main_module();
-    for(auto&& ins : (*mm_prog))
+    auto* mm  = p.get_main_module();
+    auto last = std::prev(mm->end());
+    if(last->name() == "@return")
+        mm->remove_instruction(last);
+    std::vector<instruction_ref> outputs;
+    for(auto ins : iterator_for(*mm))
+        outputs.push_back(ins);
+    mm->add_return(outputs);
+    p.compile(ref::target{});
+    parameter_map m = inputs;
+    for(auto&& x : p.get_parameter_shapes())
+    {
+        if(m.count(x.first) == 0)
+            m[x.first] = generate_argument(x.second);
+    }
+    return p.eval(m);
+}
+
+static bool skip_instruction(const instruction& ins)
+{
+    if(ins.name().front() == '@')
+        return true;
+    if(not ins.module_inputs().empty())
+        return true;
+    return contains({"broadcast", "transpose", "reshape", "undefined"}, ins.name());
+}
+
+struct instruction_result
+{
+    std::size_t index = 0;
+    std::string name;
+    double error = 0;
+    bool passed  = true;
+    std::string message;
+    argument ref_arg;
+    argument target_arg;
+};
+
+// Compile and run a single instruction on the target, using the ref results of its inputs
+static instruction_result
+verify_instruction(instruction_ref ins,
+                   std::size_t index,
+                   const std::vector<argument>& ref_results,
+                   const std::unordered_map<instruction_ref, std::size_t>& positions,
+                   const target& t,
+                   const compile_options& options,
+                   double tolerance)
+{
+    instruction_result result;
+    result.index   = index;
+    result.name    = ins->name();
+    result.ref_arg = ref_results.at(index);
+    try
     {
-        if(ins.name().front() == '@')
-            continue;
-        if(ins.name() == "broadcast")
-            continue;
-        if(ins.name() == "transpose")
-            continue;
-        if(ins.name() == "reshape")
-            continue;
-        if(ins.name() == "undefined")
-            continue;
         program p;
-        auto* mm_p = p.get_main_module();
+        auto* mm = p.get_main_module();
+        parameter_map params;
         std::vector<instruction_ref> inputs;
-        for(auto&& arg : ins.inputs())
+        for(auto arg : ins->inputs())
         {
             if(arg->name() == "@literal")
-                inputs.push_back(mm_p->add_literal(arg->get_literal()));
-            else
-                inputs.push_back(
-                    mm_p->add_parameter(std::to_string(inputs.size()), arg->get_shape()));
-        }
-        mm_p->add_instruction(ins.get_operator(), inputs);
-        try
-        {
-            std::cout << "Verify: " << ins.name() << std::endl;
-            std::cout << p << std::endl;
-            verify_program(ins.name(), p, t, options, create_param_map(p, false), tolerance);
+            {
+                inputs.push_back(mm->add_literal(arg->get_literal()));
+                continue;
+            }
+            auto name = std::to_string(inputs.size());
+            inputs.push_back(mm->add_parameter(name, arg->get_shape()));
+            params[name] = ref_results.at(positions.at(arg));
         }
-        catch(...)
+        mm->add_instruction(ins->get_operator(), inputs);
+        result.target_arg = eval_target(p, t, options, params).front();
+        visit_all(result.ref_arg, result.target_arg)([&](auto ref, auto target) {
+            result.passed = verify_range(ref, target, tolerance, &result.error);
+        });
+    }
+    catch(const std::exception& e)
+    {
+        result.passed  = false;
+        result.message = e.what();
+    }
+    catch(...)
+    {
+        result.passed  = false;
+        result.message = "Unknown exception";
+    }
+    return result;
+}
+
+static std::size_t print_summary(const std::vector<instruction_result>& results)
+{
+    std::cout << std::left << std::setw(8) << "Index" << std::setw(32) << "Instruction"
+              << std::setw(16) << "Error"
+              << "Result" << std::endl;
+    for(auto&& r : results)
+    {
+        std::cout << std::left << std::setw(8) << r.index << std::setw(32) << r.name
+                  << std::setw(16) << r.error << (r.passed ? "PASSED" : "FAILED") << std::endl;
+    }
+    auto failed = std::count_if(
+        results.begin(), results.end(), [](const auto& r) { return not r.passed; });
+    std::cout << results.size() << " instructions verified, " << failed << " failed"
+              << std::endl;
+    return failed;
+}
+
+void verify_instructions(const program& prog,
+                         const target& t,
+                         compile_options options,
+                         const parameter_map& inputs,
+                         double tolerance,
+                         std::size_t jobs,
+                         bool bisect)
+{
+    if(jobs == 0)
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Run ref ..." << std::endl;
+    auto ref_results = run_ref_instructions(prog, inputs);
+
+    const auto* mm = prog.get_main_module();
+    std::unordered_map<instruction_ref, std::size_t> positions;
+    std::vector<std::pair<instruction_ref, std::size_t>> work;
+    for(auto ins : iterator_for(*mm))
+    {
+        auto index     = positions.size();
+        positions[ins] = index;
+        if(not skip_instruction(*ins))
+            work.emplace_back(ins, index);
+    }
+
+    // In bisect mode the instructions are checked in batches so it stops at the batch with the
+    // first divergent instruction
+    std::size_t batch = bisect ? jobs : work.size();
+    std::vector<instruction_result> results;
+    for(std::size_t start = 0; start < work.size(); start += batch)
+    {
+        auto n = std::min(batch, work.size() - start);
+        std::vector<instruction_result> batch_results(n);
+        par_for_impl(n, std::min(jobs, n), [&](auto i) {
+            const auto& w    = work[start + i];
+            batch_results[i] = verify_instruction(
+                w.first, w.second, ref_results, positions, t, options, tolerance);
+        });
+        std::cout << "Verified " << start + n << "/" << work.size() << " instructions"
+                  << std::endl;
+        auto it = std::find_if(batch_results.begin(), batch_results.end(), [](const auto& r) {
+            return not r.passed;
+        });
+        if(bisect and it != batch_results.end())
         {
-            std::cout << "Instruction " << ins.name() << " threw an exception." << std::endl;
-            throw;
+            results.insert(results.end(), batch_results.begin(), std::next(it));
+            break;
         }
+        results.insert(results.end(), batch_results.begin(), batch_results.end());
+    }
+
+    for(auto&& r : results)
+    {
+        if(r.passed)
+            continue;
+        std::cout << "Instruction " << r.index << ": " << r.name << std::endl;
+        if(not r.message.empty())
+            std::cout << "Exception: " << r.message << std::endl;
+        else
+            verify_args(r.name, r.ref_arg, r.target_arg, tolerance);
     }
+    auto failed = print_summary(results);
+    if(failed > 0)
+        MIGRAPHX_THROW("Verification failed for " + std::to_string(failed) + " instructions");
 }
 
 void verify_reduced(program p,
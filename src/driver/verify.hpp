@@ -15,8 +15,11 @@ void verify_program(const std::string& name,
                     double tolerance            = 100);
 void verify_instructions(const program& prog,
                          const target& t,
-                         compile_options options = compile_options{},
-                         double tolerance        = 80);
+                         compile_options options     = compile_options{},
+                         const parameter_map& inputs = {},
+                         double tolerance            = 80,
+                         std::size_t jobs            = 0,
+                         bool bisect                 = false);
 void verify_reduced_program(const program& p,
                             const target& t,
                             compile_options options     = compile_options{},
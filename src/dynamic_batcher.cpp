@@ -0,0 +1,273 @@
+#include <migraphx/dynamic_batcher.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+using batch_clock = std::chrono::steady_clock;
+
+double dynamic_batcher_stats::average_batch_size() const
+{
+    if(batches == 0)
+        return 0;
+    return double(requests) / batches;
+}
+
+double dynamic_batcher_stats::average_queue_ms() const
+{
+    if(requests == 0)
+        return 0;
+    return std::chrono::duration<double, std::milli>(queue_time).count() / requests;
+}
+
+double dynamic_batcher_stats::average_compute_ms() const
+{
+    if(batches == 0)
+        return 0;
+    return std::chrono::duration<double, std::milli>(compute_time).count() / batches;
+}
+
+std::ostream& operator<<(std::ostream& os, const dynamic_batcher_stats& s)
+{
+    os << "Requests: " << s.requests << ", Batches: " << s.batches;
+    os << ", Average batch size: " << s.average_batch_size();
+    os << ", Average queue time: " << s.average_queue_ms() << "ms";
+    os << ", Average compute time: " << s.average_compute_ms() << "ms";
+    return os;
+}
+
+// Shape of a single sample of a batched shape
+static shape sample_shape(const shape& s)
+{
+    auto lens = s.lens();
+    lens[0]   = 1;
+    return {s.type(), lens, s.strides()};
+}
+
+// View of the sample at index i of a batched argument
+static argument sample_view(const argument& a, std::size_t i)
+{
+    const auto& s = a.get_shape();
+    return {sample_shape(s), a.data() + i * s.strides()[0] * s.type_size()};
+}
+
+static void check_sample(const shape& dst, const shape& src)
+{
+    if(dst.type() != src.type() or dst.elements() != src.elements())
+        MIGRAPHX_THROW("DYNAMIC_BATCHER: Sample " + to_string(src) + " does not match " +
+                       to_string(dst));
+}
+
+// Check a request has a sample of the right shape for every parameter, so a bad request is
+// rejected on its own instead of failing the batch it would be part of
+static void check_request(const parameter_map& inputs, const parameter_map& sample)
+{
+    for(auto&& x : inputs)
+    {
+        if(not contains(sample, x.first))
+            MIGRAPHX_THROW("DYNAMIC_BATCHER: Missing parameter: " + x.first);
+        check_sample(sample_shape(x.second.get_shape()), sample.at(x.first).get_shape());
+    }
+}
+
+static void copy_sample(const argument& dst, const argument& src)
+{
+    check_sample(dst.get_shape(), src.get_shape());
+    if(dst.get_shape().standard() and src.get_shape().standard())
+    {
+        std::memcpy(dst.data(), src.data(), dst.get_shape().bytes());
+        return;
+    }
+    visit_all(dst, src)(
+        [&](auto output, auto input) { std::copy(input.begin(), input.end(), output.begin()); });
+}
+
+struct batch_request
+{
+    parameter_map sample;
+    std::promise<std::vector<argument>> result;
+    batch_clock::time_point enqueued;
+};
+
+struct dynamic_batcher_impl
+{
+    program prog;
+    std::size_t batch     = 0;
+    std::size_t max_batch = 0;
+    std::chrono::microseconds max_latency{};
+    parameter_map inputs;
+
+    mutable std::mutex m;
+    std::condition_variable cv;
+    std::deque<batch_request> queue;
+    bool stopped = false;
+    dynamic_batcher_stats stats;
+    std::thread worker;
+
+    std::vector<batch_request> next_batch()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&] { return stopped or not queue.empty(); });
+        if(queue.empty())
+            return {};
+        auto deadline = queue.front().enqueued + max_latency;
+        cv.wait_until(lock, deadline, [&] { return stopped or queue.size() >= max_batch; });
+        auto n = std::min(queue.size(), max_batch);
+        std::vector<batch_request> result;
+        std::move(queue.begin(), queue.begin() + n, std::back_inserter(result));
+        queue.erase(queue.begin(), queue.begin() + n);
+        return result;
+    }
+
+    void run_batch(std::vector<batch_request>& requests)
+    {
+        auto start = batch_clock::now();
+        std::vector<std::vector<argument>> outputs(requests.size());
+        std::exception_ptr error;
+        try
+        {
+            // The program takes one buffer per parameter for the whole batch, so the samples of
+            // the requests are gathered into their slots
+            for(std::size_t i = 0; i < requests.size(); i++)
+            {
+                for(auto&& x : inputs)
+                    copy_sample(sample_view(x.second, i), requests[i].sample.at(x.first));
+            }
+            // The outputs can alias memory reused by the next evaluation so they are copied
+            auto results = prog.eval(inputs);
+            for(std::size_t i = 0; i < requests.size(); i++)
+            {
+                for(auto&& r : results)
+                {
+                    auto view = sample_view(r, i);
+                    argument output{shape{view.get_shape().type(), view.get_shape().lens()}};
+                    copy_sample(output, view);
+                    outputs[i].push_back(output);
+                }
+            }
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+        auto finish = batch_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stats.batches++;
+            stats.requests += requests.size();
+            stats.compute_time += finish - start;
+            for(auto&& r : requests)
+                stats.queue_time += start - r.enqueued;
+        }
+        for(std::size_t i = 0; i < requests.size(); i++)
+        {
+            if(error)
+                requests[i].result.set_exception(error);
+            else
+                requests[i].result.set_value(std::move(outputs[i]));
+        }
+    }
+
+    void run()
+    {
+        for(;;)
+        {
+            auto requests = next_batch();
+            if(requests.empty())
+                return;
+            run_batch(requests);
+        }
+    }
+};
+
+dynamic_batcher::dynamic_batcher(const program& p, dynamic_batcher_options options)
+    : impl(std::make_unique<dynamic_batcher_impl>())
+{
+    impl->prog = p;
+    // Finalize the copy so it has its own scratch memory instead of sharing it with p
+    impl->prog.finalize();
+    for(auto&& x : p.get_parameter_shapes())
+    {
+        const auto& s = x.second;
+        if(s.lens().empty() or (impl->batch != 0 and s.lens()[0] != impl->batch))
+            MIGRAPHX_THROW("DYNAMIC_BATCHER: Parameter " + x.first +
+                           " does not have the batch dimension");
+        impl->batch = s.lens()[0];
+        // Standard layout so each sample is a contiguous slot
+        impl->inputs[x.first] = argument{shape{s.type(), s.lens()}};
+    }
+    if(impl->batch == 0)
+        MIGRAPHX_THROW("DYNAMIC_BATCHER: Program has no parameters to batch");
+    for(auto&& s : p.get_output_shapes())
+    {
+        if(s.lens().empty() or s.lens()[0] != impl->batch)
+            MIGRAPHX_THROW("DYNAMIC_BATCHER: Output " + to_string(s) +
+                           " does not have the batch dimension");
+    }
+    impl->max_batch = impl->batch;
+    if(options.max_batch > 0)
+        impl->max_batch = std::min(options.max_batch, impl->batch);
+    impl->max_latency = options.max_latency;
+    impl->worker      = std::thread{[q = impl.get()] { q->run(); }};
+}
+
+dynamic_batcher::~dynamic_batcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        impl->stopped = true;
+    }
+    impl->cv.notify_all();
+    // The requests already submitted are still evaluated
+    impl->worker.join();
+}
+
+std::size_t dynamic_batcher::batch_size() const { return impl->batch; }
+
+std::future<std::vector<argument>> dynamic_batcher::submit(parameter_map sample)
+{
+    batch_request r;
+    auto f = r.result.get_future();
+    try
+    {
+        check_request(impl->inputs, sample);
+    }
+    catch(...)
+    {
+        r.result.set_exception(std::current_exception());
+        return f;
+    }
+    r.sample   = std::move(sample);
+    r.enqueued = batch_clock::now();
+    bool wake  = false;
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        if(impl->stopped)
+            MIGRAPHX_THROW("DYNAMIC_BATCHER: Batcher has been stopped");
+        impl->queue.push_back(std::move(r));
+        // The worker is waiting for the first request of a batch or for the batch to be full
+        wake = impl->queue.size() == 1 or impl->queue.size() >= impl->max_batch;
+    }
+    if(wake)
+        impl->cv.notify_one();
+    return f;
+}
+
+dynamic_batcher_stats dynamic_batcher::stats() const
+{
+    std::lock_guard<std::mutex> lock(impl->m);
+    return impl->stats;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
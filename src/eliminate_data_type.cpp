@@ -3,6 +3,7 @@
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/instruction.hpp>
+#include <migraphx/ranges.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -15,16 +16,22 @@ void eliminate_data_type::apply(module& m) const
             continue;
         if(ins->name() == "convert")
             continue;
+        auto op         = ins->get_operator();
+        auto attributes = op.attributes();
+        // Inputs the operator reads in their own type, such as packed weights, are kept
+        std::vector<std::size_t> fixed;
+        if(attributes.contains("fixed_type_inputs"))
+            fixed = attributes["fixed_type_inputs"].to_vector<std::size_t>();
         auto inputs = ins->inputs();
-        std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto i) {
-            if(types.count(i->get_shape().type()) == 0)
-                return i;
-            return m.insert_instruction(ins, make_op("convert", {{"target_type", target_type}}), i);
-        });
+        for(std::size_t i = 0; i < inputs.size(); i++)
+        {
+            if(types.count(inputs[i]->get_shape().type()) == 0 or contains(fixed, i))
+                continue;
+            inputs[i] = m.insert_instruction(
+                ins, make_op("convert", {{"target_type", target_type}}), inputs[i]);
+        }
         if(inputs == ins->inputs())
             continue;
-        auto op         = ins->get_operator();
-        auto attributes = op.attributes();
         if(attributes.contains("general_data_type"))
         {
             op = make_op(attributes["general_data_type"].to<std::string>(), op.to_value());
@@ -0,0 +1,50 @@
+#include <migraphx/eliminate_duplicate_literals.hpp>
+#include <migraphx/literal_store.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/env.hpp>
+#include <unordered_map>
+#include <iostream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_DUPLICATE_LITERALS)
+
+void eliminate_duplicate_literals::apply(module& m) const
+{
+    std::unordered_multimap<std::size_t, instruction_ref> literals;
+    std::size_t n     = 0;
+    std::size_t saved = 0;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "@literal")
+            continue;
+        if(ins->outputs().empty())
+            continue;
+        const auto& l = ins->get_literal();
+        auto h        = hash_literal(l);
+        auto r        = range(literals.equal_range(h));
+        auto it       = std::find_if(r.begin(), r.end(), [&](const auto& p) {
+            return same_literal_data(p.second->get_literal(), l);
+        });
+        if(it == r.end())
+        {
+            literals.emplace(h, ins);
+            continue;
+        }
+        // The first literal comes before the duplicate so it also comes
+        // before every user of the duplicate
+        m.replace_instruction(ins, it->second);
+        n++;
+        saved += l.get_shape().bytes();
+    }
+    if(enabled(MIGRAPHX_TRACE_DUPLICATE_LITERALS{}) and n > 0)
+        std::cout << m.name() << ": merged " << n << " duplicate literals, saved " << saved
+                  << " bytes" << std::endl;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,124 @@
+#include <migraphx/half_convert.hpp>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MIGRAPHX_HAS_F16C_DISPATCH 1
+#include <immintrin.h>
+#else
+#define MIGRAPHX_HAS_F16C_DISPATCH 0
+#endif
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static_assert(sizeof(half) == sizeof(std::uint16_t), "half must be stored in 16 bits");
+
+// The conversion of the half library truncates by default, so the bits are rounded here to match
+// the F16C instructions
+static std::uint16_t float_to_half_bits(float x)
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &x, sizeof(bits));
+    std::uint32_t sign = (bits >> 16) & 0x8000u;
+    std::uint32_t absx = bits & 0x7fffffffu;
+    // Infinity, or nan which is kept quiet
+    if(absx >= 0x7f800000u)
+        return sign | 0x7c00u | (absx > 0x7f800000u ? 0x200u | ((absx >> 13) & 0x3ffu) : 0u);
+    // At least 65536, which is past the largest value that rounds down to 65504
+    if(absx >= 0x47800000u)
+        return sign | 0x7c00u;
+    std::uint32_t result = 0;
+    std::uint32_t rest   = 0;
+    std::uint32_t tie    = 0;
+    if(absx < 0x38800000u)
+    {
+        // Below the smallest normal half, so the result counts multiples of 2^-24
+        std::uint32_t exponent = absx >> 23;
+        if(exponent < 102)
+            return sign;
+        std::uint32_t mantissa = (absx & 0x7fffffu) | 0x800000u;
+        std::uint32_t shift    = 126 - exponent;
+        result                 = mantissa >> shift;
+        rest                   = mantissa & ((1u << shift) - 1);
+        tie                    = 1u << (shift - 1);
+    }
+    else
+    {
+        // Rebias the exponent and drop 13 bits of the mantissa, a carry out of the mantissa
+        // increments the exponent
+        result = (absx - 0x38000000u) >> 13;
+        rest   = absx & 0x1fffu;
+        tie    = 0x1000u;
+    }
+    if(rest > tie or (rest == tie and (result & 1u) != 0))
+        result++;
+    return sign | result;
+}
+
+half float_to_half(float x)
+{
+    auto bits = float_to_half_bits(x);
+    half result;
+    std::memcpy(&result, &bits, sizeof(bits));
+    return result;
+}
+
+#if MIGRAPHX_HAS_F16C_DISPATCH
+
+// Built for F16C without requiring it for the rest of the library, so it must only be called
+// after checking the cpu supports it
+__attribute__((target("avx,f16c"))) static std::size_t
+half_to_float_f16c(const half* input, std::size_t n, float* output)
+{
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm256_storeu_ps(output + i, _mm256_cvtph_ps(x));
+    }
+    return i;
+}
+
+__attribute__((target("avx,f16c"))) static std::size_t
+float_to_half_f16c(const float* input, std::size_t n, half* output)
+{
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        auto x = _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), x);
+    }
+    return i;
+}
+
+static bool has_f16c()
+{
+    static const bool result = __builtin_cpu_supports("avx") and __builtin_cpu_supports("f16c");
+    return result;
+}
+
+#endif
+
+void half_to_float(const half* input, std::size_t n, float* output)
+{
+    std::size_t i = 0;
+#if MIGRAPHX_HAS_F16C_DISPATCH
+    if(has_f16c())
+        i = half_to_float_f16c(input, n, output);
+#endif
+    std::copy(input + i, input + n, output + i);
+}
+
+void float_to_half(const float* input, std::size_t n, half* output)
+{
+    std::size_t i = 0;
+#if MIGRAPHX_HAS_F16C_DISPATCH
+    if(has_f16c())
+        i = float_to_half_f16c(input, n, output);
+#endif
+    std::transform(input + i, input + n, output + i, [](float x) { return float_to_half(x); });
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
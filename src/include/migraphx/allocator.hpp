@@ -0,0 +1,305 @@
+#ifndef MIGRAPHX_GUARD_ALLOCATOR_HPP
+#define MIGRAPHX_GUARD_ALLOCATOR_HPP
+
+#include <cassert>
+#include <string>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <migraphx/config.hpp>
+#include <iosfwd>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+#ifdef DOXYGEN
+
+/// An interface for allocating host memory for arguments and literals
+struct allocator
+{
+    /// A name of the allocator
+    std::string name() const;
+    /// Allocate a buffer of the given size, or return nullptr if it can't be allocated
+    char* allocate(std::size_t bytes) const;
+    /// Release a buffer returned by allocate with the same size
+    void deallocate(char* p, std::size_t bytes) const;
+};
+
+#else
+
+/*
+ * Type-erased interface for:
+ *
+ * struct allocator
+ * {
+ *      std::string name() const;
+ *      char* allocate(std::size_t bytes) const;
+ *      void deallocate(char* p,std::size_t bytes) const;
+ * };
+ *
+ */
+
+struct allocator
+{
+    // Constructors
+    allocator() = default;
+
+    template <typename PrivateDetailTypeErasedT>
+    allocator(PrivateDetailTypeErasedT value)
+        : private_detail_te_handle_mem_var(
+              std::make_shared<private_detail_te_handle_type<
+                  typename std::remove_reference<PrivateDetailTypeErasedT>::type>>(
+                  std::forward<PrivateDetailTypeErasedT>(value)))
+    {
+    }
+
+    // Assignment
+    template <typename PrivateDetailTypeErasedT>
+    allocator& operator=(PrivateDetailTypeErasedT value)
+    {
+        using std::swap;
+        auto* derived = this->any_cast<PrivateDetailTypeErasedT>();
+        if(derived and private_detail_te_handle_mem_var.unique())
+        {
+            *derived = std::forward<PrivateDetailTypeErasedT>(value);
+        }
+        else
+        {
+            allocator rhs(value);
+            swap(private_detail_te_handle_mem_var, rhs.private_detail_te_handle_mem_var);
+        }
+        return *this;
+    }
+
+    // Cast
+    template <typename PrivateDetailTypeErasedT>
+    PrivateDetailTypeErasedT* any_cast()
+    {
+        return this->type_id() == typeid(PrivateDetailTypeErasedT)
+                   ? std::addressof(static_cast<private_detail_te_handle_type<
+                                        typename std::remove_cv<PrivateDetailTypeErasedT>::type>&>(
+                                        private_detail_te_get_handle())
+                                        .private_detail_te_value)
+                   : nullptr;
+    }
+
+    template <typename PrivateDetailTypeErasedT>
+    const typename std::remove_cv<PrivateDetailTypeErasedT>::type* any_cast() const
+    {
+        return this->type_id() == typeid(PrivateDetailTypeErasedT)
+                   ? std::addressof(static_cast<const private_detail_te_handle_type<
+                                        typename std::remove_cv<PrivateDetailTypeErasedT>::type>&>(
+                                        private_detail_te_get_handle())
+                                        .private_detail_te_value)
+                   : nullptr;
+    }
+
+    const std::type_info& type_id() const
+    {
+        if(private_detail_te_handle_empty())
+            return typeid(std::nullptr_t);
+        else
+            return private_detail_te_get_handle().type();
+    }
+
+    std::string name() const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().name();
+    }
+
+    char* allocate(std::size_t bytes) const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().allocate(bytes);
+    }
+
+    void deallocate(char* p, std::size_t bytes) const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        (*this).private_detail_te_get_handle().deallocate(p, bytes);
+    }
+
+    friend bool is_shared(const allocator& private_detail_x,
+                          const allocator& private_detail_y)
+    {
+        return private_detail_x.private_detail_te_handle_mem_var ==
+               private_detail_y.private_detail_te_handle_mem_var;
+    }
+
+    private:
+    struct private_detail_te_handle_base_type
+    {
+        virtual ~private_detail_te_handle_base_type() {}
+        virtual std::shared_ptr<private_detail_te_handle_base_type> clone() const = 0;
+        virtual const std::type_info& type() const                                = 0;
+
+        virtual std::string name() const                          = 0;
+        virtual char* allocate(std::size_t bytes) const           = 0;
+        virtual void deallocate(char* p, std::size_t bytes) const = 0;
+    };
+
+    template <typename PrivateDetailTypeErasedT>
+    struct private_detail_te_handle_type : private_detail_te_handle_base_type
+    {
+        template <typename PrivateDetailTypeErasedU = PrivateDetailTypeErasedT>
+        private_detail_te_handle_type(
+            PrivateDetailTypeErasedT value,
+            typename std::enable_if<std::is_reference<PrivateDetailTypeErasedU>::value>::type* =
+                nullptr)
+            : private_detail_te_value(value)
+        {
+        }
+
+        template <typename PrivateDetailTypeErasedU = PrivateDetailTypeErasedT>
+        private_detail_te_handle_type(
+            PrivateDetailTypeErasedT value,
+            typename std::enable_if<!std::is_reference<PrivateDetailTypeErasedU>::value,
+                                    int>::type* = nullptr) noexcept
+            : private_detail_te_value(std::move(value))
+        {
+        }
+
+        std::shared_ptr<private_detail_te_handle_base_type> clone() const override
+        {
+            return std::make_shared<private_detail_te_handle_type>(private_detail_te_value);
+        }
+
+        const std::type_info& type() const override { return typeid(private_detail_te_value); }
+
+        std::string name() const override { return private_detail_te_value.name(); }
+
+        char* allocate(std::size_t bytes) const override
+        {
+
+            return private_detail_te_value.allocate(bytes);
+        }
+
+        void deallocate(char* p, std::size_t bytes) const override
+        {
+
+            private_detail_te_value.deallocate(p, bytes);
+        }
+
+        PrivateDetailTypeErasedT private_detail_te_value;
+    };
+
+    template <typename PrivateDetailTypeErasedT>
+    struct private_detail_te_handle_type<std::reference_wrapper<PrivateDetailTypeErasedT>>
+        : private_detail_te_handle_type<PrivateDetailTypeErasedT&>
+    {
+        private_detail_te_handle_type(std::reference_wrapper<PrivateDetailTypeErasedT> ref)
+            : private_detail_te_handle_type<PrivateDetailTypeErasedT&>(ref.get())
+        {
+        }
+    };
+
+    bool private_detail_te_handle_empty() const
+    {
+        return private_detail_te_handle_mem_var == nullptr;
+    }
+
+    const private_detail_te_handle_base_type& private_detail_te_get_handle() const
+    {
+        assert(private_detail_te_handle_mem_var != nullptr);
+        return *private_detail_te_handle_mem_var;
+    }
+
+    private_detail_te_handle_base_type& private_detail_te_get_handle()
+    {
+        assert(private_detail_te_handle_mem_var != nullptr);
+        if(!private_detail_te_handle_mem_var.unique())
+            private_detail_te_handle_mem_var = private_detail_te_handle_mem_var->clone();
+        return *private_detail_te_handle_mem_var;
+    }
+
+    std::shared_ptr<private_detail_te_handle_base_type> private_detail_te_handle_mem_var;
+};
+
+template <typename ValueType>
+inline const ValueType* any_cast(const allocator* x)
+{
+    return x->any_cast<ValueType>();
+}
+
+template <typename ValueType>
+inline ValueType* any_cast(allocator* x)
+{
+    return x->any_cast<ValueType>();
+}
+
+template <typename ValueType>
+inline ValueType& any_cast(allocator& x)
+{
+    auto* y = x.any_cast<typename std::remove_reference<ValueType>::type>();
+    if(y == nullptr)
+        throw std::bad_cast();
+    return *y;
+}
+
+template <typename ValueType>
+inline const ValueType& any_cast(const allocator& x)
+{
+    const auto* y = x.any_cast<typename std::remove_reference<ValueType>::type>();
+    if(y == nullptr)
+        throw std::bad_cast();
+    return *y;
+}
+
+#endif
+
+enum class huge_pages
+{
+    /// Only use the default page size
+    none,
+    /// Ask the kernel to back large buffers with transparent huge pages
+    transparent,
+    /// Map large buffers from the reserved huge page pool, falling back to default pages
+    explicit_pages
+};
+
+/// The default allocator, which aligns buffers and can back large buffers with huge pages
+struct aligned_allocator
+{
+    std::size_t alignment = 64;
+    huge_pages pages      = huge_pages::none;
+    /// Buffers smaller than this always use the default page size
+    std::size_t huge_page_threshold = 2 * 1024 * 1024;
+
+    std::string name() const;
+    char* allocate(std::size_t bytes) const;
+    void deallocate(char* p, std::size_t bytes) const;
+};
+
+struct allocation_stats
+{
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+    /// Bytes currently allocated
+    std::size_t bytes_in_use = 0;
+    /// Largest value of bytes_in_use so far
+    std::size_t peak_bytes = 0;
+    /// Total bytes requested over all allocations
+    std::size_t total_bytes = 0;
+
+    friend std::ostream& operator<<(std::ostream& os, const allocation_stats& s);
+};
+
+/// Allocator used for new buffers, it defaults to an aligned_allocator configured with
+/// MIGRAPHX_HUGE_PAGES set to "transparent" or "explicit"
+allocator get_allocator();
+
+/// Replace the allocator for new buffers, existing buffers are released by their own allocator
+void set_allocator(allocator a);
+
+allocation_stats get_allocation_stats();
+
+/// Allocate a zero-initialized buffer with the current allocator
+std::shared_ptr<char> allocate_buffer(std::size_t bytes);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -7,11 +7,15 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+struct constant_fold_cache;
+
 struct compile_options
 {
     bool offload_copy = false;
     bool fast_math    = true;
     tracer trace{};
+    /// When set, constants folded while compiling are looked up in and added to the cache
+    constant_fold_cache* fold_cache = nullptr;
 };
 
 } // namespace MIGRAPHX_INLINE_NS
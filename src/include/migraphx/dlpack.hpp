@@ -0,0 +1,77 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_DLPACK_HPP
+#define MIGRAPHX_GUARD_RTGLIB_DLPACK_HPP
+
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <cstdint>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * @brief Layout compatible definitions of the DLPack structures
+ *
+ * These mirror DLDevice, DLDataType, DLTensor and DLManagedTensor from dlpack.h so tensors can be
+ * exchanged with other frameworks without depending on the dlpack headers.
+ */
+namespace dlpack {
+
+enum device_type : int32_t
+{
+    cpu       = 1,
+    cuda_host = 3,
+    rocm_host = 11
+};
+
+enum type_code : uint8_t
+{
+    int_code    = 0,
+    uint_code   = 1,
+    float_code  = 2,
+    bfloat_code = 4,
+    bool_code   = 6
+};
+
+struct device
+{
+    int32_t device_type;
+    int32_t device_id;
+};
+
+struct data_type
+{
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+};
+
+struct tensor
+{
+    void* data;
+    device ctx;
+    int32_t ndim;
+    data_type dtype;
+    int64_t* shape;
+    int64_t* strides;
+    uint64_t byte_offset;
+};
+
+struct managed_tensor
+{
+    tensor dl_tensor;
+    void* manager_ctx;
+    void (*deleter)(managed_tensor* self);
+};
+
+} // namespace dlpack
+
+/// Export the argument as a DLPack tensor that shares its data, the caller must call the deleter
+dlpack::managed_tensor* to_dlpack(const argument& a);
+
+/// Wrap a host DLPack tensor without copying, the argument takes ownership of the tensor
+argument from_dlpack(dlpack::managed_tensor* t);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
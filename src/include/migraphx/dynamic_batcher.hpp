@@ -0,0 +1,74 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_DYNAMIC_BATCHER_HPP
+#define MIGRAPHX_GUARD_RTGLIB_DYNAMIC_BATCHER_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/program.hpp>
+#include <chrono>
+#include <future>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct dynamic_batcher_options
+{
+    /// How long the first request of a batch waits for more requests
+    std::chrono::microseconds max_latency{1000};
+    /// Maximum number of requests in a batch, zero uses the batch size of the program
+    std::size_t max_batch = 0;
+};
+
+struct dynamic_batcher_stats
+{
+    std::size_t requests = 0;
+    std::size_t batches  = 0;
+    /// Total time requests spent waiting before their batch started
+    std::chrono::nanoseconds queue_time{0};
+    /// Total time spent gathering the inputs, evaluating and scattering the outputs
+    std::chrono::nanoseconds compute_time{0};
+
+    double average_batch_size() const;
+    double average_queue_ms() const;
+    double average_compute_ms() const;
+
+    friend std::ostream& operator<<(std::ostream& os, const dynamic_batcher_stats& s);
+};
+
+struct dynamic_batcher_impl;
+
+/**
+ * @brief Coalesces single sample requests into batches for a program with a batch dimension
+ *
+ * The program must be compiled with the same batch size as the first dimension of every
+ * parameter and output. Each request passes one sample per parameter, which is copied into its
+ * slot of the batched input buffers, and receives its slice of every output. Batches are
+ * evaluated on a single worker thread once they are full or the first request has waited for
+ * max_latency, and unused slots are still computed but their results are dropped.
+ */
+struct dynamic_batcher
+{
+    dynamic_batcher(const program& p,
+                    dynamic_batcher_options options = dynamic_batcher_options{});
+    dynamic_batcher(const dynamic_batcher&) = delete;
+    dynamic_batcher& operator=(const dynamic_batcher&) = delete;
+    ~dynamic_batcher();
+
+    /// Batch size the program was compiled with
+    std::size_t batch_size() const;
+
+    /// A request missing a parameter or with a sample of the wrong shape fails through its
+    /// future without being added to a batch
+    std::future<std::vector<argument>> submit(parameter_map sample);
+
+    dynamic_batcher_stats stats() const;
+
+    private:
+    std::unique_ptr<dynamic_batcher_impl> impl;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
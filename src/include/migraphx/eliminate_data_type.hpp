@@ -13,7 +13,8 @@ struct module;
 
 /**
  * Remove data types. This will instert convert operators so the data type
- * is not used by any operator.
+ * is not used by any operator. Inputs listed in the fixed_type_inputs
+ * attribute of an operator are not converted.
  */
 struct eliminate_data_type
 {
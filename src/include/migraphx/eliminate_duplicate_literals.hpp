@@ -0,0 +1,25 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_ELIMINATE_DUPLICATE_LITERALS_HPP
+#define MIGRAPHX_GUARD_RTGLIB_ELIMINATE_DUPLICATE_LITERALS_HPP
+
+#include <string>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Replace literals that have the same shape and data with a single literal. Literals are
+ * compared by hashing their bytes so this scales to modules with many large literals.
+ */
+struct eliminate_duplicate_literals
+{
+    std::string name() const { return "eliminate_duplicate_literals"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
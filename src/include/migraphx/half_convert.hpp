@@ -0,0 +1,55 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_HALF_CONVERT_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_HALF_CONVERT_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/half.hpp>
+#include <algorithm>
+#include <cstddef>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Converts n half values to float, using the F16C instructions when the cpu has them
+void half_to_float(const half* input, std::size_t n, float* output);
+
+/// Converts a float to half, rounding to the nearest even value unlike the constructor of half
+half float_to_half(float x);
+
+/// Converts n float values to half, rounding to the nearest even value, and using the F16C
+/// instructions when the cpu has them
+void float_to_half(const float* input, std::size_t n, half* output);
+
+/// Converts a value to T, rounding to the nearest even value when converting float to half
+template <class T, class U>
+T convert_value(U x)
+{
+    return T(x); // NOLINT(bugprone-signed-char-misuse)
+}
+
+template <>
+inline half convert_value<half, float>(float x)
+{
+    return float_to_half(x);
+}
+
+/// Copies a range while converting each value to the type of the output
+template <class Iterator, class T>
+void convert_copy(Iterator start, Iterator end, T* output)
+{
+    std::transform(start, end, output, [](const auto& x) { return convert_value<T>(x); });
+}
+
+inline void convert_copy(const half* start, const half* end, float* output)
+{
+    half_to_float(start, end - start, output);
+}
+
+inline void convert_copy(const float* start, const float* end, half* output)
+{
+    float_to_half(start, end - start, output);
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
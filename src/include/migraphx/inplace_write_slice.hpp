@@ -0,0 +1,26 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_INPLACE_WRITE_SLICE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_INPLACE_WRITE_SLICE_HPP
+
+#include <string>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Lets write_slice modify its data in place when the data is a parameter that no other
+ * instruction reads, such as a state kept by a session. Any other data, like a literal or a
+ * result that is still used, is copied before it is written.
+ */
+struct inplace_write_slice
+{
+    std::string name() const { return "inplace_write_slice"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
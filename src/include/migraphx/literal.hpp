@@ -6,7 +6,8 @@
 #include <migraphx/argument.hpp>
 #include <migraphx/tensor_view.hpp>
 #include <migraphx/raw_data.hpp>
-#include <migraphx/make_shared_array.hpp>
+#include <migraphx/allocator.hpp>
+#include <migraphx/half_convert.hpp>
 #include <migraphx/config.hpp>
 
 #include <memory>
@@ -23,7 +24,7 @@ struct literal : raw_data<literal>
     literal() {}
 
     template <class U, class T = deduce<U>, shape::type_t ShapeType = shape::get_type<T>{}>
-    literal(U x) : buffer(make_shared_array<char>(sizeof(T))), m_shape(ShapeType)
+    literal(U x) : buffer(allocate_buffer(sizeof(T))), m_shape(ShapeType)
     {
         static_assert(std::is_trivially_copyable<T>{}, "Literals can only be trivial types");
         *(reinterpret_cast<T*>(buffer.get())) = x;
@@ -31,15 +32,15 @@ struct literal : raw_data<literal>
 
     template <class T>
     literal(const shape& s, const std::vector<T>& x)
-        : buffer(make_shared_array<char>(s.bytes())), m_shape(s)
+        : buffer(allocate_buffer(s.bytes())), m_shape(s)
     {
         static_assert(std::is_trivially_copyable<T>{}, "Literals can only be trivial types");
-        fill(x.begin(), x.end());
+        fill(x);
     }
 
     template <class T>
     literal(const shape& s, const std::initializer_list<T>& x)
-        : buffer(make_shared_array<char>(s.bytes())), m_shape(s)
+        : buffer(allocate_buffer(s.bytes())), m_shape(s)
     {
         static_assert(std::is_trivially_copyable<T>{}, "Literals can only be trivial types");
         fill(x.begin(), x.end());
@@ -47,17 +48,24 @@ struct literal : raw_data<literal>
 
     template <class Iterator>
     literal(const shape& s, Iterator start, Iterator end)
-        : buffer(make_shared_array<char>(s.bytes())), m_shape(s)
+        : buffer(allocate_buffer(s.bytes())), m_shape(s)
     {
         fill(start, end);
     }
 
     template <class T, MIGRAPHX_REQUIRES(sizeof(T) == 1)>
-    literal(const shape& s, T* x) : buffer(make_shared_array<char>(s.bytes())), m_shape(s)
+    literal(const shape& s, T* x) : buffer(allocate_buffer(s.bytes())), m_shape(s)
     {
         std::copy(x, x + s.bytes(), buffer.get());
     }
 
+    /// Create a literal that shares the data of the argument instead of copying it
+    explicit literal(const argument& a) : m_shape(a.get_shape())
+    {
+        auto holder = std::make_shared<argument>(a.share());
+        buffer      = std::shared_ptr<char>(holder, holder->data());
+    }
+
     /// Whether data is available
     bool empty() const { return this->buffer == nullptr; }
 
@@ -71,7 +79,15 @@ struct literal : raw_data<literal>
     /// Convert the data to an argument
     argument get_argument() const
     {
-        auto b = make_shared_array<char>(buffer.get(), buffer.get() + m_shape.bytes());
+        auto b = allocate_buffer(m_shape.bytes());
+        std::copy(buffer.get(), buffer.get() + m_shape.bytes(), b.get());
+        return {m_shape, [b]() { return b.get(); }};
+    }
+
+    /// Convert the data to an argument that shares the buffer of the literal
+    argument share_argument() const
+    {
+        auto b = buffer;
         return {m_shape, [b]() { return b.get(); }};
     }
 
@@ -79,21 +95,31 @@ struct literal : raw_data<literal>
     std::shared_ptr<char> buffer;
     shape m_shape;
 
+    // Fill from pointers so float and half values use the bulk conversions
+    template <class T>
+    void fill(const std::vector<T>& x)
+    {
+        fill(x.data(), x.data() + x.size());
+    }
+
+    void fill(const std::vector<bool>& x) { fill(x.begin(), x.end()); }
+
     template <class Iterator>
     void fill(Iterator start, Iterator end)
     {
         assert(std::distance(start, end) == m_shape.elements());
         if(m_shape.standard())
         {
-            m_shape.visit_type([&](auto as) { std::copy(start, end, as.from(buffer.get())); });
+            m_shape.visit_type([&](auto as) { convert_copy(start, end, as.from(buffer.get())); });
         }
         else
         {
             auto it = start;
             m_shape.visit_type([&](auto as) {
+                using type  = typename decltype(as)::type;
                 auto output = make_view(m_shape, as.from(buffer.get()));
                 shape_for_each(output.get_shape(), [&](const auto& idx) {
-                    output(idx.begin(), idx.end()) = *it; // NOLINT(bugprone-signed-char-misuse)
+                    output(idx.begin(), idx.end()) = convert_value<type>(*it);
                     it++;
                 });
             });
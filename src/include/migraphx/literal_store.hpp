@@ -0,0 +1,61 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHLIB_LITERAL_STORE_HPP
+#define MIGRAPHX_GUARD_MIGRAPHLIB_LITERAL_STORE_HPP
+
+#include <migraphx/literal.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Hash of the shape and the raw bytes of a literal
+std::size_t hash_literal(const literal& l);
+
+/// Whether two literals have the same shape and the same bytes
+bool same_literal_data(const literal& x, const literal& y);
+
+/**
+ * @brief Content-addressed storage for literal data
+ * @details Literals with the same shape and the same bytes are stored only once. The store only
+ * keeps weak references so the data is released once no argument refers to it anymore. It is
+ * safe to use from multiple threads so a single store can be shared across programs.
+ */
+struct literal_store
+{
+    /// Returns an argument with the data of the literal, sharing the buffer with an identical
+    /// literal previously inserted when it is still alive
+    argument insert(const literal& l);
+
+    /// Number of unique buffers currently alive in the store
+    std::size_t size() const;
+
+    /// Total number of bytes requested through insert
+    std::size_t bytes_requested() const;
+
+    /// Number of bytes that were not allocated because the data was shared
+    std::size_t bytes_saved() const;
+
+    void clear();
+
+    private:
+    struct entry
+    {
+        shape s;
+        std::weak_ptr<char> data;
+    };
+    mutable std::mutex m;
+    std::unordered_multimap<std::size_t, entry> entries;
+    std::size_t requested = 0;
+    std::size_t saved     = 0;
+};
+
+/// Process-wide store used to share literals across programs
+literal_store& get_literal_store();
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef MIGRAPHX_GUARD_MATCH_ATTENTION_HPP
+#define MIGRAPHX_GUARD_MATCH_ATTENTION_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/matcher.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace match {
+
+namespace detail {
+template <class F>
+struct attention_matcher
+{
+    F f;
+    auto scores() const
+    {
+        return f("dot")(used_once(), nargs(2), arg(0)(any().bind("q")), arg(1)(any().bind("kt")))
+            .bind("scores");
+    }
+
+    auto scale() const { return skip_broadcasts(is_constant()); }
+
+    auto scaled_scores() const
+    {
+        return any_of(f("mul")(used_once(), either_arg(0, 1)(scores(), scale())),
+                      f("div")(used_once(), arg(0)(scores()), arg(1)(scale())),
+                      scores());
+    }
+
+    auto masked_scores() const
+    {
+        return any_of(f("add")(used_once(), either_arg(0, 1)(scaled_scores(), any())),
+                      scaled_scores());
+    }
+
+    auto matcher() const
+    {
+        return f("dot")(nargs(2),
+                        arg(0)(f("softmax")(used_once(), arg(0)(masked_scores())).bind("softmax")),
+                        arg(1)(any().bind("v")));
+    }
+};
+} // namespace detail
+
+/// Matches softmax(scale * dot(q, kt) + mask) * v where the scale and the mask are optional
+template <class F>
+auto attention(F f)
+{
+    return detail::attention_matcher<F>{f}.matcher();
+}
+
+inline auto attention()
+{
+    return attention([](auto x) { return name(x); });
+}
+
+} // namespace match
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MATCH_ATTENTION_HPP
@@ -8,7 +8,9 @@
 #include <migraphx/optional.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/type_name.hpp>
+#include <migraphx/rank.hpp>
 #include <migraphx/config.hpp>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -96,6 +98,26 @@ function_matcher<F> make_function_matcher(F f)
     return {f};
 }
 
+/// Get the names of the operators a matcher can match at its root, which is empty when it can
+/// match any operator
+template <class M>
+auto get_root_names(rank<1>, const M& m) -> decltype(m.root_names())
+{
+    return m.root_names();
+}
+
+template <class M>
+std::vector<std::string> get_root_names(rank<0>, const M&)
+{
+    return {};
+}
+
+template <class M>
+std::vector<std::string> get_root_names(const M& m)
+{
+    return get_root_names(rank<1>{}, m);
+}
+
 /// Converts a matcher to bind the instruction to name
 template <class M>
 auto bind_match(M m, std::string name)
@@ -123,6 +145,35 @@ struct bindable_matcher
     auto bind(std::string name) const { return bind_match(m, std::move(name)); }
 
     auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    std::vector<std::string> root_names() const { return get_root_names(m); }
+};
+
+template <class M>
+struct root_matcher;
+
+/// Create a bindable matcher that only matches the operators in names at its root
+template <class M>
+root_matcher<M> make_root_matcher(M m, std::vector<std::string> names)
+{
+    return {m, std::move(names)};
+}
+
+/// A bindable matcher that keeps the names of the operators it can match at its root
+template <class M>
+struct root_matcher
+{
+    M m;
+    std::vector<std::string> names;
+
+    auto bind(std::string name) const
+    {
+        return make_root_matcher(bind_match(m, std::move(name)), names);
+    }
+
+    auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    std::vector<std::string> root_names() const { return names; }
 };
 
 /// Create a bindable matcher
@@ -167,23 +218,31 @@ struct basic_matcher
     {
         // Copy m because we cant capture `this` by value
         auto mm = m;
-        return make_bf_matcher([=](matcher_context& ctx,
-                                   instruction_ref ins) -> optional<instruction_ref> {
-            auto result = mm.match(ctx, ins);
-            if(result)
-            {
-                bool matches =
-                    fold([&](auto x, auto y) { return x and ctx.matched(y, result); })(true, ms...);
-                if(matches)
-                    return result;
-            }
-            return nullopt;
-        });
+        return make_root_matcher(
+            make_function_matcher(
+                [=](matcher_context& ctx, instruction_ref ins) -> optional<instruction_ref> {
+                    auto result = mm.match(ctx, ins);
+                    if(result)
+                    {
+                        bool matches = fold([&](auto x, auto y) {
+                            return x and ctx.matched(y, result);
+                        })(true, ms...);
+                        if(matches)
+                            return result;
+                    }
+                    return nullopt;
+                }),
+            get_root_names(m));
     }
 
-    auto bind(std::string name) const { return bind_match(m, std::move(name)); }
+    auto bind(std::string name) const
+    {
+        return make_root_matcher(bind_match(m, std::move(name)), get_root_names(m));
+    }
 
     auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    std::vector<std::string> root_names() const { return get_root_names(m); }
 };
 
 /// Create a basic matcher from a matcher
@@ -213,9 +272,16 @@ using any_matcher_base = basic_matcher<
 struct any_matcher : any_matcher_base
 {
     template <class M>
-    any_matcher(M mm) : any_matcher_base({[=](auto& ctx, auto ins) { return mm.match(ctx, ins); }})
+    any_matcher(M mm)
+        : any_matcher_base({[=](auto& ctx, auto ins) { return mm.match(ctx, ins); }}),
+          names(get_root_names(mm))
     {
     }
+
+    std::vector<std::string> root_names() const { return names; }
+
+    private:
+    std::vector<std::string> names;
 };
 
 /// This macro takes care of the boilerplate for defining a matcher
@@ -292,16 +358,132 @@ void find_matches(module& mod, instruction_ref ins, Ms&&... ms)
         ms...);
 }
 
+/// Index matchers by the names of the operators they can match at their root
+struct matcher_index
+{
+    explicit matcher_index(std::vector<std::vector<std::string>> names);
+
+    /// The indices of the matchers that can match an operator, in the order they were given
+    const std::vector<std::size_t>& get(const std::string& name);
+
+    private:
+    std::vector<std::vector<std::string>> roots;
+    std::unordered_map<std::string, std::vector<std::size_t>> candidates;
+};
+
+/// Tracks the instructions that still need to be matched when finding matches until a fixpoint
+struct match_worklist
+{
+    explicit match_worklist(module& m, std::size_t max_rewrites = 8);
+
+    /// Check if the instruction needs to be matched in this sweep through the module
+    bool pop(instruction_ref ins);
+
+    /// Remove the unused instructions and prepare the next sweep, which returns false when
+    /// there are no instructions left to match
+    bool next_sweep();
+
+    /// Record the instructions around a match before it is applied
+    void before_rewrite(const matcher_result& r);
+
+    /// Queue the instructions that could match again after the match was applied
+    void after_rewrite();
+
+    private:
+    struct snapshot
+    {
+        instruction_ref ins;
+        operation op;
+        std::vector<instruction_ref> inputs;
+        std::vector<instruction_ref> outputs;
+    };
+
+    void push(instruction_ref ins);
+    void push_around(instruction_ref ins, std::size_t depth);
+    void push_new(instruction_ref ins);
+    void push_all();
+
+    module* mod;
+    std::size_t max_rewrites;
+    std::size_t max_total_rewrites;
+    std::size_t total_rewrites    = 0;
+    std::size_t size_before       = 0;
+    bool changed_in_sweep         = false;
+    bool changed_since_full_sweep = false;
+    std::unordered_set<instruction_ref> queued;
+    std::unordered_set<instruction_ref> known;
+    std::unordered_map<instruction_ref, std::size_t> rewrites;
+    std::vector<snapshot> snapshots;
+};
+
+template <class M>
+std::function<bool(instruction_ref)>
+make_rewrite(module& mod, M& m, match_worklist* worklist, bool trace)
+{
+    return [&mod, &m, worklist, trace](instruction_ref ins) {
+        auto r = match_instruction(mod, ins, m.matcher());
+        if(r.result == mod.end())
+            return false;
+        if(trace)
+        {
+            std::cout << "Matched by " << get_type_name(m) << std::endl;
+            mod.debug_print(ins);
+        }
+        if(worklist != nullptr)
+            worklist->before_rewrite(r);
+        m.apply(mod, r);
+        if(worklist != nullptr)
+            worklist->after_rewrite();
+        return true;
+    };
+}
+
 /// Find matches in a module
 template <class... Ms>
 void find_matches(module& mod, Ms&&... ms)
 {
+    const bool trace = enabled(MIGRAPHX_TRACE_MATCHES{});
+    matcher_index index{{get_root_names(ms.matcher())...}};
+    const std::vector<std::function<bool(instruction_ref)>> rewrites = {
+        make_rewrite(mod, ms, nullptr, trace)...};
     for(auto ins : iterator_for(mod))
     {
-        find_matches(mod, ins, ms...);
+        for(auto i : index.get(ins->name()))
+        {
+            if(rewrites[i](ins))
+                break;
+        }
     }
 }
 
+/// Find matches in a module until no more matches are found. The instructions are matched in
+/// order like find_matches, but after the first sweep through the module only the instructions
+/// around the previous rewrites are matched again. Unused instructions are removed between
+/// sweeps. Each instruction is rewritten at most max_rewrites times, and the module at most
+/// max_rewrites times its original size, so matchers that undo each other still terminate.
+template <class... Ms>
+void find_matches_fixpoint(module& mod, Ms&&... ms)
+{
+    const bool trace = enabled(MIGRAPHX_TRACE_MATCHES{});
+    matcher_index index{{get_root_names(ms.matcher())...}};
+    match_worklist worklist{mod};
+    const std::vector<std::function<bool(instruction_ref)>> rewrites = {
+        make_rewrite(mod, ms, &worklist, trace)...};
+    do
+    {
+        for(auto ins : iterator_for(mod))
+        {
+            if(not worklist.pop(ins))
+                continue;
+            for(auto i : index.get(ins->name()))
+            {
+                if(rewrites[i](ins))
+                    break;
+            }
+        }
+    } while(worklist.next_sweep());
+}
+
 template <class M, class F>
 struct find_generic_match
 {
@@ -519,11 +701,22 @@ auto skip_output(Ms... ms)
     });
 }
 
-inline auto name(std::string s)
+/// Match the name of the operator, which is also used to index the matchers by their root
+struct name_matcher
 {
-    return make_basic_pred_matcher(
-        [ =, s = std::move(s) ](instruction_ref ins) { return ins->name() == s; });
-}
+    std::vector<std::string> names;
+
+    optional<instruction_ref> match(const matcher_context&, instruction_ref ins) const
+    {
+        if(contains(names, ins->name()))
+            return optional<instruction_ref>{ins};
+        return nullopt;
+    }
+
+    std::vector<std::string> root_names() const { return names; }
+};
+
+inline auto name(std::string s) { return make_basic_matcher(name_matcher{{std::move(s)}}); }
 
 inline auto name_contains(const std::string& name)
 {
@@ -533,9 +726,9 @@ inline auto name_contains(const std::string& name)
 
 inline auto name(std::unordered_set<std::string> names)
 {
-    return make_basic_pred_matcher([ =, names = std::move(names) ](instruction_ref ins) {
-        return names.count(ins->name()) > 0;
-    });
+    std::vector<std::string> result(names.begin(), names.end());
+    std::sort(result.begin(), result.end());
+    return make_basic_matcher(name_matcher{result});
 }
 
 template <class... Ts>
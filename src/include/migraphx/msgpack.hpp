@@ -3,6 +3,9 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
+#include <functional>
+#include <string>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -11,6 +14,15 @@ std::vector<char> to_msgpack(const value& v);
 value from_msgpack(const std::vector<char>& buffer);
 value from_msgpack(const char* buffer, std::size_t size);
 
+/// Reads a binary from the keys of the maps it is nested in, where arrays have an empty key, and
+/// returns the value to store in its place
+using msgpack_binary_reader = std::function<value(
+    const std::vector<std::string>& keys, const char* data, std::size_t size)>;
+
+/// Decodes the value while parsing the buffer, so each binary can be read straight from the buffer
+/// by read_binary instead of being copied into the value
+value from_msgpack(const char* buffer, std::size_t size, const msgpack_binary_reader& read_binary);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
@@ -9,6 +9,8 @@
 #include <migraphx/literal.hpp>
 #include <migraphx/shape_for_each.hpp>
 #include <migraphx/config.hpp>
+#include <migraphx/half_convert.hpp>
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -37,11 +39,62 @@ struct convert : unary<convert>
         auto type = target_type;
         return [type](auto x) {
             auto y = x;
-            shape::visit(type, [&](auto as) { y = std::min(std::max(as(x), as.min()), as.max()); });
+            shape::visit(type, [&](auto as) {
+                using target = typename decltype(as)::type;
+                y            = std::min(std::max(convert_value<target>(x), as.min()), as.max());
+            });
             return y;
         };
     }
 
+    // Whether elements can be converted in memory order with the bulk conversions, which needs
+    // float and half arguments with the same packed layout
+    static bool bulk_convertible(const shape& input, const shape& output)
+    {
+        auto from = input.type();
+        auto to   = output.type();
+        if(not((from == shape::half_type and to == shape::float_type) or
+               (from == shape::float_type and to == shape::half_type)))
+            return false;
+        return input.packed() and output.packed() and input.lens() == output.lens() and
+               input.strides() == output.strides();
+    }
+
+    // Converts the elements from start to end of arguments that are bulk convertible
+    static void bulk_convert(const argument& input,
+                             const argument& output,
+                             std::size_t start,
+                             std::size_t end)
+    {
+        if(input.get_shape().type() == shape::half_type)
+        {
+            half_to_float(input.cast<half>() + start, end - start, output.cast<float>() + start);
+            return;
+        }
+        // Saturate like apply does, a block at a time so the clamp is vectorized
+        const float lowest  = std::numeric_limits<half>::lowest();
+        const float highest = std::numeric_limits<half>::max();
+        std::array<float, 256> clamped;
+        for(auto i = start; i < end; i += clamped.size())
+        {
+            auto n        = std::min(clamped.size(), end - i);
+            const auto* x = input.cast<float>() + i;
+            std::transform(x, x + n, clamped.begin(), [&](float v) {
+                return std::min(std::max(v, lowest), highest);
+            });
+            float_to_half(clamped.data(), n, output.cast<half>() + i);
+        }
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        if(not bulk_convertible(args[0].get_shape(), output_shape))
+            return unary<convert>::compute(output_shape, std::move(args));
+        argument result{output_shape};
+        bulk_convert(args[0], result, 0, output_shape.elements());
+        return result;
+    }
+
     convert(shape::type_t t) : target_type{t} {}
     convert() {}
 };
@@ -0,0 +1,140 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_DEQUANTIZE_DOT_HPP
+#define MIGRAPHX_GUARD_OPERATORS_DEQUANTIZE_DOT_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/streamutils.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/half.hpp>
+#include <migraphx/value.hpp>
+#include <cstdint>
+#include <utility>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Multiplies a float matrix by weights stored as symmetric int8 or int4 values, or as half
+ * values, with float scales, dequantizing the weights as they are read. The inputs are:
+ *   - a: [..., M, K]
+ *   - weights: [N, K] int8 values, or [N, (K + 1) / 2] uint8 bytes for 4 bits where each byte
+ *     holds two's complement values for k = 2i in the low nibble and k = 2i + 1 in the high
+ *     nibble, or [N, K] half values for 16 bits
+ *   - scales: [N, G] float values for each group of group_size consecutive values along K, where
+ *     a group_size of 0 uses a single scale for each output channel
+ * and the result is [..., M, N] with the type of a.
+ */
+struct dequantize_dot
+{
+    std::size_t bits       = 8;
+    std::size_t group_size = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.bits, "bits"), f(self.group_size, "group_size"));
+    }
+
+    std::string name() const { return "dequantize_dot"; }
+
+    value attributes() const { return {{"fixed_type_inputs", {1}}}; }
+
+    std::size_t groups(std::size_t k) const
+    {
+        if(group_size == 0)
+            return 1;
+        return (k + group_size - 1) / group_size;
+    }
+
+    std::size_t group_of(std::size_t k) const { return group_size == 0 ? 0 : k / group_size; }
+
+    std::size_t packed_size(std::size_t k) const { return bits == 4 ? (k + 1) / 2 : k; }
+
+    static std::int8_t unpack_int4(std::uint8_t x, std::size_t k)
+    {
+        int v = (k % 2 == 0) ? (x & 0x0f) : (x >> 4);
+        return v > 7 ? v - 16 : v;
+    }
+
+    shape::type_t weights_type() const
+    {
+        if(bits == 16)
+            return shape::half_type;
+        return bits == 4 ? shape::uint8_type : shape::int8_type;
+    }
+
+    // The weight of output channel n at index k along K before it is scaled
+    float load(const char* weights, std::size_t kp, std::size_t n, std::size_t k) const
+    {
+        if(bits == 16)
+            return reinterpret_cast<const half*>(weights)[n * kp + k];
+        const auto* w = reinterpret_cast<const std::uint8_t*>(weights);
+        if(bits == 4)
+            return unpack_int4(w[n * kp + k / 2], k);
+        return static_cast<std::int8_t>(w[n * kp + k]);
+    }
+
+    static std::uint8_t pack_int4(std::int8_t lo, std::int8_t hi)
+    {
+        return (lo & 0x0f) | ((hi & 0x0f) << 4);
+    }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(3).standard();
+        if(bits != 16 and bits != 8 and bits != 4)
+            MIGRAPHX_THROW("DEQUANTIZE_DOT: only 16, 8 and 4 bit weights are supported");
+        const auto& a       = inputs[0];
+        const auto& weights = inputs[1];
+        const auto& scales  = inputs[2];
+        if(a.lens().size() < 2 or weights.lens().size() != 2 or scales.lens().size() != 2)
+            MIGRAPHX_THROW("DEQUANTIZE_DOT: weights and scales must be 2 dims");
+        if(a.type() != shape::float_type and a.type() != shape::half_type and
+           a.type() != shape::double_type)
+            MIGRAPHX_THROW("DEQUANTIZE_DOT: only floating point inputs are supported");
+        if(weights.type() != weights_type() or scales.type() != shape::float_type)
+            MIGRAPHX_THROW("DEQUANTIZE_DOT: invalid type for weights or scales");
+        auto k = a.lens().back();
+        auto n = weights.lens()[0];
+        if(weights.lens()[1] != packed_size(k) or scales.lens()[0] != n or
+           scales.lens()[1] != groups(k))
+            MIGRAPHX_THROW("DEQUANTIZE_DOT: dimension mismatch: {" + to_string_range(a.lens()) +
+                           "} x {" + to_string_range(weights.lens()) + "} with scales {" +
+                           to_string_range(scales.lens()) + "}");
+        auto lens   = a.lens();
+        lens.back() = n;
+        return {a.type(), lens};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        auto k             = args[0].get_shape().lens().back();
+        auto n             = output_shape.lens().back();
+        auto kp            = packed_size(k);
+        auto g             = groups(k);
+        const auto* scales = args[2].cast<float>();
+        const auto* w      = args[1].data();
+        visit_all(result, args[0])([&](auto output, auto a) {
+            par_for(output_shape.elements(), [&](auto i) {
+                auto row   = i / n;
+                auto col   = i % n;
+                double acc = 0;
+                for(std::size_t j = 0; j < k; j++)
+                    acc += double(a[row * k + j]) * load(w, kp, col, j) *
+                           scales[col * g + group_of(j)];
+                output[i] = acc;
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
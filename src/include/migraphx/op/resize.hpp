@@ -0,0 +1,252 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_RESIZE_HPP
+#define MIGRAPHX_GUARD_OPERATORS_RESIZE_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/streamutils.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/value.hpp>
+#include <migraphx/config.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/// The input positions and their weights used for each output position along a dimension,
+/// where output position i uses index[i * count + j] and weight[i * count + j] for j < count
+struct resize_taps
+{
+    std::size_t count = 1;
+    std::vector<std::size_t> index;
+    std::vector<float> weight;
+};
+
+/**
+ * Resizes a tensor to sizes using nearest, linear or cubic interpolation over every dimension,
+ * following the ONNX Resize operator. The input coordinates are computed from the output
+ * coordinates for each dimension separately, so only the taps for each dimension are stored
+ * instead of indices for every output element.
+ */
+struct resize
+{
+    std::vector<std::size_t> sizes;
+    // Scales used by the coordinate transformation, where an empty vector uses the ratio of the
+    // output to the input lengths
+    std::vector<float> scales;
+    std::string mode                           = "nearest";
+    std::string coordinate_transformation_mode = "half_pixel";
+    std::string nearest_mode                   = "round_prefer_floor";
+    float cubic_coeff_a                        = -0.75f;
+    bool exclude_outside                       = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.sizes, "sizes"),
+                    f(self.scales, "scales"),
+                    f(self.mode, "mode"),
+                    f(self.coordinate_transformation_mode, "coordinate_transformation_mode"),
+                    f(self.nearest_mode, "nearest_mode"),
+                    f(self.cubic_coeff_a, "cubic_coeff_a"),
+                    f(self.exclude_outside, "exclude_outside"));
+    }
+
+    std::string name() const { return "resize"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(1);
+        const auto& input = inputs.front();
+        if(sizes.size() != input.lens().size())
+            MIGRAPHX_THROW("RESIZE: sizes {" + to_string_range(sizes) +
+                           "} do not match the input rank " + std::to_string(input.lens().size()));
+        if(not scales.empty() and scales.size() != sizes.size())
+            MIGRAPHX_THROW("RESIZE: ranks of sizes and scales are different");
+        if(not contains({"nearest", "linear", "cubic"}, mode))
+            MIGRAPHX_THROW("RESIZE: mode " + mode + " not supported");
+        if(not contains({"half_pixel",
+                         "pytorch_half_pixel",
+                         "align_corners",
+                         "asymmetric",
+                         "tf_half_pixel_for_nn"},
+                        coordinate_transformation_mode))
+            MIGRAPHX_THROW("RESIZE: coordinate_transformation_mode " +
+                           coordinate_transformation_mode + " not supported");
+        if(not contains({"round_prefer_floor", "round_prefer_ceil", "floor", "ceil"},
+                        nearest_mode))
+            MIGRAPHX_THROW("RESIZE: nearest_mode " + nearest_mode + " not supported");
+        return {input.type(), sizes};
+    }
+
+    double get_scale(std::size_t dim, std::size_t in_len, std::size_t out_len) const
+    {
+        if(scales.empty())
+            return 1.0 * out_len / in_len;
+        return scales[dim];
+    }
+
+    /// Position in the input for output position idx
+    double original_coordinate(std::size_t in_len,
+                               std::size_t out_len,
+                               std::size_t idx,
+                               double scale) const
+    {
+        const auto& m = coordinate_transformation_mode;
+        if(m == "pytorch_half_pixel")
+            return out_len > 1 ? (idx + 0.5) / scale - 0.5 : 0.0;
+        if(m == "align_corners")
+            return out_len == 1 ? 0.0 : 1.0 * idx * (in_len - 1.0) / (out_len - 1.0);
+        if(m == "asymmetric")
+            return idx / scale;
+        if(m == "tf_half_pixel_for_nn")
+            return (idx + 0.5) / scale;
+        return (idx + 0.5) / scale - 0.5;
+    }
+
+    std::size_t nearest(std::size_t in_len, double x) const
+    {
+        x = std::max(0.0, std::min(in_len - 1.0, x));
+        if(nearest_mode == "round_prefer_ceil")
+            return static_cast<std::size_t>(std::round(x));
+        if(nearest_mode == "floor")
+            return static_cast<std::size_t>(std::floor(x));
+        if(nearest_mode == "ceil")
+            return static_cast<std::size_t>(std::ceil(x));
+        return static_cast<std::size_t>(std::ceil(x - 0.5));
+    }
+
+    std::vector<float> cubic_coefficients(double ratio) const
+    {
+        double a = cubic_coeff_a;
+        double r = 1 - ratio;
+        return {float(((a * (ratio + 1) - 5 * a) * (ratio + 1) + 8 * a) * (ratio + 1) - 4 * a),
+                float(((a + 2) * ratio - (a + 3)) * ratio * ratio + 1),
+                float(((a + 2) * r - (a + 3)) * r * r + 1),
+                float(((a * (r + 1) - 5 * a) * (r + 1) + 8 * a) * (r + 1) - 4 * a)};
+    }
+
+    resize_taps compute_taps(std::size_t dim, std::size_t in_len) const
+    {
+        auto out_len = sizes[dim];
+        auto scale   = get_scale(dim, in_len, out_len);
+        resize_taps result;
+        result.count = mode == "nearest" ? 1 : (mode == "linear" ? 2 : 4);
+        result.index.resize(out_len * result.count);
+        result.weight.resize(out_len * result.count);
+        for(std::size_t i = 0; i < out_len; i++)
+        {
+            auto x      = original_coordinate(in_len, out_len, i, scale);
+            auto* index = result.index.data() + i * result.count;
+            auto* w     = result.weight.data() + i * result.count;
+            if(mode == "nearest")
+            {
+                index[0] = nearest(in_len, x);
+                w[0]     = 1;
+                continue;
+            }
+            auto x0    = std::floor(x);
+            auto ratio = x - x0;
+            // The first neighbour is before x, and neighbours outside of the input use the
+            // values at the edge
+            auto first = static_cast<std::ptrdiff_t>(x0) - std::ptrdiff_t(result.count / 2 - 1);
+            std::vector<float> coeffs{float(1 - ratio), float(ratio)};
+            if(mode == "cubic")
+                coeffs = cubic_coefficients(ratio);
+            float total = 0;
+            for(std::size_t j = 0; j < result.count; j++)
+            {
+                auto k = first + std::ptrdiff_t(j);
+                if(exclude_outside and (k < 0 or k >= std::ptrdiff_t(in_len)))
+                    coeffs[j] = 0;
+                index[j] = std::max<std::ptrdiff_t>(0, std::min<std::ptrdiff_t>(in_len - 1, k));
+                total += coeffs[j];
+            }
+            for(std::size_t j = 0; j < result.count; j++)
+                w[j] = exclude_outside ? coeffs[j] / total : coeffs[j];
+        }
+        // Use a single tap when each output position only reads one input position, which is the
+        // case for the dimensions that are not resized
+        std::vector<std::size_t> single_index(out_len);
+        bool single = result.count > 1;
+        for(std::size_t i = 0; i < out_len and single; i++)
+        {
+            bool found  = false;
+            float total = 0;
+            for(std::size_t j = 0; j < result.count; j++)
+            {
+                auto t = i * result.count + j;
+                if(result.weight[t] == 0)
+                    continue;
+                if(found and result.index[t] != single_index[i])
+                    single = false;
+                found           = true;
+                single_index[i] = result.index[t];
+                total += result.weight[t];
+            }
+            single = single and total == 1.0f;
+        }
+        if(single)
+        {
+            resize_taps compact;
+            compact.index = single_index;
+            compact.weight.assign(out_len, 1.0f);
+            return compact;
+        }
+        return result;
+    }
+
+    std::vector<resize_taps> compute_taps(const std::vector<std::size_t>& in_lens) const
+    {
+        std::vector<resize_taps> result;
+        for(std::size_t d = 0; d < in_lens.size(); d++)
+            result.push_back(compute_taps(d, in_lens[d]));
+        return result;
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        const auto& in_shape = args[0].get_shape();
+        auto taps            = compute_taps(in_shape.lens());
+        auto ndim            = taps.size();
+        visit_all(result, args[0])([&](auto output, auto input) {
+            const auto* in_ptr = input.data();
+            par_for(output_shape.elements(), [&](auto i) {
+                auto out_idx = output_shape.multi(i);
+                // Visit every combination of the taps in each dimension
+                std::vector<std::size_t> k(ndim, 0);
+                double acc = 0;
+                for(;;)
+                {
+                    std::size_t offset = 0;
+                    double w           = 1;
+                    for(std::size_t d = 0; d < ndim; d++)
+                    {
+                        auto t = out_idx[d] * taps[d].count + k[d];
+                        offset += taps[d].index[t] * in_shape.strides()[d];
+                        w *= taps[d].weight[t];
+                    }
+                    acc += w * in_ptr[offset];
+                    std::size_t d = ndim;
+                    while(d > 0 and ++k[d - 1] == taps[d - 1].count)
+                        k[--d] = 0;
+                    if(d == 0)
+                        break;
+                }
+                output[i] = acc;
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_SPARSE_DOT_HPP
+#define MIGRAPHX_GUARD_OPERATORS_SPARSE_DOT_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/streamutils.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/value.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Multiplies a float matrix by [K, N] weights stored in a block-sparse row format, where each
+ * row of the weights is split into blocks of block_size consecutive columns and only the blocks
+ * with nonzero values are stored. The inputs are:
+ *   - a: [..., M, K]
+ *   - values: [B, block_size] float values of the stored blocks, where columns past n are zero
+ *   - columns: [B] int32 index of the block in its row, so it starts at column
+ *     columns[b] * block_size
+ *   - rows: [K + 1] int32 offsets, where the blocks of row k are rows[k] to rows[k + 1]
+ * and the result is [..., M, n] with the type of a. A block_size of 1 is the CSR format.
+ */
+struct sparse_dot
+{
+    std::size_t n          = 0;
+    std::size_t block_size = 1;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.n, "n"), f(self.block_size, "block_size"));
+    }
+
+    std::string name() const { return "sparse_dot"; }
+
+    value attributes() const { return {{"fixed_type_inputs", {2, 3}}}; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(4).standard();
+        if(block_size == 0 or n == 0)
+            MIGRAPHX_THROW("SPARSE_DOT: n and block_size must not be zero");
+        const auto& a       = inputs[0];
+        const auto& values  = inputs[1];
+        const auto& columns = inputs[2];
+        const auto& rows    = inputs[3];
+        if(a.lens().size() < 2 or values.lens().size() != 2)
+            MIGRAPHX_THROW("SPARSE_DOT: a and values must have at least 2 dims");
+        if(a.type() != shape::float_type and a.type() != shape::half_type and
+           a.type() != shape::double_type)
+            MIGRAPHX_THROW("SPARSE_DOT: only floating point inputs are supported");
+        if(values.type() != shape::float_type or columns.type() != shape::int32_type or
+           rows.type() != shape::int32_type)
+            MIGRAPHX_THROW("SPARSE_DOT: invalid type for values, columns or rows");
+        if(values.lens()[1] != block_size or columns.elements() != values.lens()[0] or
+           rows.elements() != a.lens().back() + 1)
+            MIGRAPHX_THROW("SPARSE_DOT: dimension mismatch: {" + to_string_range(a.lens()) +
+                           "} with values {" + to_string_range(values.lens()) + "}, " +
+                           std::to_string(columns.elements()) + " columns and " +
+                           std::to_string(rows.elements()) + " rows");
+        auto lens   = a.lens();
+        lens.back() = n;
+        return {a.type(), lens};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        auto k              = args[0].get_shape().lens().back();
+        auto m              = output_shape.elements() / n;
+        const auto* values  = args[1].cast<float>();
+        const auto* columns = args[2].cast<std::int32_t>();
+        const auto* rows    = args[3].cast<std::int32_t>();
+        visit_all(result, args[0])([&](auto output, auto a) {
+            par_for(m, [&](auto i) {
+                std::vector<double> acc(n);
+                for(std::size_t j = 0; j < k; j++)
+                {
+                    double x = a[i * k + j];
+                    for(auto b = rows[j]; b < rows[j + 1]; b++)
+                    {
+                        auto col = columns[b] * block_size;
+                        for(std::size_t c = 0; c < block_size and col + c < n; c++)
+                            acc[col + c] += x * values[b * block_size + c];
+                    }
+                }
+                std::copy(acc.begin(), acc.end(), output.begin() + i * n);
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
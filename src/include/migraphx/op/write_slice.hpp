@@ -0,0 +1,96 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_WRITE_SLICE_HPP
+#define MIGRAPHX_GUARD_OPERATORS_WRITE_SLICE_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/streamutils.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/value.hpp>
+#include <migraphx/op/normalize_attribute.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Writes the update (second input) into the data (first input) along axis, starting at the
+ * offset given by the third input at runtime. The result is a copy of the data with the update
+ * written into it. When inplace is set, which the inplace_write_slice pass does for a parameter
+ * that nothing else reads, the data is modified in place and returned instead, so a buffer that
+ * is kept between evaluations, such as a cache of keys and values, can be appended to without
+ * copying it.
+ */
+struct write_slice
+{
+    int64_t axis = 0;
+    bool inplace = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.axis, "axis"), f(self.inplace, "inplace"));
+    }
+
+    value attributes() const
+    {
+        value normalize;
+        normalize["axis"] = value::array{normalize_attribute::include_min};
+        // The data can be written in place, so converting it to another type would write into a
+        // copy and the offset is an index, so every input is read in its own type. It is not
+        // folded either, since a literal can share its buffer with other instructions.
+        return {{"normalize_axes", normalize},
+                {"fixed_type_inputs", {0, 1, 2}},
+                {"no_constant_fold", true}};
+    }
+
+    std::string name() const { return "write_slice"; }
+
+    shape normalize_compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(3);
+        check_shapes{inputs.data(), inputs.data() + 2, *this}.same_type().same_ndims();
+        const auto& data   = inputs[0];
+        const auto& update = inputs[1];
+        for(std::size_t i = 0; i < data.lens().size(); i++)
+        {
+            if(i == static_cast<std::size_t>(axis) and update.lens()[i] <= data.lens()[i])
+                continue;
+            if(update.lens()[i] != data.lens()[i])
+                MIGRAPHX_THROW("WRITE_SLICE: update {" + to_string_range(update.lens()) +
+                               "} does not fit in data {" + to_string_range(data.lens()) + "}");
+        }
+        if(inputs[2].elements() != 1)
+            MIGRAPHX_THROW("WRITE_SLICE: offset must have a single element");
+        return data;
+    }
+
+    argument compute(const shape&, std::vector<argument> args) const
+    {
+        auto offset = args[2].at<int64_t>();
+        auto len    = args[0].get_shape().lens()[axis];
+        auto n      = args[1].get_shape().lens()[axis];
+        if(offset < 0 or static_cast<std::size_t>(offset) + n > len)
+            MIGRAPHX_THROW("WRITE_SLICE: writing " + std::to_string(n) + " elements at offset " +
+                           std::to_string(offset) + " is out of range " + std::to_string(len));
+        if(not inplace)
+            args[0] = args[0].copy();
+        visit_all(args[0], args[1])([&](auto output, auto update) {
+            shape_for_each(update.get_shape(), [&](const auto& idx) {
+                auto out_idx = idx;
+                out_idx[axis] += offset;
+                output(out_idx.begin(), out_idx.end()) = update(idx.begin(), idx.end());
+            });
+        });
+        return args[0];
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>&) const { return inplace ? 0 : -1; }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
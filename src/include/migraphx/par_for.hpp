@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <vector>
 #include <cassert>
+#include <exception>
+#include <mutex>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -90,6 +92,28 @@ void par_for(std::size_t n, F f)
     par_for(n, min_grain, f);
 }
 
+/// Same as par_for, but an exception thrown by f is rethrown on the calling thread
+template <class F>
+void par_for_rethrow(std::size_t n, std::size_t min_grain, F f)
+{
+    std::exception_ptr ex = nullptr;
+    std::mutex m;
+    par_for(n, min_grain, [&](auto i) {
+        try
+        {
+            f(i);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if(ex == nullptr)
+                ex = std::current_exception();
+        }
+    });
+    if(ex != nullptr)
+        std::rethrow_exception(ex);
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
@@ -0,0 +1,68 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHLIB_PERF_COUNTERS_HPP
+#define MIGRAPHX_GUARD_MIGRAPHLIB_PERF_COUNTERS_HPP
+
+#include <migraphx/config.hpp>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+enum class perf_event
+{
+    cycles,
+    instructions,
+    llc_misses
+};
+
+struct perf_counter_values
+{
+    std::uint64_t cycles       = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t llc_misses   = 0;
+    /// Whether each event in the order of perf_event could be counted
+    std::vector<bool> available = std::vector<bool>(3, false);
+
+    /// Instructions per cycle
+    double ipc() const;
+    /// Memory traffic estimated from the last level cache misses, in bytes
+    double llc_bytes() const;
+
+    perf_counter_values& operator+=(const perf_counter_values& x);
+
+    /// Prints the averages over n runs, with the bandwidth computed from the time in milliseconds
+    void print(std::ostream& os, std::size_t n, double ms) const;
+};
+
+/**
+ * @brief Hardware performance counters read with perf_event_open
+ * @details The counters are opened on every thread of the process that exists when this is
+ * constructed, so it should be created after the thread pools used by the program have started.
+ * Only user-space events are counted. Events the kernel or the hardware doesn't support are
+ * skipped, and available returns false when no event could be opened.
+ */
+struct perf_counters
+{
+    perf_counters();
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+    ~perf_counters();
+
+    bool available() const;
+
+    /// Reset and enable the counters
+    void start();
+
+    /// Disable the counters and return their values since start
+    perf_counter_values stop();
+
+    private:
+    // File descriptors for each event for each thread
+    std::vector<std::vector<int>> fds;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
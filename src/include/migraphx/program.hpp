@@ -51,6 +51,10 @@ struct program
 
     std::vector<argument> eval(parameter_map params) const;
 
+    /// Evaluates only the instructions needed for the selected outputs, which are returned in
+    /// the order they are given
+    std::vector<argument> eval(parameter_map params, const std::vector<std::size_t>& outputs) const;
+
     std::size_t size() const;
 
     std::vector<shape> get_output_shapes() const;
@@ -63,12 +67,26 @@ struct program
 
     bool is_compiled() const;
 
+    /// The name of the target the program was compiled for, which is empty when it isn't compiled
+    std::string get_target_name() const;
+
+    /// Whether the program was compiled with offload_copy, so its outputs are in host memory
+    bool is_offload_copy() const;
+
     void finalize();
 
-    void perf_report(std::ostream& os, std::size_t n, parameter_map params) const;
+    /// When counters is set, hardware performance counters are also collected for each
+    /// instruction in separate runs, if the system supports them
+    void perf_report(std::ostream& os,
+                     std::size_t n,
+                     parameter_map params,
+                     bool counters = false) const;
 
     value to_value() const;
     void from_value(const value& v);
+    /// Builds the program with read_literal creating each literal from its serialized value,
+    /// which lets the data be read from somewhere other than the value
+    void from_value(const value& v, const std::function<literal(const value&)>& read_literal);
 
     void debug_print() const;
     void debug_print(instruction_ref ins) const;
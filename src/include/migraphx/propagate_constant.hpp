@@ -3,17 +3,75 @@
 
 #include <string>
 #include <migraphx/config.hpp>
+#include <migraphx/literal.hpp>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
 struct module;
 
+/**
+ * @brief Folded constants kept across compilations
+ * @details Results are keyed by the operators that computed them and the hashes of the literals
+ * they were computed from. A result is only reused when those literals also have the same bytes,
+ * so the cache holds on to them. The results and the literals they hold are limited to a number
+ * of bytes, and the least recently used results are dropped first. It is safe to share a cache
+ * between threads.
+ */
+struct constant_fold_cache
+{
+    explicit constant_fold_cache(std::size_t max_bytes = std::size_t{1} << 30);
+
+    /// Returns the cached result, or an empty literal if there is none for these inputs
+    literal find(const std::string& key, const std::vector<literal>& inputs) const;
+
+    /// Results larger than the capacity of the cache are not kept
+    void insert(const std::string& key, std::vector<literal> inputs, literal result);
+
+    std::size_t size() const;
+
+    /// Bytes of the results and of the literals they were computed from
+    std::size_t bytes() const;
+
+    /// Number of results that were reused
+    std::size_t hits() const;
+
+    void clear();
+
+    private:
+    struct entry
+    {
+        std::vector<literal> inputs;
+        literal result;
+        std::size_t bytes = 0;
+        std::list<std::string>::iterator position;
+    };
+    void erase(std::unordered_map<std::string, entry>::iterator it);
+
+    mutable std::mutex m;
+    std::size_t capacity;
+    std::size_t total_bytes = 0;
+    // Keys of the results with the most recently used first
+    mutable std::list<std::string> recent;
+    std::unordered_map<std::string, entry> entries;
+    mutable std::size_t hit_count = 0;
+};
+
 /**
  * Replace instructions which take all literals with a literal of the computation.
+ *
+ * The constant subgraphs are evaluated together, level by level, with the instructions of each
+ * level computed in parallel. Only the results used by the rest of the module become literals,
+ * and they share the buffers of the computed results.
  */
 struct propagate_constant
 {
+    /// When set, folded results are looked up in and added to the cache
+    constant_fold_cache* cache = nullptr;
     std::string name() const { return "propagate_constant"; }
     void apply(module& p) const;
 };
@@ -44,6 +44,16 @@ void quantize_int8_impl(program& prog,
                         const std::vector<std::pair<float, float>>& quant_params,
                         const std::vector<std::string>& ins_names);
 
+// store the constant weights of dot as int8 or packed int4 values with a scale for each
+// output channel, or for each group of group_size values, which are dequantized when the
+// dot is computed, so no calibration data is needed. With 16 bits the weights are stored as
+// half values and the dot is still computed in float.
+void quantize_weights(program& prog, std::size_t bits = 8, std::size_t group_size = 0);
+
+// the weights of a dot with floating point inputs, when they are constant and the same for
+// every batch, or an empty argument when they are not
+argument constant_dot_weights(instruction_ref ins);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
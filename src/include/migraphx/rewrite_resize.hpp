@@ -0,0 +1,25 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_REWRITE_RESIZE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_REWRITE_RESIZE_HPP
+
+#include <string>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Rewrite resize to a gather from the flattened input with an index literal for each output
+ * element, for targets without a resize kernel
+ */
+struct rewrite_resize
+{
+    std::string name() const { return "rewrite_resize"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_RUN_QUEUE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_RUN_QUEUE_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/program.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+enum class run_status
+{
+    queued,
+    running,
+    completed,
+    failed,
+    cancelled,
+    rejected
+};
+
+struct run_request_impl;
+struct run_queue_impl;
+
+/// Handle to a request submitted to a run_queue
+struct run_request
+{
+    run_request() = default;
+
+    run_status status() const;
+
+    /// Whether the request will no longer change its status
+    bool done() const;
+
+    void wait() const;
+
+    /// Returns true if the request is done before the timeout
+    bool wait_for(std::chrono::milliseconds timeout) const;
+
+    /// Waits for the request and returns the outputs, rethrows the error if it failed
+    std::vector<argument> get() const;
+
+    private:
+    friend run_queue_impl;
+    std::shared_ptr<run_request_impl> impl;
+};
+
+/// Called from the thread that finishes the request after waiters are woken, it must not throw
+using run_callback = std::function<void(run_status)>;
+
+struct run_queue_options
+{
+    /// Number of worker threads, each one evaluates its own copy of the program
+    std::size_t workers = 1;
+    /// Maximum number of requests waiting to run
+    std::size_t capacity = 16;
+};
+
+/**
+ * @brief Evaluates a compiled program asynchronously on a pool of workers
+ *
+ * Requests are queued in submission order. When the queue is full submit blocks until a worker
+ * takes a request, while try_submit returns a request with the rejected status. Queued requests
+ * can be cancelled, and the ones still queued when the run_queue is destroyed are cancelled.
+ * The results are returned in host memory, copied through the target when the program leaves
+ * them on the device.
+ */
+struct run_queue
+{
+    run_queue(const program& p, run_queue_options options = run_queue_options{});
+    run_queue(run_queue&&) noexcept;
+    run_queue(const run_queue&) = delete;
+    run_queue& operator=(const run_queue&) = delete;
+    ~run_queue();
+
+    /// When outputs are given the results are copied into them instead of being returned
+    run_request submit(parameter_map params,
+                       std::vector<argument> outputs = {},
+                       run_callback callback         = nullptr);
+
+    run_request try_submit(parameter_map params,
+                           std::vector<argument> outputs = {},
+                           run_callback callback         = nullptr);
+
+    /// Cancel the request if it hasn't started running
+    bool cancel(const run_request& r);
+
+    /// Number of requests waiting to run
+    std::size_t size() const;
+
+    private:
+    std::unique_ptr<run_queue_impl> impl;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_SESSION_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_SESSION_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/argument.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Evaluates a program with state parameters, whose buffers are kept by the session between
+ * calls instead of being passed in by the caller. The program can update a state in place, for
+ * example by appending to a cache with write_slice, or it can return the new value, which is
+ * copied into the state buffer after each call.
+ */
+struct session
+{
+    session() = default;
+
+    explicit session(program p);
+
+    /// Keep the parameter name between calls starting from zeros. When output is not negative,
+    /// the state is set to that output of the program after each call.
+    void add_state(const std::string& name, std::ptrdiff_t output = -1);
+
+    /// Keep the parameter name between calls starting from init
+    void add_state(const std::string& name, const argument& init, std::ptrdiff_t output = -1);
+
+    bool has_state(const std::string& name) const;
+
+    std::vector<std::string> get_state_names() const;
+
+    /// The buffer holding the current value of the state
+    argument get_state(const std::string& name) const;
+
+    void set_state(const std::string& name, const argument& value);
+
+    /// Sets every state back to its initial value
+    void reset();
+
+    /// Evaluates the program with the states added to the parameters
+    std::vector<argument> eval(parameter_map params);
+
+    const program& get_program() const;
+
+    private:
+    struct state
+    {
+        argument buffer;
+        argument init;
+        std::ptrdiff_t output = -1;
+    };
+    const state& get(const std::string& name) const;
+    program prog;
+    std::unordered_map<std::string, state> states;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_SHAPE_SPECIALIZER_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_SHAPE_SPECIALIZER_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/propagate_constant.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Copies an uncompiled program with the parameters changed to the new shapes, and the shapes of
+/// the other instructions computed again from them
+program specialize_parameters(const program& p,
+                              const std::unordered_map<std::string, shape>& shapes);
+
+/**
+ * @brief Compiles a parsed program for the input shapes it is run with
+ *
+ * A few shape independent simplifications are done once when the specializer is created, but
+ * each new set of input shapes still runs every pass of the target on the specialized program,
+ * since the passes of a target are not split by whether they depend on the shapes. Constants
+ * folded while compiling are shared between the specializations, which only saves the time of
+ * folding them again. The most recently used compiled programs are kept, so running with shapes
+ * that were seen recently does not compile again. When no fold cache is given in the compile
+ * options, the specializer's own cache is cleared whenever a compiled program is dropped, so it
+ * only holds the constants of the programs that are kept.
+ */
+struct shape_specializer
+{
+    /// Keeps at most capacity compiled programs, dropping the least recently used one first
+    shape_specializer(program p,
+                      target t,
+                      compile_options options = compile_options{},
+                      std::size_t capacity    = 16);
+    shape_specializer(const shape_specializer&) = delete;
+    shape_specializer& operator=(const shape_specializer&) = delete;
+
+    /// Returns the program compiled for the parameter shapes, where parameters that are missing
+    /// keep the shapes they were parsed with. The program stays valid after it is dropped from
+    /// the specializer. The same program is returned to every caller with these shapes, and it
+    /// cannot be evaluated by several threads at once, so callers that evaluate it themselves
+    /// need to serialize the calls.
+    std::shared_ptr<const program> compile(const std::unordered_map<std::string, shape>& shapes);
+
+    /// Evaluates the program compiled for the shapes of the parameters. Calls that use the same
+    /// compiled program wait for each other, while calls with other shapes run concurrently.
+    std::vector<argument> eval(parameter_map params);
+
+    /// Number of compiled programs that are kept
+    std::size_t size() const;
+
+    private:
+    struct compiled_program
+    {
+        program prog;
+        // Serializes eval, since a compiled program has a single context
+        std::mutex m;
+    };
+    std::shared_ptr<compiled_program>
+    get_compiled(const std::unordered_map<std::string, shape>& shapes);
+
+    program prog;
+    target t;
+    compile_options options;
+    constant_fold_cache fold_cache;
+    std::size_t capacity;
+    mutable std::mutex m;
+    // Keys of the compiled programs with the most recently used first
+    std::list<std::string> recent;
+    std::unordered_map<
+        std::string,
+        std::pair<std::shared_ptr<compiled_program>, std::list<std::string>::iterator>>
+        programs;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
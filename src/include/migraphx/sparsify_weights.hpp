@@ -0,0 +1,31 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_SPARSIFY_WEIGHTS_HPP
+#define MIGRAPHX_GUARD_RTGLIB_SPARSIFY_WEIGHTS_HPP
+
+#include <string>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Replace dot instructions whose weights are constant and mostly zero with sparse_dot, which
+ * stores only the blocks of block_size consecutive weights along N with nonzero values. Weights
+ * are converted when the fraction of blocks that are stored is at most density. When verify is
+ * set, each converted dot is computed for a generated input with both the dense and the sparse
+ * weights, and an exception is thrown if the results differ.
+ */
+struct sparsify_weights
+{
+    float density          = 0.3f;
+    std::size_t block_size = 1;
+    bool verify            = false;
+    std::string name() const { return "sparsify_weights"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,28 @@
+#include <migraphx/inplace_write_slice.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+void inplace_write_slice::apply(module& m) const
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "write_slice")
+            continue;
+        auto data = ins->inputs().front();
+        if(data->name() != "@param" or data->outputs().size() != 1)
+            continue;
+        auto v = ins->get_operator().to_value();
+        if(v["inplace"].to<bool>())
+            continue;
+        v["inplace"] = true;
+        m.replace_instruction(ins, make_op("write_slice", v), ins->inputs());
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,129 @@
+#include <migraphx/literal_store.hpp>
+#include <migraphx/allocator.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static std::size_t hash_combine(std::size_t seed, std::size_t x)
+{
+    return seed ^ (x + 0x9e3779b97f4a7c15ULL + (seed << 6u) + (seed >> 2u));
+}
+
+static std::size_t hash_bytes(const char* data, std::size_t n)
+{
+    // FNV-1a over 64-bit words followed by the trailing bytes
+    const std::uint64_t prime = 0x100000001b3ULL;
+    std::uint64_t h           = 0xcbf29ce484222325ULL;
+    std::size_t i             = 0;
+    for(; i + sizeof(std::uint64_t) <= n; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t w = 0;
+        std::memcpy(&w, data + i, sizeof(w));
+        h = (h ^ w) * prime;
+    }
+    for(; i < n; i++)
+        h = (h ^ static_cast<unsigned char>(data[i])) * prime;
+    return h;
+}
+
+static std::size_t hash_shape(const shape& s)
+{
+    std::size_t h = std::hash<int>{}(s.type());
+    for(auto len : s.lens())
+        h = hash_combine(h, len);
+    for(auto stride : s.strides())
+        h = hash_combine(h, stride);
+    return h;
+}
+
+std::size_t hash_literal(const literal& l)
+{
+    auto h = hash_shape(l.get_shape());
+    if(l.empty())
+        return h;
+    return hash_combine(h, hash_bytes(l.data(), l.get_shape().bytes()));
+}
+
+static bool same_bytes(const shape& s, const char* x, const char* y)
+{
+    if(x == y)
+        return true;
+    if(x == nullptr or y == nullptr)
+        return false;
+    return std::memcmp(x, y, s.bytes()) == 0;
+}
+
+bool same_literal_data(const literal& x, const literal& y)
+{
+    if(x.get_shape() != y.get_shape())
+        return false;
+    return same_bytes(x.get_shape(), x.data(), y.data());
+}
+
+argument literal_store::insert(const literal& l)
+{
+    if(l.empty())
+        return {};
+    const auto& s = l.get_shape();
+    auto h        = hash_literal(l);
+    std::lock_guard<std::mutex> lock(m);
+    requested += s.bytes();
+    auto r = entries.equal_range(h);
+    for(auto it = r.first; it != r.second;)
+    {
+        auto data = it->second.data.lock();
+        if(data == nullptr)
+        {
+            it = entries.erase(it);
+            continue;
+        }
+        if(it->second.s == s and same_bytes(s, data.get(), l.data()))
+        {
+            saved += s.bytes();
+            return {s, data};
+        }
+        ++it;
+    }
+    auto data = allocate_buffer(s.bytes());
+    std::copy(l.data(), l.data() + s.bytes(), data.get());
+    entries.emplace(h, entry{s, data});
+    return {s, data};
+}
+
+std::size_t literal_store::size() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    return std::count_if(
+        entries.begin(), entries.end(), [](const auto& p) { return not p.second.data.expired(); });
+}
+
+std::size_t literal_store::bytes_requested() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    return requested;
+}
+
+std::size_t literal_store::bytes_saved() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    return saved;
+}
+
+void literal_store::clear()
+{
+    std::lock_guard<std::mutex> lock(m);
+    entries.clear();
+    requested = 0;
+    saved     = 0;
+}
+
+literal_store& get_literal_store()
+{
+    static literal_store store{}; // NOLINT
+    return store;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
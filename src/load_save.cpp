@@ -3,6 +3,8 @@
 #include <migraphx/json.hpp>
 #include <migraphx/msgpack.hpp>
 #include <migraphx/file_buffer.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/serialize.hpp>
 #include <fstream>
 
 namespace migraphx {
@@ -16,12 +18,40 @@ program load_buffer(const std::vector<char>& buffer, const file_options& options
 {
     return load_buffer(buffer.data(), buffer.size(), options);
 }
+
+static bool is_literal_data(const std::vector<std::string>& keys)
+{
+    return keys.size() == 6 and keys[0] == "modules" and keys[2] == "nodes" and
+           keys[4] == "literal" and keys[5] == "data";
+}
+
+// Literal data is left in the buffer while the value is decoded and is copied once, straight into
+// each literal, rather than into the value first
+static void from_msgpack_program(program& p, const char* buffer, std::size_t size)
+{
+    std::vector<std::pair<const char*, std::size_t>> literal_data;
+    auto v = from_msgpack(
+        buffer, size, [&](const std::vector<std::string>& keys, const char* data, std::size_t n) {
+            if(not is_literal_data(keys))
+                return value(value::binary{data, n});
+            literal_data.emplace_back(data, n);
+            return value(literal_data.size() - 1);
+        });
+    p.from_value(v, [&](const value& l) {
+        auto s    = from_value<shape>(l.at("shape"));
+        auto data = literal_data.at(l.at("data").to<std::size_t>());
+        if(data.second != s.bytes())
+            MIGRAPHX_THROW("Literal data does not match its shape");
+        return literal(s, data.first);
+    });
+}
+
 program load_buffer(const char* buffer, std::size_t size, const file_options& options)
 {
     program p;
     if(options.format == "msgpack")
     {
-        p.from_value(from_msgpack(buffer, size));
+        from_msgpack_program(p, buffer, size);
     }
     else if(options.format == "json")
     {
@@ -0,0 +1,185 @@
+#include <migraphx/matcher.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/ranges.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace match {
+
+matcher_index::matcher_index(std::vector<std::vector<std::string>> names) : roots(std::move(names))
+{
+}
+
+const std::vector<std::size_t>& matcher_index::get(const std::string& name)
+{
+    auto it = candidates.find(name);
+    if(it != candidates.end())
+        return it->second;
+    std::vector<std::size_t> result;
+    for(std::size_t i = 0; i < roots.size(); i++)
+    {
+        if(roots[i].empty() or contains(roots[i], name))
+            result.push_back(i);
+    }
+    return candidates[name] = result;
+}
+
+match_worklist::match_worklist(module& m, std::size_t n)
+    : mod(&m), max_rewrites(n), max_total_rewrites(n * m.size())
+{
+    push_all();
+}
+
+void match_worklist::push(instruction_ref ins)
+{
+    if(mod->has_instruction(ins))
+        queued.insert(ins);
+}
+
+void match_worklist::push_around(instruction_ref ins, std::size_t depth)
+{
+    if(not mod->has_instruction(ins))
+        return;
+    push(ins);
+    if(depth == 0)
+        return;
+    for(auto input : ins->inputs())
+        push_around(input, depth - 1);
+    for(auto output : ins->outputs())
+        push_around(output, depth - 1);
+}
+
+// Queue the instructions that were inserted by a rewrite, which are found by following the inputs
+// until an instruction that existed before is reached
+void match_worklist::push_new(instruction_ref ins)
+{
+    if(not mod->has_instruction(ins))
+        return;
+    push(ins);
+    if(not known.insert(ins).second)
+        return;
+    for(auto input : ins->inputs())
+        push_new(input);
+}
+
+void match_worklist::push_all()
+{
+    for(auto ins : iterator_for(*mod))
+    {
+        known.insert(ins);
+        queued.insert(ins);
+    }
+}
+
+bool match_worklist::pop(instruction_ref ins)
+{
+    if(queued.erase(ins) == 0)
+        return false;
+    if(total_rewrites >= max_total_rewrites)
+        return false;
+    auto it = rewrites.find(ins);
+    return it == rewrites.end() or it->second < max_rewrites;
+}
+
+bool match_worklist::next_sweep()
+{
+    if(changed_in_sweep)
+        dead_code_elimination{}.apply(*mod);
+    changed_since_full_sweep = changed_since_full_sweep or changed_in_sweep;
+    changed_in_sweep         = false;
+    // Matchers that keep rewriting each other's results could otherwise run forever
+    if(total_rewrites >= max_total_rewrites)
+        return false;
+    // Drop the instructions that were removed, so a new instruction allocated at the same address
+    // doesn't inherit their state, and remember the ones that exist now so the ones inserted by
+    // the next rewrites can be found
+    std::unordered_set<instruction_ref> remaining;
+    std::unordered_map<instruction_ref, std::size_t> remaining_rewrites;
+    known.clear();
+    for(auto ins : iterator_for(*mod))
+    {
+        known.insert(ins);
+        if(contains(queued, ins))
+            remaining.insert(ins);
+        auto it = rewrites.find(ins);
+        if(it != rewrites.end())
+            remaining_rewrites.insert(*it);
+    }
+    queued.swap(remaining);
+    rewrites.swap(remaining_rewrites);
+    if(not queued.empty())
+        return true;
+    if(not changed_since_full_sweep)
+        return false;
+    // A matcher can look further than the instructions around a rewrite, so go through every
+    // instruction again to check nothing was missed
+    changed_since_full_sweep = false;
+    push_all();
+    return true;
+}
+
+void match_worklist::before_rewrite(const matcher_result& r)
+{
+    snapshots.clear();
+    auto add = [&](instruction_ref ins) {
+        if(std::any_of(snapshots.begin(), snapshots.end(), [&](const auto& s) {
+               return s.ins == ins;
+           }))
+            return;
+        snapshots.push_back({ins, ins->get_operator(), ins->inputs(), ins->outputs()});
+    };
+    add(r.result);
+    for(auto&& p : r.instructions)
+        add(p.second);
+    size_before = mod->size();
+    rewrites[r.result]++;
+    total_rewrites++;
+}
+
+void match_worklist::after_rewrite()
+{
+    bool changed = mod->size() != size_before or
+                   std::any_of(snapshots.begin(), snapshots.end(), [&](const auto& s) {
+                       return not mod->has_instruction(s.ins) or s.ins->get_operator() != s.op or
+                              s.ins->inputs() != s.inputs or s.ins->outputs() != s.outputs;
+                   });
+    // The match didn't change the module, so matching its neighbours again won't find anything
+    if(not changed)
+        return;
+    changed_in_sweep = true;
+    // Forget the instructions the rewrite removed before their addresses can be reused
+    for(const auto& s : snapshots)
+    {
+        if(mod->has_instruction(s.ins))
+            continue;
+        rewrites.erase(s.ins);
+        known.erase(s.ins);
+    }
+    for(const auto& s : snapshots)
+    {
+        // Inputs may be used once after the unused instructions are removed, and outputs have
+        // new inputs
+        for(auto input : s.inputs)
+            push_around(input, 1);
+        for(auto output : s.outputs)
+        {
+            push_around(output, 1);
+            if(not mod->has_instruction(output))
+                continue;
+            for(auto input : output->inputs())
+                push_new(input);
+        }
+        if(not mod->has_instruction(s.ins))
+            continue;
+        // The instruction may have been replaced in place
+        push_around(s.ins, 1);
+        for(auto input : s.ins->inputs())
+            push_new(input);
+    }
+}
+
+} // namespace match
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -1,83 +1,14 @@
 #include <migraphx/msgpack.hpp>
 #include <migraphx/serialize.hpp>
 #include <msgpack.hpp>
+#include <algorithm>
+#include <iterator>
 
 namespace msgpack {
 MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
 {
     namespace adaptor {
 
-    template <>
-    struct convert<migraphx::value>
-    {
-        const msgpack::object& operator()(const msgpack::object& o, migraphx::value& v) const
-        {
-            switch(o.type)
-            {
-            case msgpack::type::NIL:
-            {
-                v = nullptr;
-                break;
-            }
-            case msgpack::type::BOOLEAN:
-            {
-                v = o.as<bool>();
-                break;
-            }
-            case msgpack::type::POSITIVE_INTEGER:
-            {
-                v = o.as<std::uint64_t>();
-                break;
-            }
-            case msgpack::type::NEGATIVE_INTEGER:
-            {
-                v = o.as<std::int64_t>();
-                break;
-            }
-            case msgpack::type::FLOAT32:
-            case msgpack::type::FLOAT64:
-            {
-                v = o.as<double>();
-                break;
-            }
-            case msgpack::type::STR:
-            {
-                v = o.as<std::string>();
-                break;
-            }
-            case msgpack::type::BIN:
-            {
-                v = migraphx::value::binary{o.via.bin.ptr, o.via.bin.size};
-                break;
-            }
-            case msgpack::type::ARRAY:
-            {
-                migraphx::value r = migraphx::value::array{};
-                std::for_each(
-                    o.via.array.ptr,
-                    o.via.array.ptr + o.via.array.size,
-                    [&](const msgpack::object& so) { r.push_back(so.as<migraphx::value>()); });
-                v = r;
-                break;
-            }
-            case msgpack::type::MAP:
-            {
-                migraphx::value r = migraphx::value::object{};
-                std::for_each(o.via.map.ptr,
-                              o.via.map.ptr + o.via.map.size,
-                              [&](const msgpack::object_kv& p) {
-                                  r[p.key.as<std::string>()] = p.val.as<migraphx::value>();
-                              });
-                v = r;
-                break;
-            }
-            case msgpack::type::EXT: { MIGRAPHX_THROW("msgpack EXT type not supported.");
-            }
-            }
-            return o;
-        }
-    };
-
     template <>
     struct pack<migraphx::value::binary>
     {
@@ -163,10 +94,134 @@ std::vector<char> to_msgpack(const value& v)
     msgpack::pack(vs, v);
     return vs.buffer;
 }
+// Builds the value as the parser visits each element so no msgpack::object tree is created.
+// Since value has no move constructor, each element is assigned in place in its parent and arrays
+// are sized up front so adding elements never copies the ones already read.
+struct value_visitor : msgpack::v2::null_visitor
+{
+    struct container
+    {
+        value* v;
+        bool is_map;
+        // The next element of an array, or the key of the element being read in a map
+        std::size_t index = 0;
+        std::string key{};
+    };
+    value* result;
+    const msgpack_binary_reader* read_binary = nullptr;
+    std::vector<container> containers{};
+    std::vector<std::string> keys{};
+    bool reading_key = false;
+
+    value_visitor(value* r, const msgpack_binary_reader* rb) : result(r), read_binary(rb) {}
+
+    value* next()
+    {
+        if(reading_key)
+            MIGRAPHX_THROW("msgpack map keys must be strings");
+        if(containers.empty())
+            return result;
+        auto& c = containers.back();
+        if(c.is_map)
+            return c.v->insert(value(c.key, nullptr)).first;
+        return &(*c.v)[c.index++];
+    }
+
+    template <class T>
+    bool set(T x)
+    {
+        *next() = std::move(x);
+        return true;
+    }
+
+    bool visit_nil() { return set(nullptr); }
+    bool visit_boolean(bool b) { return set(b); }
+    bool visit_positive_integer(std::uint64_t x) { return set(x); }
+    bool visit_negative_integer(std::int64_t x) { return set(x); }
+    bool visit_float32(float x) { return set(double(x)); }
+    bool visit_float64(double x) { return set(x); }
+    bool visit_str(const char* s, std::uint32_t n)
+    {
+        if(not reading_key)
+            return set(std::string(s, n));
+        if(n == 0)
+            MIGRAPHX_THROW("msgpack map keys must not be empty");
+        containers.back().key = std::string(s, n);
+        return true;
+    }
+    bool visit_bin(const char* b, std::uint32_t n)
+    {
+        if(read_binary == nullptr)
+            return set(value::binary{b, n});
+        keys.clear();
+        std::transform(containers.begin(),
+                       containers.end(),
+                       std::back_inserter(keys),
+                       [](const container& c) { return c.key; });
+        *next() = (*read_binary)(keys, b, n);
+        return true;
+    }
+    bool visit_ext(const char*, std::uint32_t)
+    {
+        MIGRAPHX_THROW("msgpack EXT type not supported.");
+    }
+
+    bool start_array(std::uint32_t n)
+    {
+        auto* v = next();
+        *v      = value(std::vector<value>(n));
+        containers.push_back({v, false});
+        return true;
+    }
+    bool start_map(std::uint32_t)
+    {
+        auto* v = next();
+        *v      = value::object{};
+        containers.push_back({v, true});
+        return true;
+    }
+    bool end_array()
+    {
+        containers.pop_back();
+        return true;
+    }
+    bool end_map()
+    {
+        containers.pop_back();
+        return true;
+    }
+    bool start_map_key()
+    {
+        reading_key = true;
+        return true;
+    }
+    bool end_map_key()
+    {
+        reading_key = false;
+        return true;
+    }
+
+    void parse_error(std::size_t, std::size_t error_offset)
+    {
+        MIGRAPHX_THROW("Invalid msgpack at offset " + std::to_string(error_offset));
+    }
+    void insufficient_bytes(std::size_t, std::size_t)
+    {
+        MIGRAPHX_THROW("msgpack buffer ends before the value is complete");
+    }
+};
+
+value from_msgpack(const char* buffer, std::size_t size, const msgpack_binary_reader& read_binary)
+{
+    value result;
+    value_visitor visitor{&result, read_binary ? &read_binary : nullptr};
+    std::size_t offset = 0;
+    msgpack::v2::parse(buffer, size, offset, visitor);
+    return result;
+}
 value from_msgpack(const char* buffer, std::size_t size)
 {
-    msgpack::object_handle oh = msgpack::unpack(buffer, size);
-    return oh.get().as<value>();
+    return from_msgpack(buffer, size, nullptr);
 }
 value from_msgpack(const std::vector<char>& buffer)
 {
@@ -7,14 +7,19 @@
 #include <migraphx/ranges.hpp>
 #include <migraphx/time.hpp>
 #include <migraphx/iterator_for.hpp>
+#include <migraphx/par_for.hpp>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <utility>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_PARALLEL_COMPILE)
+
 void validate_pass(module& mod, const pass& p, tracer trace)
 {
     (void)mod;
@@ -55,14 +60,62 @@ void run_passes(module& mod, const std::vector<pass>& passes, tracer trace)
     }
 }
 
+// Group the modules so that every module comes after all of the modules it references. The
+// modules in the same group do not depend on each other.
+static std::vector<std::vector<module*>> module_levels(const std::vector<module*>& mods)
+{
+    std::unordered_map<module*, std::unordered_set<module*>> deps;
+    for(auto* mod : mods)
+    {
+        auto& d = deps[mod];
+        for(auto ins : iterator_for(*mod))
+            d.insert(ins->module_inputs().begin(), ins->module_inputs().end());
+    }
+    std::vector<std::vector<module*>> result;
+    std::unordered_set<module*> done;
+    auto remaining = mods;
+    while(not remaining.empty())
+    {
+        std::vector<module*> level;
+        std::copy_if(remaining.begin(), remaining.end(), std::back_inserter(level), [&](auto* mod) {
+            return std::all_of(deps[mod].begin(), deps[mod].end(), [&](auto* dep) {
+                return contains(done, dep) or not contains(deps, dep);
+            });
+        });
+        // Cyclic references between modules, so fallback to running them serially
+        if(level.empty())
+            level = {remaining.back()};
+        done.insert(level.begin(), level.end());
+        remaining.erase(std::remove_if(remaining.begin(),
+                                       remaining.end(),
+                                       [&](auto* mod) { return contains(done, mod); }),
+                        remaining.end());
+        result.push_back(level);
+    }
+    return result;
+}
+
 void run_passes(program& prog, const std::vector<pass>& passes, tracer trace)
 {
+    // Tracing from several threads would interleave the output
+    const bool parallel = enabled(MIGRAPHX_PARALLEL_COMPILE{}) and not trace.enabled();
     for(const auto& p : passes)
     {
         auto mods = prog.get_modules();
-        for(const auto& mod : reverse(mods))
+        if(parallel and mods.size() > 1)
+        {
+            for(const auto& level : module_levels(mods))
+            {
+                par_for_rethrow(
+                    level.size(), 1, [&](auto i) { run_pass(*level[i], p, trace); });
+            }
+        }
+        else
         {
-            run_pass(*mod, p, trace);
+            for(const auto& mod : reverse(mods))
+            {
+                run_pass(*mod, p, trace);
+            }
         }
         run_pass(prog, p, trace);
     }
@@ -0,0 +1,144 @@
+#include <migraphx/perf_counters.hpp>
+#include <migraphx/filesystem.hpp>
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+const std::size_t cache_line_size = 64;
+
+double perf_counter_values::ipc() const
+{
+    if(cycles == 0)
+        return 0;
+    return double(instructions) / cycles;
+}
+
+double perf_counter_values::llc_bytes() const { return double(llc_misses) * cache_line_size; }
+
+perf_counter_values& perf_counter_values::operator+=(const perf_counter_values& x)
+{
+    cycles += x.cycles;
+    instructions += x.instructions;
+    llc_misses += x.llc_misses;
+    std::transform(available.begin(),
+                   available.end(),
+                   x.available.begin(),
+                   available.begin(),
+                   [](bool a, bool b) { return a or b; });
+    return *this;
+}
+
+void perf_counter_values::print(std::ostream& os, std::size_t n, double ms) const
+{
+    if(n == 0)
+        return;
+    if(available[int(perf_event::cycles)])
+        os << ", " << cycles / n << " cycles";
+    if(available[int(perf_event::cycles)] and available[int(perf_event::instructions)])
+        os << ", " << ipc() << " IPC";
+    if(available[int(perf_event::llc_misses)])
+    {
+        os << ", " << llc_misses / n << " LLC misses";
+        if(ms > 0)
+            os << ", " << llc_bytes() / n / (ms * 1.0e6) << "GB/s";
+    }
+}
+
+static int open_event(std::uint64_t config, pid_t tid)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = config;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0);
+}
+
+static std::vector<pid_t> get_threads()
+{
+    std::vector<pid_t> result;
+    std::error_code ec;
+    for(auto&& entry : fs::directory_iterator{"/proc/self/task", ec})
+        result.push_back(std::stoi(entry.path().filename().string()));
+    if(result.empty())
+        result.push_back(0);
+    return result;
+}
+
+perf_counters::perf_counters()
+{
+    const std::vector<std::uint64_t> configs = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    auto threads = get_threads();
+    for(auto config : configs)
+    {
+        std::vector<int> event_fds;
+        for(auto tid : threads)
+        {
+            auto fd = open_event(config, tid);
+            if(fd >= 0)
+                event_fds.push_back(fd);
+        }
+        fds.push_back(event_fds);
+    }
+}
+
+perf_counters::~perf_counters()
+{
+    for(auto&& event_fds : fds)
+        for(auto fd : event_fds)
+            close(fd);
+}
+
+bool perf_counters::available() const
+{
+    return std::any_of(fds.begin(), fds.end(), [](auto&& event_fds) {
+        return not event_fds.empty();
+    });
+}
+
+void perf_counters::start()
+{
+    for(auto&& event_fds : fds)
+    {
+        for(auto fd : event_fds)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+perf_counter_values perf_counters::stop()
+{
+    for(auto&& event_fds : fds)
+        for(auto fd : event_fds)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    perf_counter_values result;
+    std::vector<std::uint64_t*> values = {
+        &result.cycles, &result.instructions, &result.llc_misses};
+    for(std::size_t i = 0; i < fds.size(); i++)
+    {
+        result.available[i] = not fds[i].empty();
+        for(auto fd : fds[i])
+        {
+            std::uint64_t value = 0;
+            if(read(fd, &value, sizeof(value)) == sizeof(value))
+                *values[i] += value;
+        }
+    }
+    return result;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -13,6 +13,7 @@
 #include <migraphx/algorithm.hpp>
 #include <migraphx/output_iterator.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/perf_counters.hpp>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -34,8 +35,106 @@ struct program_impl
     std::unordered_map<std::string, module> modules;
     context ctx;
     std::string target_name;
+    bool offload_copy = false;
+    // The instructions of the main module needed by each of its outputs
+    std::vector<std::vector<bool>> output_live;
+    // The structure of the main module when output_live was computed
+    std::vector<std::size_t> output_live_structure;
+
+    void update_output_live(const module& m);
 };
 
+// Mark ins and the instructions it depends on, including the ones used from inside of its
+// submodules
+static void mark_live(const std::unordered_map<instruction_ref, std::size_t>& index,
+                      std::vector<bool>& live,
+                      instruction_ref start)
+{
+    std::vector<instruction_ref> stack = {start};
+    while(not stack.empty())
+    {
+        auto ins = stack.back();
+        stack.pop_back();
+        auto i = index.at(ins);
+        if(live[i])
+            continue;
+        live[i] = true;
+        stack.insert(stack.end(), ins->inputs().begin(), ins->inputs().end());
+        for(auto smod : ins->module_inputs())
+        {
+            auto mods = smod->get_sub_modules();
+            mods.push_back(smod);
+            for(auto* mod : mods)
+            {
+                for(auto sins : iterator_for(*mod))
+                {
+                    std::copy_if(sins->inputs().begin(),
+                                 sins->inputs().end(),
+                                 std::back_inserter(stack),
+                                 [&](auto input) { return contains(index, input); });
+                }
+            }
+        }
+    }
+}
+
+// Each instruction is described by the number of its inputs followed by their positions in the
+// module, so no instruction_ref is kept that could be erased before it is compared
+static std::vector<std::size_t> module_structure(const module& m)
+{
+    std::unordered_map<const instruction*, std::size_t> index;
+    std::vector<std::size_t> result;
+    for(auto ins : iterator_for(m))
+    {
+        index.emplace(std::addressof(*ins), index.size());
+        result.push_back(ins->inputs().size());
+        std::transform(ins->inputs().begin(),
+                       ins->inputs().end(),
+                       std::back_inserter(result),
+                       [&](auto input) {
+                           auto it = index.find(std::addressof(*input));
+                           return it == index.end() ? m.size() : it->second;
+                       });
+    }
+    return result;
+}
+
+static std::vector<std::vector<bool>> compute_output_live(const module& m)
+{
+    if(m.begin() == m.end())
+        return {};
+    std::unordered_map<instruction_ref, std::size_t> index;
+    for(auto ins : iterator_for(m))
+        index.emplace(ins, index.size());
+    auto last = std::prev(m.end());
+    std::vector<instruction_ref> outputs = {last};
+    if(last->name() == "@return")
+        outputs = last->inputs();
+
+    // Operators that nothing uses are only kept for their side effects, so they always run
+    std::vector<bool> side_effects(index.size(), false);
+    for(auto ins : iterator_for(m))
+    {
+        if(ins != last and ins->outputs().empty() and ins->name().front() != '@')
+            mark_live(index, side_effects, ins);
+    }
+    std::vector<std::vector<bool>> result;
+    for(auto output : outputs)
+    {
+        auto live = side_effects;
+        mark_live(index, live, output);
+        live[index.at(last)] = true;
+        result.push_back(live);
+    }
+    return result;
+}
+
+void program_impl::update_output_live(const module& m)
+{
+    output_live           = compute_output_live(m);
+    output_live_structure = module_structure(m);
+}
+
 program::program() : impl(std::make_unique<program_impl>()) { this->create_module("main"); }
 
 program::program(program&&) noexcept = default;
@@ -62,9 +161,10 @@ void program::assign(const program& p)
         impl->modules.clear();
     }
 
-    impl->ctx         = p.impl->ctx;
-    impl->target_name = p.impl->target_name;
-    impl->modules     = p.impl->modules;
+    impl->ctx          = p.impl->ctx;
+    impl->target_name  = p.impl->target_name;
+    impl->offload_copy = p.impl->offload_copy;
+    impl->modules      = p.impl->modules;
 
     // build a map from old ins to new ins
     // Build a map from old module to new module
@@ -93,6 +193,8 @@ void program::assign(const program& p)
         for(auto ins : iterator_for(mp.second))
             instruction::replace_refs(ins, ins_map, mod_map);
     }
+    if(not p.impl->output_live.empty())
+        impl->update_output_live(*this->get_main_module());
 }
 
 shape program::get_parameter_shape(std::string name) const
@@ -137,11 +239,16 @@ instruction_ref program::validate() const
 
 bool program::is_compiled() const { return not this->impl->target_name.empty(); }
 
+std::string program::get_target_name() const { return this->impl->target_name; }
+
+bool program::is_offload_copy() const { return this->impl->offload_copy; }
+
 void program::compile(const target& t, compile_options options)
 {
     assert(not this->is_compiled());
-    this->impl->target_name = t.name();
-    this->impl->ctx         = t.get_context();
+    this->impl->target_name  = t.name();
+    this->impl->offload_copy = options.offload_copy;
+    this->impl->ctx          = t.get_context();
     if(enabled(MIGRAPHX_TRACE_COMPILE{}))
         options.trace = tracer{std::cout};
 
@@ -171,27 +278,40 @@ void program::compile(const target& t, compile_options options)
         }
         mod->finalize(this->impl->ctx);
     }
+    this->impl->update_output_live(*this->get_main_module());
 }
 
 void program::finalize()
 {
     auto* mm = this->get_main_module();
     mm->finalize(this->impl->ctx);
+    this->impl->update_output_live(*mm);
 }
 
+// The outputs to return and the instructions to run when only some of the outputs are needed
+struct output_selection
+{
+    std::vector<std::size_t> outputs;
+    std::vector<bool> live;
+};
+
 template <class F>
 std::vector<argument> generic_eval(const module* mod,
                                    context& ctx,
                                    std::unordered_map<std::string, argument> params,
                                    std::unordered_map<instruction_ref, argument> results,
-                                   F trace)
+                                   F trace,
+                                   const output_selection* selection = nullptr)
 {
     assert(mod->validate() == mod->end());
     results.reserve(mod->size() * 2);
     std::vector<argument> values;
     values.reserve(16);
+    std::size_t i = 0;
     for(auto ins : iterator_for(*mod))
     {
+        if(selection != nullptr and not selection->live[i++])
+            continue;
         const auto& name = ins->name();
         if(name == "@literal")
         {
@@ -218,6 +338,17 @@ std::vector<argument> generic_eval(const module* mod,
         else if(name == "@return")
         {
             std::vector<argument> prog_outputs;
+            if(selection != nullptr)
+            {
+                std::transform(selection->outputs.begin(),
+                               selection->outputs.end(),
+                               std::back_inserter(prog_outputs),
+                               [&](std::size_t output) {
+                                   assert(results.find(ins->inputs()[output]) != results.end());
+                                   return results[ins->inputs()[output]];
+                               });
+                return prog_outputs;
+            }
             std::transform(ins->inputs().begin(),
                            ins->inputs().end(),
                            std::back_inserter(prog_outputs),
@@ -250,22 +381,30 @@ std::vector<argument> generic_eval(const module* mod,
         }
         assert(results.find(ins) != results.end());
     }
-    return {results.at(std::prev(mod->end()))};
+    if(selection == nullptr)
+        return {results.at(std::prev(mod->end()))};
+    // Without a return the last instruction is the only output, and it is skipped when no
+    // outputs are selected
+    if(selection->outputs.empty())
+        return {};
+    return std::vector<argument>(selection->outputs.size(), results.at(std::prev(mod->end())));
 }
 
 template <class F>
 std::vector<argument> generic_eval(const program& p,
                                    context& ctx,
                                    std::unordered_map<std::string, argument> params,
-                                   F trace)
+                                   F trace,
+                                   const output_selection* selection = nullptr)
 {
     const module* mm = p.get_main_module();
-    return generic_eval(mm, ctx, params, {}, trace);
+    return generic_eval(mm, ctx, params, {}, trace, selection);
 }
 
-std::vector<argument> program::eval(parameter_map params) const
+static std::vector<argument>
+eval_program(const program& p, parameter_map params, const output_selection* selection)
 {
-    auto& ctx = this->impl->ctx;
+    auto& ctx = p.get_context();
 #ifndef NDEBUG
     auto sctx          = ctx;
     auto check_context = [&](auto f) {
@@ -282,28 +421,72 @@ std::vector<argument> program::eval(parameter_map params) const
 
     if(trace_level > 0)
     {
-        return generic_eval(*this, ctx, std::move(params), [&](auto& ins, auto f) {
-            ctx.finish();
-            std::cout << "Run instruction: ";
-            this->debug_print(ins);
-            timer t{};
-            auto result = check_context(f);
-            double t1   = t.record<milliseconds>();
-            ctx.finish();
-            double t2 = t.record<milliseconds>();
-            std::cout << "Time: " << t1 << "ms, " << t2 << "ms" << std::endl;
-            if(trace_level > 1 and ins->name().front() != '@' and ins->name() != "load")
-                std::cout << "Output: " << result << std::endl;
-            return result;
-        });
+        return generic_eval(
+            p,
+            ctx,
+            std::move(params),
+            [&](auto& ins, auto f) {
+                ctx.finish();
+                std::cout << "Run instruction: ";
+                p.debug_print(ins);
+                timer t{};
+                auto result = check_context(f);
+                double t1   = t.record<milliseconds>();
+                ctx.finish();
+                double t2 = t.record<milliseconds>();
+                std::cout << "Time: " << t1 << "ms, " << t2 << "ms" << std::endl;
+                if(trace_level > 1 and ins->name().front() != '@' and ins->name() != "load")
+                    std::cout << "Output: " << result << std::endl;
+                return result;
+            },
+            selection);
     }
     else
     {
         return generic_eval(
-            *this, ctx, std::move(params), [&](auto&, auto f) { return check_context(f); });
+            p,
+            ctx,
+            std::move(params),
+            [&](auto&, auto f) { return check_context(f); },
+            selection);
     }
 }
 
+std::vector<argument> program::eval(parameter_map params) const
+{
+    return eval_program(*this, std::move(params), nullptr);
+}
+
+std::vector<argument> program::eval(parameter_map params,
+                                    const std::vector<std::size_t>& outputs) const
+{
+    const auto* mm = this->get_main_module();
+    // The module was changed after it was compiled, such as an instruction that was replaced or
+    // an input that was moved to another instruction
+    std::vector<std::vector<bool>> changed_live;
+    const auto* live = &this->impl->output_live;
+    if(live->empty() or module_structure(*mm) != this->impl->output_live_structure)
+    {
+        changed_live = compute_output_live(*mm);
+        live         = &changed_live;
+    }
+    output_selection selection;
+    selection.outputs = outputs;
+    selection.live.resize(mm->size(), false);
+    for(auto output : outputs)
+    {
+        if(output >= live->size())
+            MIGRAPHX_THROW("Output " + std::to_string(output) + " is out of range, program has " +
+                           std::to_string(live->size()) + " outputs");
+        std::transform((*live)[output].begin(),
+                       (*live)[output].end(),
+                       selection.live.begin(),
+                       selection.live.begin(),
+                       [](bool x, bool y) { return x or y; });
+    }
+    return eval_program(*this, std::move(params), &selection);
+}
+
 const int program_file_version = 5;
 
 value program::to_value() const
@@ -312,7 +495,10 @@ value program::to_value() const
     result["version"] = program_file_version;
     result["target"]  = this->impl->target_name;
     if(not this->impl->target_name.empty())
-        result["context"] = this->impl->ctx.to_value();
+    {
+        result["context"]      = this->impl->ctx.to_value();
+        result["offload_copy"] = this->impl->offload_copy;
+    }
 
     value module_vals = value::object{};
     std::unordered_map<instruction_ref, std::string> names;
@@ -367,7 +553,8 @@ value program::to_value() const
 static void mod_from_val(module_ref mod,
                          const value& v,
                          std::unordered_map<std::string, instruction_ref>& instructions,
-                         const std::unordered_map<std::string, module_ref>& map_mods)
+                         const std::unordered_map<std::string, module_ref>& map_mods,
+                         const std::function<literal(const value&)>& read_literal)
 {
     const auto& module_val = v.at(mod->name());
     for(const value& node : module_val.at("nodes"))
@@ -384,7 +571,7 @@ static void mod_from_val(module_ref mod,
         }
         else if(name == "@literal")
         {
-            output = mod->add_literal(migraphx::from_value<literal>(node.at("literal")));
+            output = mod->add_literal(read_literal(node.at("literal")));
         }
         else
         {
@@ -409,7 +596,7 @@ static void mod_from_val(module_ref mod,
 
                 for(auto& smod : module_inputs)
                 {
-                    mod_from_val(smod, v, instructions, map_mods);
+                    mod_from_val(smod, v, instructions, map_mods, read_literal);
                 }
             }
 
@@ -432,6 +619,11 @@ static void mod_from_val(module_ref mod,
 }
 
 void program::from_value(const value& v)
+{
+    from_value(v, [](const value& l) { return migraphx::from_value<literal>(l); });
+}
+
+void program::from_value(const value& v, const std::function<literal(const value&)>& read_literal)
 {
     auto version = v.at("version").to<int>();
     if(version != program_file_version)
@@ -445,9 +637,12 @@ void program::from_value(const value& v)
         target t        = make_target(this->impl->target_name);
         this->impl->ctx = t.get_context();
         this->impl->ctx.from_value(v.at("context"));
+        // Programs saved before offload_copy was recorded don't have it
+        if(v.contains("offload_copy"))
+            this->impl->offload_copy = v.at("offload_copy").to<bool>();
     }
 
-    auto module_vals = v.at("modules");
+    const auto& module_vals = v.at("modules");
     for(const auto& vv : module_vals)
     {
         const auto& name = vv.get_key();
@@ -463,7 +658,7 @@ void program::from_value(const value& v)
 
     std::unordered_map<std::string, instruction_ref> map_insts;
     auto* mm = get_main_module();
-    mod_from_val(mm, module_vals, map_insts, map_mods);
+    mod_from_val(mm, module_vals, map_insts, map_mods, read_literal);
 
     this->finalize();
 }
@@ -483,7 +678,10 @@ std::string perf_group(const operation& op)
     return op.name();
 }
 
-void program::perf_report(std::ostream& os, std::size_t n, parameter_map params) const
+void program::perf_report(std::ostream& os,
+                          std::size_t n,
+                          parameter_map params,
+                          bool counters) const
 {
     auto& ctx = this->impl->ctx;
     // Run once by itself
@@ -520,6 +718,24 @@ void program::perf_report(std::ostream& os, std::size_t n, parameter_map params)
     }
     for(auto&& p : ins_vec)
         std::sort(p.second.begin(), p.second.end());
+    // Collect hardware counters in separate runs so they don't affect the timings
+    std::unique_ptr<perf_counters> pc;
+    std::unordered_map<instruction_ref, perf_counter_values> ins_counters;
+    if(counters)
+        pc = std::make_unique<perf_counters>();
+    if(pc != nullptr and pc->available())
+    {
+        for(std::size_t i = 0; i < n; i++)
+        {
+            generic_eval(*this, ctx, params, [&](auto ins, auto f) {
+                pc->start();
+                auto result = f();
+                ctx.finish();
+                ins_counters[ins] += pc->stop();
+                return result;
+            });
+        }
+    }
     // Run and time implicit overhead
     std::vector<double> overhead_vec;
     overhead_vec.reserve(n);
@@ -534,11 +750,14 @@ void program::perf_report(std::ostream& os, std::size_t n, parameter_map params)
     double overhead_percent       = overhead_time * 100.0 / total_time;
     double total_instruction_time = 0.0;
     std::unordered_map<std::string, double> op_times;
+    std::unordered_map<std::string, perf_counter_values> op_counters;
     for(auto&& p : ins_vec)
     {
         double avg = common_average(p.second);
         op_times[perf_group(p.first->get_operator())] += avg;
         total_instruction_time += avg;
+        if(contains(ins_counters, p.first))
+            op_counters[perf_group(p.first->get_operator())] += ins_counters[p.first];
     }
     double calculate_overhead_time    = total_time - total_instruction_time;
     double calculate_overhead_percent = calculate_overhead_time * 100.0 / total_time;
@@ -554,6 +773,8 @@ void program::perf_report(std::ostream& os, std::size_t n, parameter_map params)
         double avg     = common_average(ins_vec[ins]);
         double percent = std::ceil(100.0 * avg / total_instruction_time);
         os << ": " << avg << "ms, " << percent << "%";
+        if(contains(ins_counters, ins))
+            ins_counters[ins].print(os, n, avg);
         os << std::endl;
     });
 
@@ -570,11 +791,17 @@ void program::perf_report(std::ostream& os, std::size_t n, parameter_map params)
         auto&& name    = p.second;
         double avg     = p.first;
         double percent = std::ceil(100.0 * avg / total_instruction_time);
-        os << name << ": " << avg << "ms, " << percent << "%" << std::endl;
+        os << name << ": " << avg << "ms, " << percent << "%";
+        if(contains(op_counters, name))
+            op_counters[name].print(os, n, avg);
+        os << std::endl;
     }
 
     os << std::endl;
 
+    if(pc != nullptr and not pc->available())
+        os << "Hardware counters are not available" << std::endl;
+
     os << "Rate: " << rate << "/sec" << std::endl;
     os << "Total time: " << total_time << "ms" << std::endl;
     os << "Total instructions time: " << total_instruction_time << "ms" << std::endl;
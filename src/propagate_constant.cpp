@@ -2,12 +2,94 @@
 #include <migraphx/program.hpp>
 #include <migraphx/matcher.hpp>
 #include <migraphx/literal.hpp>
+#include <migraphx/literal_store.hpp>
 #include <migraphx/functional.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <sstream>
 #include <unordered_set>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+constant_fold_cache::constant_fold_cache(std::size_t max_bytes) : capacity(max_bytes) {}
+
+literal constant_fold_cache::find(const std::string& key, const std::vector<literal>& inputs) const
+{
+    std::lock_guard<std::mutex> lock(m);
+    auto it = entries.find(key);
+    if(it == entries.end() or it->second.inputs.size() != inputs.size())
+        return {};
+    if(not std::equal(inputs.begin(),
+                      inputs.end(),
+                      it->second.inputs.begin(),
+                      [](const auto& x, const auto& y) { return same_literal_data(x, y); }))
+        return {};
+    hit_count++;
+    recent.splice(recent.begin(), recent, it->second.position);
+    return it->second.result;
+}
+
+void constant_fold_cache::insert(const std::string& key,
+                                 std::vector<literal> inputs,
+                                 literal result)
+{
+    // Literals that share a buffer only hold on to it once
+    std::unordered_set<const char*> buffers;
+    std::size_t n = result.get_shape().bytes();
+    for(const auto& input : inputs)
+    {
+        if(buffers.insert(input.data()).second)
+            n += input.get_shape().bytes();
+    }
+    std::lock_guard<std::mutex> lock(m);
+    auto it = entries.find(key);
+    if(it != entries.end())
+        erase(it);
+    if(n > capacity)
+        return;
+    recent.push_front(key);
+    entries[key] = entry{std::move(inputs), std::move(result), n, recent.begin()};
+    total_bytes += n;
+    while(total_bytes > capacity)
+        erase(entries.find(recent.back()));
+}
+
+void constant_fold_cache::erase(std::unordered_map<std::string, entry>::iterator it)
+{
+    total_bytes -= it->second.bytes;
+    recent.erase(it->second.position);
+    entries.erase(it);
+}
+
+std::size_t constant_fold_cache::size() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    return entries.size();
+}
+
+std::size_t constant_fold_cache::bytes() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    return total_bytes;
+}
+
+std::size_t constant_fold_cache::hits() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    return hit_count;
+}
+
+void constant_fold_cache::clear()
+{
+    std::lock_guard<std::mutex> lock(m);
+    entries.clear();
+    recent.clear();
+    total_bytes = 0;
+    hit_count   = 0;
+}
+
 bool skip_propogate(instruction_ref ins)
 {
     if(ins->name() == "contiguous")
@@ -20,35 +102,214 @@ bool skip_propogate(instruction_ref ins)
     return false;
 }
 
-void propagate_constant::apply(module& p) const
+static std::vector<instruction_ref> unique_inputs(instruction_ref ins)
+{
+    std::vector<instruction_ref> result;
+    for(auto input : ins->inputs())
+    {
+        if(not contains(result, input))
+            result.push_back(input);
+    }
+    return result;
+}
+
+struct constant_folder
 {
-    for(auto i : iterator_for(p))
+    module* m;
+    constant_fold_cache* cache;
+    // Instructions computed only from literals, in topological order
+    std::vector<instruction_ref> foldable;
+    std::unordered_map<instruction_ref, std::size_t> levels;
+    std::unordered_map<instruction_ref, std::string> keys;
+
+    bool is_foldable(instruction_ref ins) const { return contains(levels, ins); }
+
+    void find_foldable()
+    {
+        for(auto ins : iterator_for(*m))
+        {
+            if(ins->name().front() == '@' or ins->inputs().empty() or
+               not is_context_free(ins->get_operator()) or
+               ins->get_operator().attributes().contains("no_constant_fold"))
+                continue;
+            std::size_t level = 0;
+            auto is_constant  = [&](auto i) {
+                if(i->name() == "@literal")
+                    return true;
+                if(not is_foldable(i))
+                    return false;
+                level = std::max(level, levels.at(i) + 1);
+                return true;
+            };
+            if(not std::all_of(ins->inputs().begin(), ins->inputs().end(), is_constant))
+                continue;
+            levels[ins] = level;
+            foldable.push_back(ins);
+        }
+    }
+
+    // The results used by the rest of the module. Instructions that are skipped stay in the
+    // module, so their inputs are needed instead.
+    std::vector<instruction_ref> find_roots() const
+    {
+        std::unordered_set<instruction_ref> needed;
+        for(auto it = foldable.rbegin(); it != foldable.rend(); ++it)
+        {
+            auto ins = *it;
+            if(ins->outputs().empty() or
+               std::any_of(ins->outputs().begin(), ins->outputs().end(), [&](auto output) {
+                   return not is_foldable(output) or
+                          (skip_propogate(output) and contains(needed, output));
+               }))
+                needed.insert(ins);
+        }
+        std::vector<instruction_ref> roots;
+        std::copy_if(foldable.begin(), foldable.end(), std::back_inserter(roots), [&](auto ins) {
+            return contains(needed, ins) and not skip_propogate(ins);
+        });
+        return roots;
+    }
+
+    const std::string& key(instruction_ref ins)
+    {
+        auto it = keys.find(ins);
+        if(it != keys.end())
+            return it->second;
+        std::stringstream ss;
+        if(ins->name() == "@literal")
+        {
+            ss << "@literal:" << hash_literal(ins->get_literal());
+        }
+        else
+        {
+            ss << ins->get_operator() << "(";
+            for(auto input : ins->inputs())
+                ss << key(input) << ",";
+            ss << ")";
+        }
+        return keys[ins] = ss.str();
+    }
+
+    static std::vector<literal> leaves(instruction_ref root)
     {
-        if(i->name() != "@literal")
-            continue;
-        if(i->outputs().empty())
-            continue;
+        std::vector<literal> result;
+        std::unordered_set<instruction_ref> visited;
         fix([&](auto self, auto ins) {
-            std::unordered_set<instruction_ref> children(ins->outputs().begin(),
-                                                         ins->outputs().end());
-            for(auto child : children)
+            if(not visited.insert(ins).second)
+                return;
+            if(ins->name() == "@literal")
             {
-                if(child->name() == "@literal" or skip_propogate(child))
+                result.push_back(ins->get_literal());
+                return;
+            }
+            for(auto input : ins->inputs())
+                self(input);
+        })(root);
+        return result;
+    }
+
+    // Evaluate the instructions the roots depend on, a level at a time
+    std::unordered_map<instruction_ref, argument>
+    evaluate(const std::vector<instruction_ref>& roots) const
+    {
+        std::unordered_set<instruction_ref> required;
+        std::unordered_set<instruction_ref> root_set(roots.begin(), roots.end());
+        for(auto root : roots)
+        {
+            fix([&](auto self, auto ins) {
+                if(not is_foldable(ins) or not required.insert(ins).second)
+                    return;
+                for(auto input : ins->inputs())
+                    self(input);
+            })(root);
+        }
+        std::vector<std::vector<instruction_ref>> schedule;
+        // Number of required instructions still to use each result
+        std::unordered_map<instruction_ref, std::size_t> uses;
+        for(auto ins : foldable)
+        {
+            if(not contains(required, ins))
+                continue;
+            auto level = levels.at(ins);
+            if(level >= schedule.size())
+                schedule.resize(level + 1);
+            schedule[level].push_back(ins);
+            for(auto input : unique_inputs(ins))
+                uses[input]++;
+        }
+        std::unordered_map<instruction_ref, argument> results;
+        for(auto&& level : schedule)
+        {
+            std::vector<argument> level_results(level.size());
+            par_for_rethrow(level.size(), 1, [&](auto i) {
+                auto ins = level[i];
+                std::vector<argument> args;
+                for(auto input : ins->inputs())
                 {
-                    self(child);
-                    continue;
+                    if(input->name() == "@literal")
+                        args.push_back(input->get_literal().share_argument());
+                    else
+                        args.push_back(results.at(input));
+                    if(args.back().empty())
+                        return;
                 }
-                auto r = child->eval();
-                if(not r.empty())
+                level_results[i] = ins->normalized_operator().compute(ins->get_shape(), args);
+            });
+            for(std::size_t i = 0; i < level.size(); i++)
+            {
+                results[level[i]] = level_results[i];
+                // Release the intermediate results once they are no longer used
+                for(auto input : unique_inputs(level[i]))
                 {
-                    assert(r.get_shape() == child->get_shape());
-                    auto l = p.add_literal(r.get_shape(), r.data());
-                    self(p.replace_instruction(child, l));
+                    if(--uses[input] == 0 and not contains(root_set, input))
+                        results.erase(input);
                 }
             }
-        })(i);
+        }
+        return results;
     }
-}
+
+    void apply()
+    {
+        find_foldable();
+        auto roots = find_roots();
+        std::unordered_map<instruction_ref, literal> folded;
+        std::unordered_map<instruction_ref, std::vector<literal>> root_leaves;
+        if(cache != nullptr)
+        {
+            for(auto root : roots)
+            {
+                root_leaves[root] = leaves(root);
+                auto l            = cache->find(key(root), root_leaves[root]);
+                if(not l.empty())
+                    folded[root] = l;
+            }
+        }
+        std::vector<instruction_ref> missing;
+        std::copy_if(roots.begin(), roots.end(), std::back_inserter(missing), [&](auto root) {
+            return not contains(folded, root);
+        });
+        auto results = evaluate(missing);
+        for(auto root : missing)
+        {
+            auto r = results.at(root);
+            if(r.empty())
+                continue;
+            assert(r.get_shape() == root->get_shape());
+            folded[root] = literal{r};
+            if(cache != nullptr)
+                cache->insert(key(root), root_leaves[root], folded[root]);
+        }
+        for(auto root : roots)
+        {
+            if(not contains(folded, root))
+                continue;
+            m->replace_instruction(root, m->add_literal(folded[root]));
+        }
+    }
+};
+
+void propagate_constant::apply(module& p) const { constant_folder{&p, cache}.apply(); }
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -14,6 +14,12 @@
 #include <migraphx/register_target.hpp>
 #include <migraphx/json.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/dlpack.hpp>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #ifdef HAVE_GPU
 #include <migraphx/gpu/hip.hpp>
@@ -208,6 +214,158 @@ migraphx::shape to_shape(const py::buffer_info& info)
     }
 }
 
+// Capsules that are consumed are renamed to used_dltensor and are owned by the consumer
+void dlpack_capsule_deleter(PyObject* capsule)
+{
+    if(PyCapsule_IsValid(capsule, "used_dltensor"))
+        return;
+    auto* t = static_cast<migraphx::dlpack::managed_tensor*>(
+        PyCapsule_GetPointer(capsule, "dltensor"));
+    if(t == nullptr)
+    {
+        PyErr_Clear();
+        return;
+    }
+    if(t->deleter != nullptr)
+        t->deleter(t);
+}
+
+migraphx::argument argument_from_dlpack(const py::object& x)
+{
+    py::object capsule = x;
+    if(py::hasattr(x, "__dlpack__"))
+        capsule = x.attr("__dlpack__")();
+    auto* t = static_cast<migraphx::dlpack::managed_tensor*>(
+        PyCapsule_GetPointer(capsule.ptr(), "dltensor"));
+    if(t == nullptr)
+        throw py::error_already_set();
+    PyCapsule_SetName(capsule.ptr(), "used_dltensor");
+    return migraphx::from_dlpack(t);
+}
+
+// The arguments alias the memory of the python buffers, so the python objects have to be kept
+// alive for as long as the arguments are used
+migraphx::parameter_map to_parameter_map(const py::dict& params)
+{
+    migraphx::parameter_map pm;
+    for(auto x : params)
+    {
+        std::string key      = x.first.cast<std::string>();
+        py::buffer b         = x.second.cast<py::buffer>();
+        py::buffer_info info = b.request();
+        pm[key]              = migraphx::argument(to_shape(info), info.ptr);
+    }
+    return pm;
+}
+
+std::vector<migraphx::argument> to_output_arguments(const py::object& outputs)
+{
+    std::vector<migraphx::argument> result;
+    if(outputs.is_none())
+        return result;
+    for(auto x : outputs.cast<py::list>())
+    {
+        py::buffer b         = x.cast<py::buffer>();
+        py::buffer_info info = b.request(true);
+        result.emplace_back(to_shape(info), info.ptr);
+    }
+    return result;
+}
+
+// Copy the results into the memory provided by the caller, this doesn't need the GIL
+void copy_to_outputs(const std::vector<migraphx::argument>& results,
+                     const std::vector<migraphx::argument>& outputs)
+{
+    if(outputs.empty())
+        return;
+    if(outputs.size() != results.size())
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: Expected " + std::to_string(results.size()) +
+                       " outputs but got " + std::to_string(outputs.size()));
+    for(std::size_t i = 0; i < results.size(); i++)
+    {
+        if(outputs[i].get_shape().elements() != results[i].get_shape().elements())
+            MIGRAPHX_THROW("MIGRAPHX PYTHON: Output " + std::to_string(i) +
+                           " has the wrong number of elements");
+        migraphx::visit_all(outputs[i], results[i])([&](auto output, auto input) {
+            std::copy(input.begin(), input.end(), output.begin());
+        });
+    }
+}
+
+py::object run_result(const std::vector<migraphx::argument>& results, const py::object& outputs)
+{
+    if(outputs.is_none())
+        return py::cast(results);
+    return outputs;
+}
+
+// A program has a single context and scratch memory, so eval is not reentrant. Since the GIL is
+// released while a program runs, runs and compiles of the same program from several python
+// threads, or from run_async, are serialized by a mutex kept for each program. The mutex is
+// removed when the python object of the program is destroyed, and the map is only used with the
+// GIL held.
+std::mutex& program_mutex(const py::object& prog)
+{
+    static std::unordered_map<const migraphx::program*, std::unique_ptr<std::mutex>> mutexes;
+    const auto* p = &prog.cast<const migraphx::program&>();
+    auto& r       = mutexes[p];
+    if(r != nullptr)
+        return *r;
+    r          = std::make_unique<std::mutex>();
+    auto erase = py::cpp_function([p](py::handle ref) {
+        mutexes.erase(p);
+        ref.dec_ref();
+    });
+    // The weak reference calls back when the program is destroyed, and is leaked until then
+    py::weakref(prog, erase).release();
+    return *r;
+}
+
+// Result of program.run_async, the parameters, outputs and the program are held so they stay
+// alive until the evaluation is finished
+struct run_future
+{
+    py::object prog;
+    py::object params;
+    py::object outputs;
+    std::shared_future<std::vector<migraphx::argument>> result;
+
+    // Only moved, so the temporaries left behind don't wait for the evaluation
+    run_future(run_future&&) = default;
+    run_future& operator=(run_future&&) = default;
+
+    // The program and the arguments can't be released before the evaluation is finished, and
+    // other python threads can run while waiting for it
+    ~run_future()
+    {
+        if(not result.valid())
+            return;
+        py::gil_scoped_release nogil;
+        result.wait();
+    }
+
+    void wait() const
+    {
+        py::gil_scoped_release nogil;
+        result.wait();
+    }
+
+    bool done() const
+    {
+        return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    py::object get() const
+    {
+        std::vector<migraphx::argument> r;
+        {
+            py::gil_scoped_release nogil;
+            r = result.get();
+        }
+        return run_result(r, outputs);
+    }
+};
+
 MIGRAPHX_PYBIND11_MODULE(migraphx, m)
 {
     py::class_<migraphx::shape>(m, "shape")
@@ -235,6 +393,14 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
                  new(&x) migraphx::argument(to_shape(info), info.ptr);
              })
         .def("get_shape", &migraphx::argument::get_shape)
+        .def("__dlpack__",
+             [](const migraphx::argument& x, const py::args&, const py::kwargs&) {
+                 return py::capsule(migraphx::to_dlpack(x), "dltensor", &dlpack_capsule_deleter);
+             })
+        .def("__dlpack_device__",
+             [](const migraphx::argument&) {
+                 return py::make_tuple(static_cast<int>(migraphx::dlpack::cpu), 0);
+             })
         .def("tolist",
              [](migraphx::argument& x) {
                  py::list l{x.get_shape().elements()};
@@ -253,16 +419,28 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
         .def("__ne__", std::not_equal_to<migraphx::module>{})
         .def("__repr__", [](const migraphx::module& mm) { return migraphx::to_string(mm); });
 
+    py::class_<run_future>(m, "future")
+        .def("wait", &run_future::wait)
+        .def("done", &run_future::done)
+        .def("get", &run_future::get);
+
     py::class_<migraphx::program>(m, "program")
         .def("get_parameter_names", &migraphx::program::get_parameter_names)
         .def("get_parameter_shapes", &migraphx::program::get_parameter_shapes)
         .def("get_output_shapes", &migraphx::program::get_output_shapes)
         .def(
             "compile",
-            [](migraphx::program& p, const migraphx::target& t, bool offload_copy, bool fast_math) {
+            [](const py::object& self,
+               const migraphx::target& t,
+               bool offload_copy,
+               bool fast_math) {
+                auto& p = self.cast<migraphx::program&>();
                 migraphx::compile_options options;
                 options.offload_copy = offload_copy;
                 options.fast_math    = fast_math;
+                auto& mutex          = program_mutex(self);
+                py::gil_scoped_release nogil;
+                std::lock_guard<std::mutex> lock(mutex);
                 p.compile(t, options);
             },
             py::arg("t"),
@@ -273,18 +451,42 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
                  auto* mm = p.get_main_module();
                  return *mm;
              })
-        .def("run",
-             [](migraphx::program& p, py::dict params) {
-                 migraphx::parameter_map pm;
-                 for(auto x : params)
-                 {
-                     std::string key      = x.first.cast<std::string>();
-                     py::buffer b         = x.second.cast<py::buffer>();
-                     py::buffer_info info = b.request();
-                     pm[key]              = migraphx::argument(to_shape(info), info.ptr);
-                 }
-                 return p.eval(pm);
-             })
+        .def(
+            "run",
+            [](const py::object& self, const py::dict& params, const py::object& outputs) {
+                auto& p     = self.cast<migraphx::program&>();
+                auto pm     = to_parameter_map(params);
+                auto outs   = to_output_arguments(outputs);
+                auto& mutex = program_mutex(self);
+                std::vector<migraphx::argument> results;
+                {
+                    py::gil_scoped_release nogil;
+                    std::lock_guard<std::mutex> lock(mutex);
+                    results = p.eval(pm);
+                    copy_to_outputs(results, outs);
+                }
+                return run_result(results, outputs);
+            },
+            py::arg("params"),
+            py::arg("outputs") = py::none())
+        .def(
+            "run_async",
+            [](const py::object& self, const py::dict& params, const py::object& outputs) {
+                auto& p     = self.cast<migraphx::program&>();
+                auto pm     = to_parameter_map(params);
+                auto outs   = to_output_arguments(outputs);
+                auto& mutex = program_mutex(self);
+                run_future f{self, params, outputs, {}};
+                f.result = std::async(std::launch::async, [&p, &mutex, pm, outs] {
+                               std::lock_guard<std::mutex> lock(mutex);
+                               auto results = p.eval(pm);
+                               copy_to_outputs(results, outs);
+                               return results;
+                           }).share();
+                return f;
+            },
+            py::arg("params"),
+            py::arg("outputs") = py::none())
         .def("sort", &migraphx::program::sort)
         .def("print", [](const migraphx::program& p) { std::cout << p << std::endl; })
         .def("__eq__", std::equal_to<migraphx::program>{})
@@ -314,6 +516,7 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
                   migraphx::tf_options{is_nhwc, batch_size, map_input_dims, output_names});
           },
           "Parse tf protobuf (default format is nhwc)",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("filename"),
           py::arg("is_nhwc")        = true,
           py::arg("batch_size")     = 1,
@@ -334,6 +537,7 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
               return migraphx::parse_onnx(filename, options);
           },
           "Parse onnx file",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("filename"),
           py::arg("default_dim_value") = 1,
           py::arg("map_input_dims") = std::unordered_map<std::string, std::vector<std::size_t>>(),
@@ -354,6 +558,7 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
               return migraphx::parse_onnx_buffer(onnx_buffer, options);
           },
           "Parse onnx file",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("filename"),
           py::arg("default_dim_value") = 1,
           py::arg("map_input_dims") = std::unordered_map<std::string, std::vector<std::size_t>>(),
@@ -367,6 +572,7 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
               return migraphx::load(name, options);
           },
           "Load MIGraphX program",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("filename"),
           py::arg("format") = "msgpack");
 
@@ -377,11 +583,16 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
               return migraphx::save(p, name, options);
           },
           "Save MIGraphX program",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("p"),
           py::arg("filename"),
           py::arg("format") = "msgpack");
 
     m.def("get_target", &migraphx::make_target);
+    m.def("from_dlpack",
+          &argument_from_dlpack,
+          "Wrap a DLPack capsule or an object with __dlpack__ as an argument without copying",
+          py::arg("x"));
     m.def("generate_argument", &migraphx::generate_argument, py::arg("s"), py::arg("seed") = 0);
     m.def("quantize_fp16",
           &migraphx::quantize_fp16,
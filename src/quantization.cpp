@@ -12,9 +12,11 @@
 #include <migraphx/op/capture.hpp>
 #include <migraphx/op/convolution.hpp>
 #include <migraphx/op/quant_convolution.hpp>
+#include <migraphx/op/dequantize_dot.hpp>
 #include <migraphx/op/multibroadcast.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/ranges.hpp>
+#include <migraphx/par_for.hpp>
 #include <migraphx/target.hpp>
 #include <utility>
 #include <set>
@@ -25,6 +27,7 @@
 
 #include <fstream>
 #include <algorithm>
+#include <cmath>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -487,6 +490,137 @@ void quantize_int8(program& prog,
     quantize_int8_impl(prog, *int8_quant_params, ins_names);
 }
 
+// Quantize the last two dimensions of the weights w, which are [K, N], to the transposed
+// layout used by dequantize_dot. The scale of each group is chosen so its largest magnitude
+// maps to the largest quantized value.
+static std::pair<literal, literal>
+quantize_weight_values(const argument& w, const op::dequantize_dot& qop, float alpha)
+{
+    auto ws          = w.get_shape();
+    auto r           = ws.lens().size();
+    auto k           = ws.lens()[r - 2];
+    auto n           = ws.lens()[r - 1];
+    auto kstride     = ws.strides()[r - 2];
+    auto nstride     = ws.strides()[r - 1];
+    auto g           = qop.groups(k);
+    auto group_size  = qop.group_size == 0 ? k : qop.group_size;
+    const float qmax = qop.bits == 4 ? 7 : 127;
+    std::vector<float> scales(n * g);
+    std::vector<std::int8_t> values(n * k);
+    w.visit([&](auto v) {
+        const auto* p = v.data();
+        par_for(n, [&](auto i) {
+            for(std::size_t grp = 0; grp < g; grp++)
+            {
+                auto start = grp * group_size;
+                auto end   = std::min(k, start + group_size);
+                double mx  = 0;
+                for(auto j = start; j < end; j++)
+                    mx = std::max(mx, std::abs(double(p[j * kstride + i * nstride])));
+                auto scale = mx == 0 ? 1.0 : mx / qmax;
+                for(auto j = start; j < end; j++)
+                {
+                    auto x            = std::round(double(p[j * kstride + i * nstride]) / scale);
+                    values[i * k + j] = std::min<double>(std::max<double>(x, -qmax), qmax);
+                }
+                scales[i * g + grp] = scale * alpha;
+            }
+        });
+    });
+    literal scales_lit{shape{shape::float_type, {n, g}}, scales};
+    if(qop.bits == 8)
+        return {literal{shape{shape::int8_type, {n, k}}, values}, scales_lit};
+    auto kp = qop.packed_size(k);
+    std::vector<std::uint8_t> packed(n * kp);
+    for(std::size_t i = 0; i < n; i++)
+    {
+        for(std::size_t j = 0; j < k; j += 2)
+        {
+            auto hi                = (j + 1 < k) ? values[i * k + j + 1] : 0;
+            packed[i * kp + j / 2] = op::dequantize_dot::pack_int4(values[i * k + j], hi);
+        }
+    }
+    return {literal{shape{shape::uint8_type, {n, kp}}, packed}, scales_lit};
+}
+
+// Store the weights as half values in the transposed layout used by dequantize_dot, so they
+// only need a scale for alpha
+static std::pair<literal, literal> half_weight_values(const argument& w, float alpha)
+{
+    auto ws      = w.get_shape();
+    auto r       = ws.lens().size();
+    auto k       = ws.lens()[r - 2];
+    auto n       = ws.lens()[r - 1];
+    auto kstride = ws.strides()[r - 2];
+    auto nstride = ws.strides()[r - 1];
+    std::vector<half> values(n * k);
+    w.visit([&](auto v) {
+        const auto* p = v.data();
+        par_for(n, [&](auto i) {
+            for(std::size_t j = 0; j < k; j++)
+                values[i * k + j] = half(float(p[j * kstride + i * nstride]));
+        });
+    });
+    return {literal{shape{shape::half_type, {n, k}}, values},
+            literal{shape{shape::float_type, {n, 1}}, std::vector<float>(n, alpha)}};
+}
+
+argument constant_dot_weights(instruction_ref ins)
+{
+    if(ins->name() != "dot" or ins->inputs().size() != 2)
+    {
+        return {};
+    }
+    auto a = ins->inputs()[0];
+    auto b = ins->inputs()[1];
+    if(not contains({shape::float_type, shape::half_type, shape::double_type},
+                    a->get_shape().type()) or
+       not b->can_eval())
+    {
+        return {};
+    }
+    // the weights must be the same for every batch, such as when they are broadcasted
+    const auto& lens    = b->get_shape().lens();
+    const auto& strides = b->get_shape().strides();
+    if(not std::equal(lens.begin(), lens.end() - 2, strides.begin(), [](auto len, auto stride) {
+           return len == 1 or stride == 0;
+       }))
+    {
+        return {};
+    }
+    return b->eval();
+}
+
+void quantize_weights(program& prog, std::size_t bits, std::size_t group_size)
+{
+    if(bits != 16 and bits != 8 and bits != 4)
+    {
+        MIGRAPHX_THROW("QUANTIZE_WEIGHTS: only 16, 8 and 4 bit weights are supported");
+    }
+    // Half weights are not scaled, so they only use a single group
+    op::dequantize_dot qop{bits, bits == 16 ? 0 : group_size};
+    auto* mm = prog.get_main_module();
+    for(auto ins : iterator_for(*mm))
+    {
+        auto w = constant_dot_weights(ins);
+        if(w.empty())
+        {
+            continue;
+        }
+        auto a     = ins->inputs()[0];
+        auto alpha = ins->get_operator().to_value()["alpha"].to<float>();
+        auto q     = bits == 16 ? half_weight_values(w, alpha)
+                                : quantize_weight_values(w, qop, alpha);
+        if(not a->get_shape().standard())
+        {
+            a = mm->insert_instruction(ins, make_op("contiguous"), a);
+        }
+        auto weights = mm->add_literal(q.first);
+        auto scales  = mm->add_literal(q.second);
+        mm->replace_instruction(ins, qop, a, weights, scales);
+    }
+}
+
 // For the input of each input argument, we need to insert a
 // capture operator to compute the scale and shift
 std::size_t capture_arguments(program& prog,
@@ -0,0 +1,85 @@
+#include <migraphx/rewrite_resize.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/resize.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/program.hpp>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The resize is computed as the sum of n gathers, one for each combination of the taps in each
+// dimension, which are multiplied by their weights. Nearest resizes only need a single gather.
+static void apply_resize(module& m, instruction_ref ins)
+{
+    auto op               = any_cast<op::resize>(ins->get_operator());
+    auto input            = ins->inputs().front();
+    const auto& in_lens   = input->get_shape().lens();
+    const auto& out_shape = ins->get_shape();
+    auto taps             = op.compute_taps(in_lens);
+    std::size_t n         = std::accumulate(taps.begin(),
+                                    taps.end(),
+                                    std::size_t{1},
+                                    [](auto x, const auto& t) { return x * t.count; });
+    auto elements = out_shape.elements();
+    shape in_std{input->get_shape().type(), in_lens};
+
+    std::vector<int32_t> ind(n * elements);
+    std::vector<float> weights(n * elements);
+    for(std::size_t i = 0; i < elements; i++)
+    {
+        auto out_idx = out_shape.multi(i);
+        for(std::size_t c = 0; c < n; c++)
+        {
+            // Decompose c into the tap for each dimension, with the last dimension changing
+            // the fastest
+            std::size_t k      = c;
+            std::size_t offset = 0;
+            float w            = 1;
+            for(std::size_t d = taps.size(); d > 0; d--)
+            {
+                const auto& t = taps[d - 1];
+                auto j        = out_idx[d - 1] * t.count + k % t.count;
+                k /= t.count;
+                offset += t.index[j] * in_std.strides()[d - 1];
+                w *= t.weight[j];
+            }
+            ind[c * elements + i]     = offset;
+            weights[c * elements + i] = w;
+        }
+    }
+
+    if(not input->get_shape().standard())
+        input = m.insert_instruction(ins, make_op("contiguous"), input);
+    auto rsp = m.insert_instruction(
+        ins, make_op("reshape", {{"dims", {static_cast<int64_t>(in_std.elements())}}}), input);
+    auto ind_lens = out_shape.lens();
+    if(n > 1)
+        ind_lens.insert(ind_lens.begin(), n);
+    auto ins_ind = m.add_literal(literal{shape{shape::int32_type, ind_lens}, ind});
+    auto data    = m.insert_instruction(ins, make_op("gather", {{"axis", 0}}), rsp, ins_ind);
+    if(n == 1)
+    {
+        m.replace_instruction(ins, data);
+        return;
+    }
+    auto ins_weights = m.add_literal(literal{shape{out_shape.type(), ind_lens}, weights});
+    auto mul         = m.insert_instruction(ins, make_op("mul"), data, ins_weights);
+    auto sum         = m.insert_instruction(ins, make_op("reduce_sum", {{"axes", {0}}}), mul);
+    m.replace_instruction(ins, make_op("squeeze", {{"axes", {0}}}), sum);
+}
+
+void rewrite_resize::apply(module& m) const
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "resize")
+            continue;
+        apply_resize(m, ins);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,282 @@
+#include <migraphx/run_queue.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/register_target.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct run_request_impl
+{
+    parameter_map params;
+    std::vector<argument> outputs;
+    run_callback callback;
+
+    mutable std::mutex m;
+    mutable std::condition_variable cv;
+    run_status status = run_status::queued;
+    std::vector<argument> results;
+    std::exception_ptr error;
+
+    bool is_done() const { return status != run_status::queued and status != run_status::running; }
+
+    void set_status(run_status s)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        status = s;
+    }
+
+    void finish(run_status s)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            status = s;
+            // The inputs are no longer needed
+            params.clear();
+            outputs.clear();
+        }
+        cv.notify_all();
+        if(callback)
+            callback(s);
+    }
+};
+
+run_status run_request::status() const
+{
+    std::lock_guard<std::mutex> lock(impl->m);
+    return impl->status;
+}
+
+bool run_request::done() const
+{
+    std::lock_guard<std::mutex> lock(impl->m);
+    return impl->is_done();
+}
+
+void run_request::wait() const
+{
+    std::unique_lock<std::mutex> lock(impl->m);
+    impl->cv.wait(lock, [&] { return impl->is_done(); });
+}
+
+bool run_request::wait_for(std::chrono::milliseconds timeout) const
+{
+    std::unique_lock<std::mutex> lock(impl->m);
+    return impl->cv.wait_for(lock, timeout, [&] { return impl->is_done(); });
+}
+
+std::vector<argument> run_request::get() const
+{
+    std::unique_lock<std::mutex> lock(impl->m);
+    impl->cv.wait(lock, [&] { return impl->is_done(); });
+    if(impl->status == run_status::failed)
+        std::rethrow_exception(impl->error);
+    if(impl->status == run_status::cancelled)
+        MIGRAPHX_THROW("RUN_QUEUE: Request was cancelled");
+    if(impl->status == run_status::rejected)
+        MIGRAPHX_THROW("RUN_QUEUE: Request was rejected because the queue is full");
+    return impl->results;
+}
+
+static void copy_outputs(const std::vector<argument>& results,
+                         const std::vector<argument>& outputs)
+{
+    if(outputs.size() != results.size())
+        MIGRAPHX_THROW("RUN_QUEUE: Expected " + std::to_string(results.size()) +
+                       " outputs but got " + std::to_string(outputs.size()));
+    for(std::size_t i = 0; i < results.size(); i++)
+    {
+        if(outputs[i].get_shape().elements() != results[i].get_shape().elements())
+            MIGRAPHX_THROW("RUN_QUEUE: Output " + std::to_string(i) +
+                           " has the wrong number of elements");
+        visit_all(outputs[i], results[i])([&](auto output, auto input) {
+            std::copy(input.begin(), input.end(), output.begin());
+        });
+    }
+}
+
+struct run_queue_impl
+{
+    std::size_t capacity = 0;
+    mutable std::mutex m;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<std::shared_ptr<run_request_impl>> queue;
+    bool stopped = false;
+    std::vector<std::thread> workers;
+    // The target of a program whose results can be in device memory
+    optional<target> device;
+
+    static run_request make_request(parameter_map params,
+                                    std::vector<argument> outputs,
+                                    run_callback callback)
+    {
+        run_request r;
+        r.impl           = std::make_shared<run_request_impl>();
+        r.impl->params   = std::move(params);
+        r.impl->outputs  = std::move(outputs);
+        r.impl->callback = std::move(callback);
+        return r;
+    }
+
+    static std::shared_ptr<run_request_impl> get_impl(const run_request& r) { return r.impl; }
+
+    void run(program& p)
+    {
+        for(;;)
+        {
+            std::shared_ptr<run_request_impl> r;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                not_empty.wait(lock, [&] { return stopped or not queue.empty(); });
+                if(queue.empty())
+                    return;
+                r = queue.front();
+                queue.pop_front();
+                r->set_status(run_status::running);
+            }
+            not_full.notify_one();
+            try
+            {
+                auto results = p.eval(r->params);
+                for(auto& a : results)
+                {
+                    bool copied = false;
+                    if(device)
+                    {
+                        auto host = device->copy_from(a);
+                        copied    = host.data() != a.data();
+                        a         = host;
+                    }
+                    // Results on the host can be in the worker's scratch memory, which the next
+                    // request overwrites
+                    if(not copied and r->outputs.empty())
+                        a = a.copy();
+                }
+                if(not r->outputs.empty())
+                {
+                    copy_outputs(results, r->outputs);
+                    results = r->outputs;
+                }
+                r->results = std::move(results);
+                r->finish(run_status::completed);
+            }
+            catch(...)
+            {
+                r->error = std::current_exception();
+                r->finish(run_status::failed);
+            }
+        }
+    }
+};
+
+run_queue::run_queue(const program& p, run_queue_options options)
+    : impl(std::make_unique<run_queue_impl>())
+{
+    if(options.workers == 0)
+        MIGRAPHX_THROW("RUN_QUEUE: At least one worker is required");
+    impl->capacity = std::max<std::size_t>(options.capacity, 1);
+    // With offload_copy the program copies its results to the host itself
+    if(p.is_compiled() and not p.is_offload_copy() and contains(get_targets(), p.get_target_name()))
+        impl->device = make_target(p.get_target_name());
+    for(std::size_t i = 0; i < options.workers; i++)
+    {
+        // Copies share the buffers created when the program was finalized, such as the cpu
+        // scratch memory, so each worker finalizes its own copy
+        program prog = p;
+        prog.finalize();
+        impl->workers.emplace_back(
+            [q = impl.get(), prog = std::move(prog)]() mutable { q->run(prog); });
+    }
+}
+
+run_queue::run_queue(run_queue&&) noexcept = default;
+
+run_queue::~run_queue()
+{
+    // Moved from
+    if(impl == nullptr)
+        return;
+    std::deque<std::shared_ptr<run_request_impl>> pending;
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        impl->stopped = true;
+        pending.swap(impl->queue);
+    }
+    impl->not_empty.notify_all();
+    impl->not_full.notify_all();
+    for(auto&& r : pending)
+        r->finish(run_status::cancelled);
+    for(auto&& t : impl->workers)
+        t.join();
+}
+
+run_request
+run_queue::submit(parameter_map params, std::vector<argument> outputs, run_callback callback)
+{
+    auto r =
+        run_queue_impl::make_request(std::move(params), std::move(outputs), std::move(callback));
+    {
+        std::unique_lock<std::mutex> lock(impl->m);
+        impl->not_full.wait(lock,
+                            [&] { return impl->stopped or impl->queue.size() < impl->capacity; });
+        if(impl->stopped)
+            MIGRAPHX_THROW("RUN_QUEUE: Queue has been stopped");
+        impl->queue.push_back(run_queue_impl::get_impl(r));
+    }
+    impl->not_empty.notify_one();
+    return r;
+}
+
+run_request
+run_queue::try_submit(parameter_map params, std::vector<argument> outputs, run_callback callback)
+{
+    auto r =
+        run_queue_impl::make_request(std::move(params), std::move(outputs), std::move(callback));
+    bool accepted = false;
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        if(not impl->stopped and impl->queue.size() < impl->capacity)
+        {
+            impl->queue.push_back(run_queue_impl::get_impl(r));
+            accepted = true;
+        }
+    }
+    if(accepted)
+        impl->not_empty.notify_one();
+    else
+        run_queue_impl::get_impl(r)->finish(run_status::rejected);
+    return r;
+}
+
+bool run_queue::cancel(const run_request& r)
+{
+    auto ri = run_queue_impl::get_impl(r);
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        auto it = std::find(impl->queue.begin(), impl->queue.end(), ri);
+        if(it == impl->queue.end())
+            return false;
+        impl->queue.erase(it);
+    }
+    impl->not_full.notify_one();
+    ri->finish(run_status::cancelled);
+    return true;
+}
+
+std::size_t run_queue::size() const
+{
+    std::lock_guard<std::mutex> lock(impl->m);
+    return impl->queue.size();
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
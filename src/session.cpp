@@ -0,0 +1,116 @@
+#include <migraphx/session.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static void copy_into(const argument& dst, const argument& src)
+{
+    if(dst.data() == src.data())
+        return;
+    if(dst.get_shape().lens() != src.get_shape().lens())
+        MIGRAPHX_THROW("SESSION: cannot copy {" + to_string_range(src.get_shape().lens()) +
+                       "} into state {" + to_string_range(dst.get_shape().lens()) + "}");
+    visit_all(dst, src)([&](auto output, auto input) {
+        if(output.get_shape().standard() and input.get_shape().standard())
+            std::copy(input.begin(), input.end(), output.begin());
+        else
+            shape_for_each(output.get_shape(), [&](const auto& idx) {
+                output(idx.begin(), idx.end()) = input(idx.begin(), idx.end());
+            });
+    });
+}
+
+session::session(program p) : prog(std::move(p)) {}
+
+void session::add_state(const std::string& name, std::ptrdiff_t output)
+{
+    auto names = prog.get_parameter_names();
+    if(not contains(names, name))
+        MIGRAPHX_THROW("SESSION: program has no parameter " + name);
+    add_state(name, fill_argument(prog.get_parameter_shape(name), 0), output);
+}
+
+void session::add_state(const std::string& name, const argument& init, std::ptrdiff_t output)
+{
+    auto names = prog.get_parameter_names();
+    if(not contains(names, name))
+        MIGRAPHX_THROW("SESSION: program has no parameter " + name);
+    if(contains(states, name))
+        MIGRAPHX_THROW("SESSION: state " + name + " was already added");
+    auto s = prog.get_parameter_shape(name);
+    if(init.get_shape() != s)
+        MIGRAPHX_THROW("SESSION: incorrect shape {" + to_string(init.get_shape()) +
+                       "} for state: " + name);
+    state x;
+    x.buffer = argument{s};
+    x.init   = init;
+    x.output = output;
+    copy_into(x.buffer, x.init);
+    states.emplace(name, x);
+}
+
+bool session::has_state(const std::string& name) const { return contains(states, name); }
+
+std::vector<std::string> session::get_state_names() const
+{
+    std::vector<std::string> result;
+    std::transform(states.begin(), states.end(), std::back_inserter(result), [](auto&& p) {
+        return p.first;
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+const session::state& session::get(const std::string& name) const
+{
+    auto it = states.find(name);
+    if(it == states.end())
+        MIGRAPHX_THROW("SESSION: unknown state " + name);
+    return it->second;
+}
+
+argument session::get_state(const std::string& name) const { return get(name).buffer; }
+
+void session::set_state(const std::string& name, const argument& value)
+{
+    copy_into(get(name).buffer, value);
+}
+
+void session::reset()
+{
+    for(auto&& p : states)
+        copy_into(p.second.buffer, p.second.init);
+}
+
+std::vector<argument> session::eval(parameter_map params)
+{
+    for(auto&& p : states)
+    {
+        if(contains(params, p.first))
+            MIGRAPHX_THROW("SESSION: parameter " + p.first + " is kept by the session");
+        params[p.first] = p.second.buffer;
+    }
+    auto results = prog.eval(std::move(params));
+    for(auto&& p : states)
+    {
+        if(p.second.output < 0)
+            continue;
+        if(p.second.output >= static_cast<std::ptrdiff_t>(results.size()))
+            MIGRAPHX_THROW("SESSION: output " + std::to_string(p.second.output) +
+                           " for state " + p.first + " is out of range");
+        copy_into(p.second.buffer, results[p.second.output]);
+    }
+    return results;
+}
+
+const program& session::get_program() const { return prog; }
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,175 @@
+#include <migraphx/shape_specializer.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/eliminate_common_subexpression.hpp>
+#include <migraphx/eliminate_identity.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <iterator>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+program specialize_parameters(const program& p,
+                              const std::unordered_map<std::string, shape>& shapes)
+{
+    if(p.is_compiled())
+        MIGRAPHX_THROW("SPECIALIZE: program is already compiled");
+    if(p.get_modules().size() > 1)
+        MIGRAPHX_THROW("SPECIALIZE: programs with submodules are not supported");
+    const auto* mm = p.get_main_module();
+    auto names     = mm->get_parameter_names();
+    for(auto&& s : shapes)
+    {
+        if(not contains(names, s.first))
+            MIGRAPHX_THROW("SPECIALIZE: program has no parameter " + s.first);
+    }
+
+    program result;
+    auto* rm = result.get_main_module();
+    std::unordered_map<instruction_ref, instruction_ref> map_ins;
+    // Parameters are added to the front, so add them in reverse to keep them in the same order
+    for(auto ins : reverse_iterator_for(*mm))
+    {
+        if(ins->name() != "@param")
+            continue;
+        auto name    = any_cast<builtin::param>(ins->get_operator()).parameter;
+        auto it      = shapes.find(name);
+        auto s       = it == shapes.end() ? ins->get_shape() : it->second;
+        map_ins[ins] = rm->add_parameter(name, s);
+    }
+    for(auto ins : iterator_for(*mm))
+    {
+        if(ins->name() == "@param")
+            continue;
+        if(ins->name() == "@literal")
+        {
+            map_ins[ins] = rm->add_literal(ins->get_literal());
+            continue;
+        }
+        if(ins->name() == "@outline")
+        {
+            map_ins[ins] = rm->add_outline(ins->get_shape());
+            continue;
+        }
+        std::vector<instruction_ref> args;
+        std::transform(ins->inputs().begin(),
+                       ins->inputs().end(),
+                       std::back_inserter(args),
+                       [&](auto input) { return map_ins.at(input); });
+        if(ins->name() == "@return")
+        {
+            rm->add_return(args);
+            continue;
+        }
+        try
+        {
+            map_ins[ins] = rm->add_instruction(ins->get_operator(), args);
+        }
+        catch(const std::exception& e)
+        {
+            MIGRAPHX_THROW("SPECIALIZE: " + ins->name() +
+                           " cannot be specialized for the new shapes: " + e.what());
+        }
+    }
+    return result;
+}
+
+shape_specializer::shape_specializer(program p,
+                                     target tgt,
+                                     compile_options opts,
+                                     std::size_t max_programs)
+    : prog(std::move(p)), t(std::move(tgt)), options(std::move(opts)), capacity(max_programs)
+{
+    if(capacity == 0)
+        MIGRAPHX_THROW("SHAPE_SPECIALIZER: capacity must be at least one");
+    if(options.fold_cache == nullptr)
+        options.fold_cache = &fold_cache;
+    run_passes(prog,
+               {eliminate_identity{},
+                dead_code_elimination{},
+                propagate_constant{options.fold_cache},
+                dead_code_elimination{},
+                eliminate_common_subexpression{},
+                dead_code_elimination{}});
+}
+
+std::shared_ptr<shape_specializer::compiled_program>
+shape_specializer::get_compiled(const std::unordered_map<std::string, shape>& shapes)
+{
+    auto names = prog.get_parameter_names();
+    std::sort(names.begin(), names.end());
+    std::string key;
+    for(const auto& name : names)
+    {
+        auto it = shapes.find(name);
+        key += name + ":" +
+               to_string(it == shapes.end() ? prog.get_parameter_shape(name) : it->second) + ";";
+    }
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto it = programs.find(key);
+        if(it != programs.end())
+        {
+            recent.splice(recent.begin(), recent, it->second.second);
+            return it->second.first;
+        }
+    }
+    // Compile outside of the lock so running with shapes that are already compiled does not wait
+    auto cp  = std::make_shared<compiled_program>();
+    cp->prog = specialize_parameters(prog, shapes);
+    cp->prog.compile(t, options);
+    std::lock_guard<std::mutex> lock(m);
+    // Another thread could have compiled the same shapes in the meantime
+    auto it = programs.find(key);
+    if(it != programs.end())
+    {
+        recent.splice(recent.begin(), recent, it->second.second);
+        return it->second.first;
+    }
+    recent.push_front(key);
+    programs.emplace(key, std::make_pair(cp, recent.begin()));
+    if(programs.size() > capacity)
+    {
+        programs.erase(recent.back());
+        recent.pop_back();
+        // Constants of the dropped program would otherwise be kept for as long as the specializer
+        if(options.fold_cache == &fold_cache)
+            fold_cache.clear();
+    }
+    return cp;
+}
+
+std::shared_ptr<const program>
+shape_specializer::compile(const std::unordered_map<std::string, shape>& shapes)
+{
+    auto cp = get_compiled(shapes);
+    return {cp, &cp->prog};
+}
+
+std::vector<argument> shape_specializer::eval(parameter_map params)
+{
+    // Arguments that are not parameters of the program are ignored, as in program::eval
+    std::unordered_map<std::string, shape> shapes;
+    for(const auto& name : prog.get_parameter_names())
+    {
+        auto it = params.find(name);
+        if(it != params.end())
+            shapes[name] = it->second.get_shape();
+    }
+    auto cp = get_compiled(shapes);
+    std::lock_guard<std::mutex> lock(cp->m);
+    return cp->prog.eval(std::move(params));
+}
+
+std::size_t shape_specializer::size() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    return programs.size();
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -1014,28 +1014,25 @@ struct find_split_transpose
 
 void simplify_algebra::apply(module& p) const
 {
-    // Run simplifications multiple times
-    for(int i = 0; i < 8; i++)
-    {
-        match::find_matches(p,
-                            find_inner_broadcast{},
-                            find_double_add_lit_broadcast{},
-                            find_add_lit_broadcast{},
-                            find_add_convs{},
-                            find_conv_dot_horiz_fusion{},
-                            find_mul_conv{},
-                            find_mul_slice_conv{},
-                            find_mul_add{},
-                            find_div_const{},
-                            find_sub_const{},
-                            find_rsqrt{},
-                            find_concat_op{},
-                            find_split_concat{},
-                            find_splits{},
-                            find_split_reshape{},
-                            find_split_transpose{});
-        dead_code_elimination{}.apply(p);
-    }
+    // Run simplifications until nothing changes
+    match::find_matches_fixpoint(p,
+                                 find_inner_broadcast{},
+                                 find_double_add_lit_broadcast{},
+                                 find_add_lit_broadcast{},
+                                 find_add_convs{},
+                                 find_conv_dot_horiz_fusion{},
+                                 find_mul_conv{},
+                                 find_mul_slice_conv{},
+                                 find_mul_add{},
+                                 find_div_const{},
+                                 find_sub_const{},
+                                 find_rsqrt{},
+                                 find_concat_op{},
+                                 find_split_concat{},
+                                 find_splits{},
+                                 find_split_reshape{},
+                                 find_split_transpose{});
+    dead_code_elimination{}.apply(p);
 }
 
 } // namespace MIGRAPHX_INLINE_NS
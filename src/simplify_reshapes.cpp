@@ -6,6 +6,7 @@
 #include <migraphx/op/transpose.hpp>
 #include <migraphx/op/concat.hpp>
 #include <migraphx/op/slice.hpp>
+#include <migraphx/op/resize.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/matcher.hpp>
@@ -287,6 +288,77 @@ struct find_concat_transpose
     }
 };
 
+// Inputs that can be transposed without copying data
+bool is_layout_free(instruction_ref ins)
+{
+    return ins->get_shape().broadcasted() or ins->can_eval();
+}
+
+struct find_transpose_pointwise
+{
+    auto matcher() const
+    {
+        return match::pointwise(match::any_of[match::inputs()](match::name("transpose")));
+    }
+
+    void apply(module& p, const match::matcher_result& mr) const
+    {
+        auto ins    = mr.result;
+        auto inputs = ins->inputs();
+        // Only move transposes of computed values, so it won't keep moving transposes of
+        // broadcasts and literals back and forth
+        auto it = std::find_if(inputs.begin(), inputs.end(), [](auto input) {
+            return input->name() == "transpose" and not is_layout_free(input->inputs().front());
+        });
+        if(it == inputs.end())
+            return;
+        auto dims = get_transpose_dims(*it);
+        if(not std::all_of(inputs.begin(), inputs.end(), [&](auto input) {
+               if(input->name() == "transpose" and get_transpose_dims(input) == dims)
+                   return true;
+               return is_layout_free(input);
+           }))
+            return;
+
+        auto idims = invert_permutation(dims);
+        std::vector<instruction_ref> args;
+        std::transform(inputs.begin(), inputs.end(), std::back_inserter(args), [&](auto input) {
+            if(input->name() == "transpose" and get_transpose_dims(input) == dims)
+                return input->inputs().front();
+            return p.insert_instruction(ins, make_op("transpose", {{"dims", idims}}), input);
+        });
+        auto op = p.insert_instruction(ins, ins->get_operator(), args);
+        p.replace_instruction(ins, make_op("transpose", {{"dims", dims}}), op);
+    }
+};
+
+struct find_transpose_reduce
+{
+    auto matcher() const
+    {
+        return match::name_contains("reduce")(
+            match::nargs(1), match::arg(0)(match::name("transpose").bind("trans")));
+    }
+
+    void apply(module& p, match::matcher_result r) const
+    {
+        auto ins   = r.result;
+        auto trans = r.instructions["trans"];
+        auto dims  = get_transpose_dims(trans);
+        auto v     = ins->get_operator().to_value();
+        if(not v.contains("axes"))
+            return;
+        auto axes = v.at("axes").to_vector<int64_t>();
+        auto ndim = static_cast<int64_t>(dims.size());
+        std::transform(axes.begin(), axes.end(), axes.begin(), [&](auto axis) {
+            return dims[axis < 0 ? axis + ndim : axis];
+        });
+        v["axes"]   = axes;
+        auto reduce = p.insert_instruction(ins, make_op(ins->name(), v), trans->inputs().front());
+        p.replace_instruction(ins, make_op("transpose", {{"dims", dims}}), reduce);
+    }
+};
+
 struct find_nested_concat
 {
     auto matcher() const
@@ -319,17 +391,114 @@ struct find_nested_concat
     }
 };
 
+// Replace a resize that repeats each input element scales times along each dimension with a
+// multibroadcast
+static void replace_resize_with_broadcast(module& p,
+                                          instruction_ref pos,
+                                          instruction_ref ins,
+                                          instruction_ref input,
+                                          const std::vector<std::size_t>& scales)
+{
+    const auto& in_lens  = input->get_shape().lens();
+    const auto& out_lens = ins->get_shape().lens();
+    std::vector<int64_t> in_dims;
+    std::vector<int64_t> out_dims;
+    for(std::size_t i = 0; i < in_lens.size(); i++)
+    {
+        in_dims.push_back(in_lens[i]);
+        out_dims.push_back(out_lens[i]);
+        if(in_lens[i] == 1 or scales[i] == 1)
+        {
+            continue;
+        }
+
+        out_dims.back() = in_lens[i];
+        in_dims.push_back(1);
+        out_dims.push_back(scales[i]);
+    }
+
+    if(not input->get_shape().standard())
+        input = p.insert_instruction(pos, migraphx::make_op("contiguous"), input);
+    auto rsp_data =
+        p.insert_instruction(pos, migraphx::make_op("reshape", {{"dims", in_dims}}), input);
+    auto mb_rsp = p.insert_instruction(
+        pos, migraphx::make_op("multibroadcast", {{"output_lens", out_dims}}), rsp_data);
+    auto std_mb = p.insert_instruction(ins, migraphx::make_op("contiguous"), mb_rsp);
+    std::vector<int64_t> rsp_dims(out_lens.begin(), out_lens.end());
+    p.replace_instruction(ins, migraphx::make_op("reshape", {{"dims", rsp_dims}}), std_mb);
+}
+
+// Get the scale for each dimension when the output shape is a multiple of the input shape
+static std::vector<std::size_t> integer_scales(const std::vector<std::size_t>& in_lens,
+                                               const std::vector<std::size_t>& out_lens)
+{
+    if(in_lens.size() != out_lens.size())
+    {
+        return {};
+    }
+
+    // output shape must be multiple of input shape
+    std::vector<bool> is_multi(in_lens.size());
+    std::transform(
+        in_lens.begin(), in_lens.end(), out_lens.begin(), is_multi.begin(), [](auto x, auto y) {
+            return (y % x == 0);
+        });
+    if(not std::all_of(is_multi.begin(), is_multi.end(), [](auto b) { return b; }))
+    {
+        return {};
+    }
+
+    // output must be multiple of inputs
+    std::vector<std::size_t> scales(in_lens.size());
+    std::transform(
+        in_lens.begin(), in_lens.end(), out_lens.begin(), scales.begin(), [](auto x, auto y) {
+            return y / x;
+        });
+    return scales;
+}
+
 struct find_resize
 {
     auto matcher() const
     {
-        return match::name("gather")(
-            match::args(match::name("reshape").bind("data"), match::is_constant().bind("ind")));
+        return match::name("gather", "resize")(match::any_of(
+            match::name("resize"),
+            match::args(match::name("reshape").bind("data"), match::is_constant().bind("ind"))));
+    }
+
+    void apply_resize(module& p, instruction_ref ins) const
+    {
+        auto op     = any_cast<op::resize>(ins->get_operator());
+        auto input  = ins->inputs().front();
+        auto scales = integer_scales(input->get_shape().lens(), ins->get_shape().lens());
+        if(op.mode != "nearest" or scales.empty())
+        {
+            return;
+        }
+
+        // each output element must read the first input element of its block
+        auto taps = op.compute_taps(input->get_shape().lens());
+        for(std::size_t d = 0; d < taps.size(); d++)
+        {
+            if(not all_of(range(taps[d].index.size()),
+                          [&](auto i) { return taps[d].index[i] == i / scales[d]; }))
+            {
+                return;
+            }
+        }
+
+        replace_resize_with_broadcast(p, ins, ins, input, scales);
     }
 
     void apply(module& p, match::matcher_result r) const
     {
-        auto ins     = r.result;
+        auto ins = r.result;
+        if(ins->name() == "resize")
+        {
+            apply_resize(p, ins);
+            return;
+        }
+
         auto ins_rsp = r.instructions["data"];
         auto ins_ind = r.instructions["ind"];
 
@@ -342,32 +511,12 @@ struct find_resize
         // resize output shape
         const auto& in_shape  = ins_rsp->inputs().front()->get_shape();
         const auto& out_shape = ins->get_shape();
-        // check if output shape is multiple of input shape
-        const auto& in_lens  = in_shape.lens();
-        const auto& out_lens = out_shape.lens();
-        if(in_lens.size() != out_lens.size())
-        {
-            return;
-        }
-
-        // output shape must be multiple of input shape
-        std::vector<bool> is_multi(in_lens.size());
-        std::transform(
-            in_lens.begin(), in_lens.end(), out_lens.begin(), is_multi.begin(), [](auto x, auto y) {
-                return (y % x == 0);
-            });
-        if(not std::all_of(is_multi.begin(), is_multi.end(), [](auto b) { return b; }))
+        auto scales           = integer_scales(in_shape.lens(), out_shape.lens());
+        if(scales.empty())
         {
             return;
         }
 
-        // output must be multiple of inputs
-        std::vector<std::size_t> scales(in_lens.size());
-        std::transform(
-            in_lens.begin(), in_lens.end(), out_lens.begin(), scales.begin(), [](auto x, auto y) {
-                return y / x;
-            });
-
         // if ind is not constant, cannot optimize
         std::vector<int> vec_ind;
         auto arg_ind = ins_ind->eval();
@@ -390,38 +539,7 @@ struct find_resize
             return;
         }
 
-        // wrap up shapes for multibroadcast
-        std::vector<std::pair<std::size_t, std::size_t>> dim_scales;
-        std::transform(in_lens.begin(),
-                       in_lens.end(),
-                       out_lens.begin(),
-                       std::back_inserter(dim_scales),
-                       [](auto x, auto y) { return std::make_pair(x, y / x); });
-
-        std::vector<int64_t> in_dims;
-        std::vector<int64_t> out_dims;
-        for(auto& isp : dim_scales)
-        {
-            in_dims.push_back(isp.first);
-            out_dims.push_back(isp.first * isp.second);
-            if(isp.first == 1 or isp.second == 1)
-            {
-                continue;
-            }
-
-            out_dims.back() = isp.first;
-            in_dims.push_back(1);
-            out_dims.push_back(isp.second);
-        }
-
-        auto in_rsp   = ins_rsp->inputs().front();
-        auto rsp_data = p.insert_instruction(
-            ins_rsp, migraphx::make_op("reshape", {{"dims", in_dims}}), in_rsp);
-        auto mb_rsp = p.insert_instruction(
-            ins_rsp, migraphx::make_op("multibroadcast", {{"output_lens", out_dims}}), rsp_data);
-        auto std_mb = p.insert_instruction(ins, migraphx::make_op("contiguous"), mb_rsp);
-        std::vector<int64_t> rsp_dims(out_lens.begin(), out_lens.end());
-        p.replace_instruction(ins, migraphx::make_op("reshape", {{"dims", rsp_dims}}), std_mb);
+        replace_resize_with_broadcast(p, ins_rsp, ins, ins_rsp->inputs().front(), scales);
     }
 };
 
@@ -538,21 +656,20 @@ struct find_reshape_cont
 
 void simplify_reshapes::apply(module& p) const
 {
-    for(int i = 0; i < 2; i++)
-    {
-        match::find_matches(p,
-                            find_where_op{},
-                            find_resize{},
-                            find_reshape_cont{},
-                            find_nop_reshapes{},
-                            find_reshaper{},
-                            find_transpose{},
-                            find_concat_transpose{},
-                            find_nested_convert{},
-                            find_nested_slice{},
-                            find_nested_concat{});
-        dead_code_elimination{}.apply(p);
-    }
+    match::find_matches_fixpoint(p,
+                                 find_where_op{},
+                                 find_resize{},
+                                 find_reshape_cont{},
+                                 find_nop_reshapes{},
+                                 find_reshaper{},
+                                 find_transpose{},
+                                 find_concat_transpose{},
+                                 find_transpose_pointwise{},
+                                 find_transpose_reduce{},
+                                 find_nested_convert{},
+                                 find_nested_slice{},
+                                 find_nested_concat{});
+    dead_code_elimination{}.apply(p);
 }
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,147 @@
+#include <migraphx/sparsify_weights.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/sparse_dot.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/verify.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/quantization.hpp>
+#include <algorithm>
+#include <cstdint>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+namespace {
+struct sparse_weights
+{
+    literal values;
+    literal columns;
+    literal rows;
+    std::size_t stored = 0;
+    std::size_t blocks = 0;
+};
+} // namespace
+
+// Split the rows of the last two dimensions of the weights w, which are [K, N], into blocks
+// along N and keep the blocks with nonzero values
+static sparse_weights to_sparse(const argument& w, std::size_t block_size, float alpha)
+{
+    auto ws      = w.get_shape();
+    auto r       = ws.lens().size();
+    auto k       = ws.lens()[r - 2];
+    auto n       = ws.lens()[r - 1];
+    auto kstride = ws.strides()[r - 2];
+    auto nstride = ws.strides()[r - 1];
+    auto nblocks = (n + block_size - 1) / block_size;
+    std::vector<float> values;
+    std::vector<std::int32_t> columns;
+    std::vector<std::int32_t> rows = {0};
+    w.visit([&](auto v) {
+        const auto* p = v.data();
+        for(std::size_t i = 0; i < k; i++)
+        {
+            for(std::size_t blk = 0; blk < nblocks; blk++)
+            {
+                auto start   = blk * block_size;
+                auto end     = std::min(n, start + block_size);
+                bool nonzero = false;
+                for(auto j = start; j < end and not nonzero; j++)
+                    nonzero = p[i * kstride + j * nstride] != 0;
+                if(not nonzero)
+                    continue;
+                columns.push_back(blk);
+                for(auto j = start; j < start + block_size; j++)
+                    values.push_back(j < n ? alpha * float(p[i * kstride + j * nstride]) : 0.0f);
+            }
+            rows.push_back(columns.size());
+        }
+    });
+    sparse_weights result;
+    result.stored = columns.size();
+    result.blocks = k * nblocks;
+    // Keep a block when every weight is zero so the values are not empty
+    if(columns.empty())
+    {
+        columns.push_back(0);
+        values.resize(block_size);
+    }
+    result.values  = literal{shape{shape::float_type, {columns.size(), block_size}}, values};
+    result.columns = literal{shape{shape::int32_type, {columns.size()}}, columns};
+    result.rows    = literal{shape{shape::int32_type, {rows.size()}}, rows};
+    return result;
+}
+
+// Compare the sparse dot with a dot of the dense weights for a generated input
+static void verify_sparse(const argument& w,
+                          const op::sparse_dot& sop,
+                          const sparse_weights& sw,
+                          float alpha)
+{
+    auto ws      = w.get_shape();
+    auto r       = ws.lens().size();
+    auto k       = ws.lens()[r - 2];
+    auto n       = ws.lens()[r - 1];
+    auto kstride = ws.strides()[r - 2];
+    auto nstride = ws.strides()[r - 1];
+
+    const std::size_t m = 4;
+    shape as{shape::float_type, {m, k}};
+    auto a        = generate_argument(as);
+    const auto* x = a.cast<float>();
+    std::vector<float> dense(m * n);
+    w.visit([&](auto v) {
+        const auto* p = v.data();
+        for(std::size_t i = 0; i < m; i++)
+        {
+            for(std::size_t j = 0; j < n; j++)
+            {
+                double acc = 0;
+                for(std::size_t kk = 0; kk < k; kk++)
+                    acc += double(x[i * k + kk]) * p[kk * kstride + j * nstride];
+                dense[i * n + j] = alpha * acc;
+            }
+        }
+    });
+    std::vector<shape> inputs = {
+        as, sw.values.get_shape(), sw.columns.get_shape(), sw.rows.get_shape()};
+    auto result = sop.compute(
+        sop.compute_shape(inputs),
+        {a, sw.values.get_argument(), sw.columns.get_argument(), sw.rows.get_argument()});
+    std::vector<float> sparse(result.cast<float>(), result.cast<float>() + m * n);
+    if(not verify_range(sparse, dense))
+        MIGRAPHX_THROW("SPARSIFY_WEIGHTS: sparse dot differs from the dense dot by " +
+                       std::to_string(rms_range(sparse, dense)));
+}
+
+void sparsify_weights::apply(module& m) const
+{
+    if(block_size == 0)
+        MIGRAPHX_THROW("SPARSIFY_WEIGHTS: block_size must not be zero");
+    for(auto ins : iterator_for(m))
+    {
+        auto w = constant_dot_weights(ins);
+        if(w.empty())
+            continue;
+        auto a     = ins->inputs()[0];
+        auto alpha = ins->get_operator().to_value()["alpha"].to<float>();
+        auto sw    = to_sparse(w, block_size, alpha);
+        if(sw.stored > density * sw.blocks)
+            continue;
+        op::sparse_dot sop{w.get_shape().lens().back(), block_size};
+        if(verify)
+            verify_sparse(w, sop, sw, alpha);
+        if(not a->get_shape().standard())
+            a = m.insert_instruction(ins, make_op("contiguous"), a);
+        auto values  = m.add_literal(sw.values);
+        auto columns = m.add_literal(sw.columns);
+        auto rows    = m.add_literal(sw.rows);
+        m.replace_instruction(ins, sop, a, values, columns, rows);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,195 @@
+#include <migraphx/config.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/reflect.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+// Number of queries and keys processed together, the scratch memory used per thread is
+// block_q * (block_k + dv) floats
+constexpr std::size_t block_q = 32;
+constexpr std::size_t block_k = 64;
+
+// Offset of the first element of the matrix at batch index b, using the strides of s
+static std::size_t batch_offset(const shape& s, std::size_t b)
+{
+    const auto& lens    = s.lens();
+    const auto& strides = s.strides();
+    std::size_t result  = 0;
+    for(std::size_t i = lens.size() - 2; i > 0; i--)
+    {
+        result += (b % lens[i - 1]) * strides[i - 1];
+        b /= lens[i - 1];
+    }
+    return result;
+}
+
+/**
+ * Computes softmax(scale * q * kt + mask) * v over the last two dimensions without
+ * materializing the score matrix. The keys are processed in blocks, and the softmax is
+ * computed online by rescaling the partial results whenever the running row maximum changes,
+ * so the scratch memory only depends on the block sizes.
+ */
+struct cpu_attention : auto_register_op<cpu_attention>
+{
+    float scale = 1.0f;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.scale, "scale"));
+    }
+
+    std::string name() const { return "cpu::attention"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        check_shapes{inputs, *this}.has(3, 4).same_type().same_ndims().min_ndims(2);
+        const auto& q  = inputs[0];
+        const auto& kt = inputs[1];
+        const auto& v  = inputs[2];
+        auto n         = q.lens().size();
+        if(q.lens()[n - 1] != kt.lens()[n - 2] or kt.lens()[n - 1] != v.lens()[n - 2] or
+           not std::equal(q.lens().begin(), q.lens().end() - 2, kt.lens().begin()) or
+           not std::equal(q.lens().begin(), q.lens().end() - 2, v.lens().begin()))
+            MIGRAPHX_THROW("ATTENTION: dimensions of q, kt and v do not match");
+        auto lens   = q.lens();
+        lens.back() = v.lens().back();
+        if(inputs.size() == 4)
+        {
+            auto score_lens   = q.lens();
+            score_lens.back() = kt.lens().back();
+            if(inputs[3].lens() != score_lens)
+                MIGRAPHX_THROW("ATTENTION: mask does not match the scores");
+        }
+        return {q.type(), lens};
+    }
+
+    argument
+    // cppcheck-suppress constParameter
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        const bool has_mask = args.size() == 5;
+        auto q_s            = args[0].get_shape();
+        auto kt_s           = args[1].get_shape();
+        auto v_s            = args[2].get_shape();
+        auto mask_s         = has_mask ? args[3].get_shape() : q_s;
+        auto n              = q_s.lens().size();
+        auto sq             = q_s.lens()[n - 2];
+        auto d              = q_s.lens()[n - 1];
+        auto sk             = kt_s.lens()[n - 1];
+        auto dv             = v_s.lens()[n - 1];
+        auto batch          = output_shape.elements() / (sq * dv);
+        auto qblocks        = (sq + block_q - 1) / block_q;
+        const auto& qst     = q_s.strides();
+        const auto& ktst    = kt_s.strides();
+        const auto& vst     = v_s.strides();
+        const auto& mst     = mask_s.strides();
+        const auto mask_arg = has_mask ? args[3] : args[0];
+        auto s              = scale;
+        const auto inf      = std::numeric_limits<float>::infinity();
+
+        visit_all(args.back(), args[0], args[1], args[2], mask_arg)(
+            [&](auto output, auto q, auto kt, auto v, auto mask) {
+                const auto* q_ptr    = q.data();
+                const auto* kt_ptr   = kt.data();
+                const auto* v_ptr    = v.data();
+                const auto* mask_ptr = mask.data();
+                auto* out_ptr        = output.data();
+                ctx.bulk_execute(batch * qblocks, 1, [&](auto start, auto end) {
+                    std::vector<float> scores(block_q * block_k);
+                    std::vector<float> acc(block_q * dv);
+                    std::vector<float> row_max(block_q);
+                    std::vector<float> row_sum(block_q);
+                    for(auto w = start; w < end; w++)
+                    {
+                        auto b     = w / qblocks;
+                        auto q0    = (w % qblocks) * block_q;
+                        auto nq    = std::min(block_q, sq - q0);
+                        auto qoff  = batch_offset(q_s, b) + q0 * qst[n - 2];
+                        auto ktoff = batch_offset(kt_s, b);
+                        auto voff  = batch_offset(v_s, b);
+                        auto moff  = has_mask ? batch_offset(mask_s, b) + q0 * mst[n - 2] : 0;
+                        std::fill(row_max.begin(), row_max.end(), -inf);
+                        std::fill(row_sum.begin(), row_sum.end(), 0.0f);
+                        std::fill(acc.begin(), acc.end(), 0.0f);
+                        for(std::size_t k0 = 0; k0 < sk; k0 += block_k)
+                        {
+                            auto nk = std::min(block_k, sk - k0);
+                            for(std::size_t i = 0; i < nq; i++)
+                            {
+                                const auto* qi = q_ptr + qoff + i * qst[n - 2];
+                                for(std::size_t j = 0; j < nk; j++)
+                                {
+                                    const auto* kj = kt_ptr + ktoff + (k0 + j) * ktst[n - 1];
+                                    float x        = 0;
+                                    for(std::size_t t = 0; t < d; t++)
+                                        x += float(qi[t * qst[n - 1]]) *
+                                             float(kj[t * ktst[n - 2]]);
+                                    x *= s;
+                                    if(has_mask)
+                                        x += float(mask_ptr[moff + i * mst[n - 2] +
+                                                            (k0 + j) * mst[n - 1]]);
+                                    scores[i * block_k + j] = x;
+                                }
+                            }
+                            for(std::size_t i = 0; i < nq; i++)
+                            {
+                                auto* si = scores.data() + i * block_k;
+                                auto mx  = std::max(row_max[i], *std::max_element(si, si + nk));
+                                // Every score seen so far is masked out
+                                if(mx == -inf)
+                                    continue;
+                                auto correction = std::exp(row_max[i] - mx);
+                                float sum       = 0;
+                                for(std::size_t j = 0; j < nk; j++)
+                                {
+                                    si[j] = std::exp(si[j] - mx);
+                                    sum += si[j];
+                                }
+                                row_sum[i] = row_sum[i] * correction + sum;
+                                row_max[i] = mx;
+                                auto* ai   = acc.data() + i * dv;
+                                for(std::size_t c = 0; c < dv; c++)
+                                    ai[c] *= correction;
+                                for(std::size_t j = 0; j < nk; j++)
+                                {
+                                    const auto* vj = v_ptr + voff + (k0 + j) * vst[n - 2];
+                                    for(std::size_t c = 0; c < dv; c++)
+                                        ai[c] += si[j] * float(vj[c * vst[n - 1]]);
+                                }
+                            }
+                        }
+                        auto* oi = out_ptr + (b * sq + q0) * dv;
+                        for(std::size_t i = 0; i < nq; i++)
+                        {
+                            for(std::size_t c = 0; c < dv; c++)
+                                oi[i * dv + c] = acc[i * dv + c] / row_sum[i];
+                        }
+                    }
+                });
+            });
+
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -26,12 +26,16 @@ struct dnnl_binary : dnnl_op<dnnl_binary, dnnl::binary>
         auto s0 = inputs.at(0);
         auto s1 = inputs.at(1);
         auto r  = s0;
-        if(s0 != s1 or !s0.packed())
-        {
+        // Keep the layout of the input that isn't broadcasted, so channels last tensors stay
+        // channels last
+        if(s0.packed() and s1.broadcasted())
+            r = s0;
+        else if(s1.packed() and s0.broadcasted())
+            r = s1;
+        else if(s0 != s1 or !s0.packed())
             r = shape{s0.type(), s0.lens()};
-        }
         // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        this->get_primitive(r, inputs);
         return r;
     }
 
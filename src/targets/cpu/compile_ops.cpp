@@ -0,0 +1,31 @@
+#include <migraphx/cpu/compile_ops.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/par_for.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+void compile_ops::apply(module& m) const
+{
+    assert(ctx);
+    std::vector<instruction_ref> inss;
+    for(auto ins : iterator_for(m))
+    {
+        if(starts_with(ins->name(), "dnnl::"))
+            inss.push_back(ins);
+    }
+    par_for_rethrow(inss.size(), 1, [&](auto i) {
+        auto ins = inss[i];
+        auto op  = ins->get_operator();
+        op.compile(*ctx, ins->get_shape(), to_shapes(ins->inputs()));
+    });
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
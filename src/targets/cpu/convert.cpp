@@ -0,0 +1,67 @@
+#include <migraphx/config.hpp>
+#include <migraphx/cpu/pointwise.hpp>
+#include <migraphx/op/convert.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+/**
+ * Converts between float and half with the bulk conversions split across threads, and falls
+ * back to converting each element for other types and layouts.
+ */
+struct cpu_convert : reduce_dims_base, auto_register_op<cpu_convert>
+{
+    op::convert op;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+
+    std::string name() const { return "cpu::convert"; }
+
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has(2);
+        return op.compute_shape({inputs.at(0)});
+    }
+
+    argument
+    // cppcheck-suppress constParameter
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        argument result = get_arg(args, args.size() - 1);
+        argument input  = get_arg(args, 0);
+
+        if(op::convert::bulk_convertible(input.get_shape(), result.get_shape()))
+        {
+            ctx.bulk_execute(result.get_shape().elements(), 4096, [&](auto start, auto end) {
+                op::convert::bulk_convert(input, result, start, end);
+            });
+        }
+        else
+        {
+            result.visit([&](auto output) {
+                input.visit([&](auto x) {
+                    auto op2 = op;
+                    pointwise(output, x)(ctx, output.get_shape(), 1024, [op2](auto& y, auto v) {
+                        y = op2.apply()(v);
+                    });
+                });
+            });
+        }
+
+        return result.reshape(output_shape);
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
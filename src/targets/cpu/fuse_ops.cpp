@@ -98,11 +98,8 @@ struct find_post_ops
 
 void fuse_ops::apply(module& m) const
 {
-    for(std::size_t i = 0; i < 4; i++)
-    {
-        match::find_matches(m, find_post_ops{ctx});
-        dead_code_elimination{}.apply(m);
-    }
+    match::find_matches_fixpoint(m, find_post_ops{ctx});
+    dead_code_elimination{}.apply(m);
 }
 
 } // namespace cpu
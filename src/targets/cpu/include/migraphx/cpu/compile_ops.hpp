@@ -0,0 +1,29 @@
+#ifndef MIGRAPHX_GUARD_CPU_COMPILE_OPS_HPP
+#define MIGRAPHX_GUARD_CPU_COMPILE_OPS_HPP
+
+#include <migraphx/config.hpp>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+struct context;
+
+namespace cpu {
+
+/**
+ * Compile the dnnl operators in parallel before the module is finalized. The primitives are
+ * cached by the operators so finalization reuses them instead of creating them one at a time.
+ */
+struct compile_ops
+{
+    migraphx::context* ctx = nullptr;
+    std::string name() const { return "cpu::compile_ops"; }
+    void apply(module& m) const;
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_CPU_COMPILE_OPS_HPP
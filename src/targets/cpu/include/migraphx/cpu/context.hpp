@@ -3,6 +3,7 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/cpu/numa.hpp>
 #include <migraphx/cpu/parallel.hpp>
 #include <migraphx/par_for.hpp>
 
@@ -12,11 +13,23 @@ namespace cpu {
 
 struct context
 {
+    /// NUMA node the execution is pinned to, or -1 to run on every node. Scratch memory and
+    /// literals are allocated on this node when the program is compiled.
+    int numa_node = -1;
+
     void finish() const {}
 
     template <class F>
     void bulk_execute(std::size_t n, std::size_t min_grain, F f)
     {
+        if(numa_node < 0)
+        {
+            cpu::parallel_for(n, min_grain, f);
+            return;
+        }
+        // The calling thread is bound for the duration of the call and the pool it starts stays
+        // bound, so the workers don't change their affinity for every call
+        numa_thread_binding binding{numa_node};
         cpu::parallel_for(n, min_grain, f);
     }
 
@@ -6,7 +6,13 @@
 #include <migraphx/reflect.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/check_shapes.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/cpu/numa.hpp>
+#include <list>
 #include <unordered_map>
+#include <mutex>
+#include <sstream>
 #include <dnnl.hpp>
 #include <migraphx/errors.hpp>
 #include <migraphx/assert.hpp>
@@ -44,6 +50,48 @@ dnnl::algorithm to_dnnl_algo(const std::string& name);
 
 std::string to_string(const dnnl::algorithm& algo);
 
+// Keeps the most recently used primitives so compiling many shapes, such as when recompiling for
+// each new input shape, does not keep every primitive alive for the life of the process
+template <class Primitive>
+struct primitive_cache
+{
+    static constexpr std::size_t capacity = 256;
+
+    std::mutex m;
+    std::list<std::pair<std::string, Primitive>> entries;
+    std::unordered_map<std::string, typename decltype(entries)::iterator> index;
+
+    bool find(const std::string& key, Primitive& result)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto it = index.find(key);
+        if(it == index.end())
+            return false;
+        entries.splice(entries.begin(), entries, it->second);
+        result = it->second->second;
+        return true;
+    }
+
+    Primitive insert(const std::string& key, Primitive prim)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto it = index.find(key);
+        if(it != index.end())
+        {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->second;
+        }
+        entries.emplace_front(key, std::move(prim));
+        index.emplace(key, entries.begin());
+        if(entries.size() > capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+        return entries.front().second;
+    }
+};
+
 struct post_op : reflect_equality<post_op>, reflect_stream<post_op>
 {
     std::string algo;
@@ -232,8 +280,34 @@ struct dnnl_op : auto_register_op<Derived>
         auto pd          = self.get_primitive_desc(desc, attr);
         return Primitive(pd);
     }
+    std::string primitive_key(const shape& output_shape, const std::vector<shape>& inputs) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        std::stringstream ss;
+        ss << self.name() << migraphx::to_value(self) << output_shape;
+        for(auto&& input : inputs)
+            ss << input;
+        return ss.str();
+    }
+    // Primitives are cached by the op and its shapes, with the allocation removed from the
+    // inputs, so identical instructions, and repeated calls to compute_shape, compile and
+    // finalize, only create the primitive once
+    Primitive get_primitive(const shape& output_shape, const std::vector<shape>& inputs) const
+    {
+        static primitive_cache<Primitive> cache; // NOLINT
+        auto key = primitive_key(output_shape, inputs);
+        Primitive prim;
+        if(cache.find(key, prim))
+            return prim;
+        // Create the primitive outside of the lock so different primitives can be created in
+        // parallel
+        return cache.insert(key, get_primitive(to_memory_desc(output_shape, inputs)));
+    }
     argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
     {
+        // dnnl runs on the OpenMP pool of the calling thread, which is bound to the node along
+        // with the calling thread
+        numa_thread_binding binding{ctx};
         return execute(ctx, args);
     }
 
@@ -245,8 +319,7 @@ struct dnnl_op : auto_register_op<Derived>
     {
         // Compensate for allocation
         inputs.pop_back();
-        auto md        = to_memory_desc(output_shape, inputs);
-        auto prim      = get_primitive(md);
+        auto prim      = get_primitive(output_shape, inputs);
         auto impl_name = impl(prim);
         return {{"impl", impl_name}};
     }
@@ -258,7 +331,7 @@ struct dnnl_op : auto_register_op<Derived>
         const auto& self = static_cast<const Derived&>(*this);
         auto name        = self.name();
         auto md          = to_memory_desc(output_shape, inputs);
-        auto prim        = get_primitive(md);
+        auto prim        = get_primitive(output_shape, inputs);
         auto arg_lookup  = create_arg_map(inputs.size());
 #ifndef NDEBUG
         auto prim_attr = get_primitive_attr(md);
@@ -365,7 +438,7 @@ struct dnnl_extend_op : dnnl_op<Derived, Primitive>
         self.required(check_shapes(inputs, self));
         auto r = migraphx::compute_shape(op, this->trim_post_op_inputs(inputs));
         // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        this->get_primitive(r, inputs);
         return r;
     }
 };
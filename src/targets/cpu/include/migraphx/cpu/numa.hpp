@@ -0,0 +1,73 @@
+#ifndef MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_NUMA_HPP
+#define MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_NUMA_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+struct literal_store;
+namespace cpu {
+
+struct context;
+
+/// Whether contexts are pinned to NUMA nodes, enabled with MIGRAPHX_CPU_NUMA
+bool numa_enabled();
+
+/// Number of NUMA nodes, read from sysfs. Systems without NUMA information report one node.
+std::size_t numa_node_count();
+
+/// The cpus that belong to a node
+const std::vector<std::size_t>& numa_node_cpus(std::size_t node);
+
+/// Pick the node for a new context, contexts are spread over the nodes in a round-robin order
+int numa_next_node();
+
+/// Node the calling thread has been bound to, or -1 when it isn't bound
+int numa_thread_node();
+
+/// Restrict the calling thread to the cpus of a node, does nothing if it is already bound to it.
+/// The binding is permanent, so this is only for threads MIGraphX creates itself.
+void numa_bind_thread(int node);
+
+/// Binds the calling thread to a node for the lifetime of the object and then restores the
+/// affinity the thread had before, so threads owned by the application are not left pinned.
+/// Parallel regions started in the meantime use at most one thread per cpu of the node. The
+/// threads of the OpenMP pool are kept by the runtime between regions, so they are bound the
+/// first time the calling thread uses the node and stay bound.
+struct numa_thread_binding
+{
+    explicit numa_thread_binding(int node);
+    explicit numa_thread_binding(const context& ctx);
+    numa_thread_binding(const numa_thread_binding&) = delete;
+    numa_thread_binding& operator=(const numa_thread_binding&) = delete;
+    ~numa_thread_binding();
+
+    private:
+    // Large enough for a cpu_set_t
+    std::array<unsigned long, 16> previous_mask{};
+    std::size_t previous_threads = 0;
+    int previous_node            = -1;
+    bool restore                 = false;
+};
+
+/// Run f on a thread bound to the node, so the memory it touches first is allocated on the node
+void numa_run_on_node(int node, const std::function<void()>& f);
+
+/// Node the memory at the address is on, or -1 when it is unknown or not yet allocated
+int numa_node_of(const void* p);
+
+/// Node the data of the argument is on, or -1 when it is unknown
+int numa_node_of(const argument& a);
+
+/// Store used to share literals between programs whose contexts are pinned to the same node
+literal_store& get_numa_literal_store(int node);
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
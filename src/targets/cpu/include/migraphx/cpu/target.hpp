@@ -16,7 +16,8 @@ struct target
 {
     std::string name() const;
     std::vector<pass> get_passes(migraphx::context& gctx, const compile_options&) const;
-    migraphx::context get_context() const { return context{}; }
+    /// With MIGRAPHX_CPU_NUMA each new context is pinned to the next NUMA node
+    migraphx::context get_context() const;
 
     argument copy_to(const argument& arg) const { return arg; }
     argument copy_from(const argument& arg) const { return arg; }
@@ -7,10 +7,16 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 struct module;
+struct literal_store;
 namespace cpu {
 
 struct write_literals
 {
+    /// When set, literal data is shared with identical literals from other programs
+    literal_store* store = nullptr;
+    /// When set, literal data is copied into memory on this NUMA node, and sharing is limited to
+    /// programs pinned to the same node
+    int numa_node = -1;
     std::string name() const { return "cpu::write_literals"; }
     void apply(module& m) const;
 };
@@ -29,6 +29,7 @@
 #include <migraphx/make_op.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/tune_axis.hpp>
+#include <migraphx/match/attention.hpp>
 #include <migraphx/match/layernorm.hpp>
 #include <migraphx/match/gelu_erf.hpp>
 #include <migraphx/match/gelu_tanh.hpp>
@@ -358,6 +359,62 @@ struct cpu_apply
         });
     }
 
+    static instruction_ref skip_broadcast_ops(instruction_ref ins)
+    {
+        while(contains({"broadcast", "multibroadcast", "contiguous"}, ins->name()))
+            ins = ins->inputs().front();
+        return ins;
+    }
+
+    auto fuse_attention()
+    {
+        return match::make_match_finder(match::attention(), [=](auto&, const auto& r) {
+            instruction_ref ins     = r.result;
+            instruction_ref softmax = r.instructions.at("softmax");
+            instruction_ref scores  = r.instructions.at("scores");
+            auto rank               = std::int64_t(softmax->get_shape().lens().size());
+            // The axis may not be normalized yet, such as the onnx default of -1
+            auto axis = softmax->get_operator().to_value()["axis"].to<std::int64_t>();
+            if(axis < 0)
+                axis += rank;
+            if(axis != rank - 1)
+                return;
+            if(scores->get_operator().to_value()["alpha"].to<float>() != 1.0f or
+               ins->get_operator().to_value()["alpha"].to<float>() != 1.0f)
+                return;
+            // Walk back from the softmax to find the optional mask and scale
+            float scale = 1.0f;
+            std::vector<instruction_ref> inputs{
+                r.instructions.at("q"), r.instructions.at("kt"), r.instructions.at("v")};
+            instruction_ref x = softmax->inputs().front();
+            if(x->name() == "add")
+            {
+                auto it = std::find_if(x->inputs().begin(), x->inputs().end(), [&](auto i) {
+                    return i == scores or contains(i->inputs(), scores);
+                });
+                auto mask = it == x->inputs().begin() ? x->inputs().back() : x->inputs().front();
+                inputs.push_back(mask);
+                x = *it;
+            }
+            if(x->name() == "mul" or x->name() == "div")
+            {
+                auto s = skip_broadcast_ops(x->name() == "div" or x->inputs().front() == scores
+                                             ? x->inputs().back()
+                                             : x->inputs().front());
+                if(s->get_shape().elements() != 1)
+                    return;
+                auto a = s->eval();
+                if(a.empty())
+                    return;
+                scale = a.at<float>();
+                if(x->name() == "div")
+                    scale = 1.0f / scale;
+            }
+            inputs.push_back(this->insert_allocation(ins, ins->get_shape()));
+            modl->replace_instruction(ins, make_op("cpu::attention", {{"scale", scale}}), inputs);
+        });
+    }
+
     void init()
     {
         create_output_names();
@@ -391,14 +448,18 @@ struct cpu_apply
 
         extend_op("concat", "dnnl::concat");
         extend_op("contiguous", "dnnl::reorder");
+        extend_op("convert", "cpu::convert");
         extend_op("convolution", "dnnl::convolution");
         extend_op("deconvolution", "dnnl::deconvolution");
+        extend_op("dequantize_dot", "cpu::dequantize_dot");
         extend_op("dot", "dnnl::dot");
         extend_op("erf", "cpu::erf");
         extend_op("gather", "cpu::gather");
         extend_op("logsoftmax", "dnnl::logsoftmax");
         extend_op("lrn", "dnnl::lrn");
+        extend_op("resize", "cpu::resize");
         extend_op("softmax", "dnnl::softmax");
+        extend_op("sparse_dot", "cpu::sparse_dot");
         extend_op("sub", "cpu::sub");
 
         extend_op("im2col", "cpu::im2col", false);
@@ -418,7 +479,8 @@ struct cpu_apply
                             fuse_match(match::gelu_tanh(),
                                        make_op("dnnl::eltwise", {{"algo", "eltwise_gelu_tanh"}}),
                                        {"x"}),
-                            fuse_match(match::layernorm(), make_op("dnnl::layernorm"), {"x"}));
+                            fuse_match(match::layernorm(), make_op("dnnl::layernorm"), {"x"}),
+                            fuse_attention());
         // Apply these operators first so the inputs can be const folded
         for(auto it : iterator_for(*modl))
         {
@@ -455,8 +517,9 @@ struct cpu_apply
     {
         auto&& op = ins->get_operator();
         auto v    = op.to_value();
+        // dnnl only pools over up to 3 spatial dimensions
         if(has_op("dnnl::pooling") and ins->get_shape().type() == shape::type_t::float_type and
-           not v["ceil_mode"].to<bool>())
+           ins->get_shape().lens().size() <= 5 and not v["ceil_mode"].to<bool>())
             return replace(ins, make_op("dnnl::pooling", op.to_value()));
         std::string mode = v["mode"].to<std::string>();
         if(mode == "max")
@@ -0,0 +1,229 @@
+#include <migraphx/cpu/numa.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/cpu/parallel.hpp>
+#include <migraphx/literal_store.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/env.hpp>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <thread>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_NUMA)
+
+bool numa_enabled() { return enabled(MIGRAPHX_CPU_NUMA{}); }
+
+// Parse a cpu list such as "0-3,8-11"
+static std::vector<std::size_t> parse_cpu_list(const std::string& s)
+{
+    std::vector<std::size_t> result;
+    for(auto&& r : split_string(trim(s), ','))
+    {
+        if(r.empty())
+            continue;
+        auto bounds = split_string(r, '-');
+        auto first  = std::stoul(bounds.front());
+        auto last   = std::stoul(bounds.back());
+        for(auto i = first; i <= last; i++)
+            result.push_back(i);
+    }
+    return result;
+}
+
+static std::vector<std::vector<std::size_t>> find_numa_nodes()
+{
+    std::vector<std::vector<std::size_t>> nodes;
+    const fs::path root{"/sys/devices/system/node"};
+    for(std::size_t i = 0;; i++)
+    {
+        std::ifstream is{(root / ("node" + std::to_string(i)) / "cpulist").string()};
+        if(not is)
+            break;
+        std::string line;
+        std::getline(is, line);
+        nodes.push_back(parse_cpu_list(line));
+    }
+    if(nodes.empty())
+    {
+        nodes.emplace_back(std::max(1u, std::thread::hardware_concurrency()));
+        std::iota(nodes.front().begin(), nodes.front().end(), 0);
+    }
+    return nodes;
+}
+
+static const std::vector<std::vector<std::size_t>>& numa_nodes()
+{
+    static const auto nodes = find_numa_nodes(); // NOLINT
+    return nodes;
+}
+
+std::size_t numa_node_count() { return numa_nodes().size(); }
+
+const std::vector<std::size_t>& numa_node_cpus(std::size_t node)
+{
+    if(node >= numa_node_count())
+        MIGRAPHX_THROW("Invalid NUMA node: " + std::to_string(node));
+    return numa_nodes()[node];
+}
+
+int numa_next_node()
+{
+    static std::atomic<std::size_t> next{0}; // NOLINT
+    return next++ % numa_node_count();
+}
+
+static int& thread_node()
+{
+    thread_local int node = -1;
+    return node;
+}
+
+int numa_thread_node() { return thread_node(); }
+
+void numa_bind_thread(int node)
+{
+    if(node < 0 or thread_node() == node)
+        return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(auto cpu : numa_node_cpus(node))
+    {
+        if(cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &set);
+    }
+    // Binding is only a hint for locality, so the thread still runs if it fails
+    sched_setaffinity(0, sizeof(set), &set);
+    thread_node() = node;
+}
+
+// Node the OpenMP pool of the calling thread has been bound to
+static int& pool_node()
+{
+    thread_local int node = -1;
+    return node;
+}
+
+// The OpenMP runtime keeps the threads of a pool alive between parallel regions, so they only
+// need to be bound once. The first thread of the team is the calling thread, which is left to
+// numa_thread_binding so its affinity can be restored.
+static void numa_bind_pool(int node, std::size_t threads)
+{
+    if(pool_node() == node)
+        return;
+#ifndef MIGRAPHX_DISABLE_OMP
+#pragma omp parallel num_threads(threads)
+    {
+        if(omp_get_thread_num() != 0)
+            numa_bind_thread(node);
+    }
+#else
+    (void)threads;
+#endif
+    pool_node() = node;
+}
+
+static_assert(sizeof(cpu_set_t) <= sizeof(std::array<unsigned long, 16>),
+              "cpu_set_t does not fit the saved mask");
+
+numa_thread_binding::numa_thread_binding(int node) : previous_node(thread_node())
+{
+    if(node < 0)
+        return;
+    // Parallel regions started by the calling thread use at most one thread per cpu of the node
+    previous_threads = max_threads();
+    auto threads     = std::min(previous_threads, numa_node_cpus(node).size());
+#ifndef MIGRAPHX_DISABLE_OMP
+    omp_set_num_threads(static_cast<int>(threads));
+#endif
+    numa_bind_pool(node, threads);
+    if(previous_node == node)
+        return;
+    auto* mask = reinterpret_cast<cpu_set_t*>(previous_mask.data());
+    // Without the previous mask the thread could not be restored, so it is left unbound
+    if(sched_getaffinity(0, sizeof(cpu_set_t), mask) != 0)
+        return;
+    numa_bind_thread(node);
+    restore = true;
+}
+
+numa_thread_binding::numa_thread_binding(const context& ctx) : numa_thread_binding(ctx.numa_node)
+{
+}
+
+numa_thread_binding::~numa_thread_binding()
+{
+#ifndef MIGRAPHX_DISABLE_OMP
+    if(previous_threads > 0)
+        omp_set_num_threads(static_cast<int>(previous_threads));
+#endif
+    if(not restore)
+        return;
+    sched_setaffinity(0, sizeof(cpu_set_t), reinterpret_cast<cpu_set_t*>(previous_mask.data()));
+    thread_node() = previous_node;
+}
+
+void numa_run_on_node(int node, const std::function<void()>& f)
+{
+    if(node < 0)
+    {
+        f();
+        return;
+    }
+    std::exception_ptr error;
+    std::thread t{[&] {
+        try
+        {
+            numa_bind_thread(node);
+            f();
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+    }};
+    t.join();
+    if(error)
+        std::rethrow_exception(error);
+}
+
+int numa_node_of(const void* p)
+{
+    if(p == nullptr)
+        return -1;
+    static const auto page_size = sysconf(_SC_PAGESIZE);
+    void* page = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(p) & ~(page_size - 1));
+    int status = -1;
+    // Without target nodes move_pages only queries the node of each page
+    if(syscall(SYS_move_pages, 0, 1, &page, nullptr, &status, 0) != 0 or status < 0)
+        return -1;
+    return status;
+}
+
+int numa_node_of(const argument& a)
+{
+    if(a.empty())
+        return -1;
+    return numa_node_of(a.data());
+}
+
+literal_store& get_numa_literal_store(int node)
+{
+    static std::vector<literal_store> stores(numa_node_count()); // NOLINT
+    if(node < 0)
+        return get_literal_store();
+    return stores.at(node);
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
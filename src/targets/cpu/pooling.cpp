@@ -6,6 +6,10 @@
 #include <migraphx/cpu/context.hpp>
 #include <migraphx/cpu/dnnl.hpp>
 #include <migraphx/op/pooling.hpp>
+#include <array>
+#include <numeric>
+#include <type_traits>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -14,19 +18,27 @@ namespace cpu {
 struct max_pool
 {
     static std::string name() { return "max"; }
+
+    template <class T>
+    using acc_type = T;
+
     template <class T>
     static T start()
     {
         return std::numeric_limits<T>::lowest();
     }
 
-    static double apply(double x, double y)
+    template <class T, class U>
+    static T apply(T x, U y)
     {
-        double m = std::max(x, y);
-        return (m);
+        return std::max(x, T(y));
     }
 
-    static double final(double x, std::size_t) { return (x); }
+    template <class T>
+    static T final(T x, std::size_t)
+    {
+        return x;
+    }
 };
 
 struct avg_pool
@@ -34,16 +46,106 @@ struct avg_pool
     static std::string name() { return "average"; }
 
     template <class T>
-    static double start()
+    using acc_type =
+        std::conditional_t<std::is_integral<T>{} or std::is_same<T, double>{}, double, float>;
+
+    template <class T>
+    static T start()
     {
-        return 0.0;
+        return T(0);
     }
 
-    static double apply(double x, double y) { return x + y; }
+    template <class T, class U>
+    static T apply(T x, U y)
+    {
+        return x + T(y);
+    }
 
-    static double final(double x, std::size_t y) { return (y == 0) ? 0.0 : (x / y); }
+    template <class T>
+    static T final(T x, std::size_t y)
+    {
+        return (y == 0) ? T(0) : T(x / y);
+    }
 };
 
+template <std::size_t N, class F>
+void for_each_tap(std::integral_constant<std::size_t, N>,
+                  const std::array<std::size_t, N>&,
+                  const std::array<std::size_t, N>&,
+                  const std::array<std::size_t, N>&,
+                  std::size_t offset,
+                  F f)
+{
+    f(offset);
+}
+
+template <std::size_t D, std::size_t N, class F>
+void for_each_tap(std::integral_constant<std::size_t, D>,
+                  const std::array<std::size_t, N>& start,
+                  const std::array<std::size_t, N>& end,
+                  const std::array<std::size_t, N>& strides,
+                  std::size_t offset,
+                  F f)
+{
+    for(auto i = start[D]; i < end[D]; i++)
+        for_each_tap(std::integral_constant<std::size_t, D + 1>{},
+                     start,
+                     end,
+                     strides,
+                     offset + i * strides[D],
+                     f);
+}
+
+// Visit every offset of the input in the window, with the last dimension in the inner loop
+template <std::size_t N, class F>
+void for_each_tap(const std::array<std::size_t, N>& start,
+                  const std::array<std::size_t, N>& end,
+                  const std::array<std::size_t, N>& strides,
+                  F f)
+{
+    for_each_tap(std::integral_constant<std::size_t, 0>{}, start, end, strides, 0, f);
+}
+
+// Visit every offset of the input in the window for any number of dimensions
+template <class F>
+void for_each_tap(const std::vector<std::size_t>& start,
+                  const std::vector<std::size_t>& end,
+                  const std::vector<std::size_t>& strides,
+                  F f)
+{
+    if(not std::equal(start.begin(), start.end(), end.begin(), std::less<>{}))
+        return;
+    auto idx      = start;
+    std::size_t d = 0;
+    do
+    {
+        f(std::inner_product(idx.begin(), idx.end(), strides.begin(), std::size_t{0}));
+        for(d = idx.size(); d > 0; d--)
+        {
+            if(++idx[d - 1] < end[d - 1])
+                break;
+            idx[d - 1] = start[d - 1];
+        }
+    } while(d > 0);
+}
+
+// The loops over the window are unrolled for up to 3 spatial dimensions, and other ranks are
+// passed as a number to loop over any number of dimensions
+template <class F>
+void visit_pooling_rank(std::size_t n, F f)
+{
+    switch(n)
+    {
+    case 1: f(std::integral_constant<std::size_t, 1>{}); break;
+    case 2: f(std::integral_constant<std::size_t, 2>{}); break;
+    case 3: f(std::integral_constant<std::size_t, 3>{}); break;
+    default: f(n); break;
+    }
+}
+
+// Number of channels accumulated together when the input is channels last
+constexpr std::size_t channel_block = 64;
+
 template <class Op>
 struct cpu_pooling : auto_register_op<cpu_pooling<Op>>
 {
@@ -71,48 +173,121 @@ struct cpu_pooling : auto_register_op<cpu_pooling<Op>>
         return shapes.size() - 1;
     }
 
-    argument compute(context&, const shape& output_shape, std::vector<argument> args) const
+    template <std::size_t N, class T>
+    static std::array<std::size_t, N> spatial(std::integral_constant<std::size_t, N>, const T& x)
     {
-        visit_all(args.back(), args[0])([&](auto output, auto input) {
-            using type   = typename decltype(output)::value_type;
-            auto in_s    = input.get_shape();
-            auto in_lens = in_s.lens();
-            std::vector<std::size_t> vec_len(in_lens.begin() + 2, in_lens.end());
-
-            par_for(output_shape.elements(), [&](auto i) {
-                auto idx_o = output_shape.multi(i);
-                auto n_dim = idx_o.size();
-                std::vector<std::size_t> win_start;
-                std::vector<std::size_t> win_size;
-                for(std::size_t dim = 2; dim < n_dim; ++dim)
+        std::array<std::size_t, N> result;
+        std::copy(x.begin() + 2, x.begin() + 2 + N, result.begin());
+        return result;
+    }
+
+    template <class T>
+    static std::vector<std::size_t> spatial(std::size_t, const T& x)
+    {
+        return {x.begin() + 2, x.end()};
+    }
+
+    template <class Rank, class Output, class Input>
+    void pool(context& ctx, Rank rank, const shape& output_shape, Output output, Input input) const
+    {
+        using type     = typename Output::value_type;
+        using acc_type = typename Op::template acc_type<type>;
+        const auto& in_s = input.get_shape();
+        auto batch       = in_s.lens()[0];
+        auto channels    = in_s.lens()[1];
+        auto in_lens     = spatial(rank, in_s.lens());
+        auto in_strides  = spatial(rank, in_s.strides());
+        auto out_lens    = spatial(rank, output_shape.lens());
+        auto out_strides = spatial(rank, output_shape.strides());
+        auto in_nstride  = in_s.strides()[0];
+        auto in_cstride  = in_s.strides()[1];
+        auto out_nstride = output_shape.strides()[0];
+        auto out_cstride = output_shape.strides()[1];
+        auto positions   = std::accumulate(
+            out_lens.begin(), out_lens.end(), std::size_t{1}, std::multiplies<>{});
+        const auto* in_ptr = input.data();
+        auto* out_ptr      = output.data();
+
+        // Compute the window of the output position j, clipped to the input, and returns the
+        // offset of the output position
+        auto get_window = [&](std::size_t j, auto& start, auto& end) {
+            std::size_t offset = 0;
+            for(std::size_t d = in_lens.size(); d > 0; d--)
+            {
+                auto i = d - 1;
+                auto o = j % out_lens[i];
+                j /= out_lens[i];
+                auto s = std::ptrdiff_t(o * op.stride[i]) - std::ptrdiff_t(op.padding[i]);
+                auto e = std::min<std::ptrdiff_t>(s + op.lengths[i], in_lens[i]);
+                start[i] = std::max<std::ptrdiff_t>(s, 0);
+                end[i]   = std::max<std::ptrdiff_t>(e, start[i]);
+                offset += o * out_strides[i];
+            }
+            return offset;
+        };
+        auto window_size = [&](const auto& start, const auto& end) {
+            std::size_t result = 1;
+            for(std::size_t i = 0; i < start.size(); i++)
+                result *= end[i] - start[i];
+            return result;
+        };
+
+        if(in_cstride == 1 and channels > 1)
+        {
+            // Channels last: accumulate a block of contiguous channels for every tap, which also
+            // parallelizes global pooling across the channels
+            auto cblocks = (channels + channel_block - 1) / channel_block;
+            ctx.bulk_execute(batch * positions * cblocks, 1, [&](auto first, auto last) {
+                auto start = in_lens;
+                auto end   = in_lens;
+                std::array<acc_type, channel_block> acc;
+                for(auto w = first; w < last; w++)
                 {
-                    auto d_2  = dim - 2;
-                    int start = static_cast<int>(idx_o[dim] * op.stride[d_2]) -
-                                static_cast<int>(op.padding[d_2]);
-                    int end = std::min(start + op.lengths[d_2], in_lens[dim]);
-                    start   = std::max(start, 0);
-                    win_start.push_back(start);
-                    win_size.push_back(end - start);
+                    auto c0     = (w % cblocks) * channel_block;
+                    auto nc     = std::min(channel_block, channels - c0);
+                    auto j      = (w / cblocks) % positions;
+                    auto n      = w / (cblocks * positions);
+                    auto offset = get_window(j, start, end);
+                    const auto* x = in_ptr + n * in_nstride + c0;
+                    std::fill(acc.begin(), acc.end(), Op::template start<acc_type>());
+                    for_each_tap(start, end, in_strides, [&](auto k) {
+                        for(std::size_t c = 0; c < nc; c++)
+                            acc[c] = Op::apply(acc[c], x[k + c]);
+                    });
+                    auto count = window_size(start, end);
+                    auto* y    = out_ptr + n * out_nstride + c0 * out_cstride + offset;
+                    for(std::size_t c = 0; c < nc; c++)
+                        y[c * out_cstride] = type(Op::final(acc[c], count));
                 }
+            });
+        }
+        else
+        {
+            ctx.bulk_execute(batch * channels * positions, 256, [&](auto first, auto last) {
+                auto start = in_lens;
+                auto end   = in_lens;
+                for(auto w = first; w < last; w++)
+                {
+                    auto j      = w % positions;
+                    auto c      = (w / positions) % channels;
+                    auto n      = w / (positions * channels);
+                    auto offset = get_window(j, start, end);
+                    const auto* x = in_ptr + n * in_nstride + c * in_cstride;
+                    auto acc      = Op::template start<acc_type>();
+                    for_each_tap(
+                        start, end, in_strides, [&](auto k) { acc = Op::apply(acc, x[k]); });
+                    out_ptr[n * out_nstride + c * out_cstride + offset] =
+                        type(Op::final(acc, window_size(start, end)));
+                }
+            });
+        }
+    }
 
-                shape win_shape{output_shape.type(), win_size};
-                auto pool_size = win_shape.elements();
-                double acc     = Op::template start<type>();
-                shape_for_each(win_shape, [&](auto idx_w) {
-                    auto idx = idx_o;
-                    std::transform(idx_w.begin(),
-                                   idx_w.end(),
-                                   win_start.begin(),
-                                   idx.begin() + 2,
-                                   [](auto ii, auto jj) { return ii + jj; });
-                    if(std::all_of(idx.begin() + 2, idx.end(), [&](auto ii) { return ii >= 0; }) and
-                       idx < in_lens)
-                    {
-                        acc = Op::apply(acc, input[in_s.index(idx)]);
-                    }
-                });
-
-                output[i] = type(Op::final(acc, pool_size));
+    argument compute(context& ctx, const shape& output_shape, std::vector<argument> args) const
+    {
+        visit_all(args.back(), args[0])([&](auto output, auto input) {
+            visit_pooling_rank(output_shape.lens().size() - 2, [&](auto rank) {
+                this->pool(ctx, rank, output_shape, output, input);
             });
         });
 
@@ -4,11 +4,15 @@
 #include <migraphx/context.hpp>
 #include <migraphx/cpu/context.hpp>
 #include <migraphx/register_op.hpp>
+#include <migraphx/env.hpp>
+#include <iostream>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_NUMA)
+
 struct cpu_preallocate : auto_register_op<cpu_preallocate>
 {
     shape s;
@@ -28,7 +32,15 @@ struct cpu_preallocate : auto_register_op<cpu_preallocate>
         return s;
     }
     argument compute(context&, const shape&, const std::vector<argument>&) const { return data; }
-    void finalize(context&, const shape&, const std::vector<shape>&) { data = argument(s); }
+    void finalize(context& ctx, const shape&, const std::vector<shape>&)
+    {
+        // The buffer is zeroed when allocated, so allocating it from a thread on the node places
+        // the scratch memory there
+        numa_run_on_node(ctx.numa_node, [&] { data = argument(s); });
+        if(enabled(MIGRAPHX_TRACE_NUMA{}))
+            std::cout << name() << "[" << id << "]: " << s.bytes() << " bytes on node "
+                      << numa_node_of(data) << std::endl;
+    }
     lifetime get_lifetime() const { return lifetime::global; }
 };
 
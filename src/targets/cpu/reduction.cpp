@@ -22,16 +22,17 @@ struct dnnl_reduction : dnnl_op<dnnl_reduction, dnnl::reduction>
     {
         // Compensate for allocation
         inputs.pop_back();
-        check_shapes{this->trim_post_op_inputs(inputs), *this}.has(1).standard();
+        check_shapes{this->trim_post_op_inputs(inputs), *this}.has(1).packed();
         auto s    = inputs.at(0);
         auto lens = s.lens();
         for(auto axis : axes)
         {
             lens[axis] = 1;
         }
-        auto r = shape{s.type(), lens};
+        // The output uses the same layout as the input
+        auto r = s.with_lens(lens);
         // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        this->get_primitive(r, inputs);
         return r;
     }
 
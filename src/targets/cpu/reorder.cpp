@@ -15,8 +15,9 @@ struct dnnl_reorder : dnnl_op<dnnl_reorder, dnnl::reorder>
     {
         check_shapes{inputs, *this}.has(2);
         auto r = inputs.back();
-        // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        // Call to get_primitive to make sure an algo is available, without the allocation so
+        // the primitive is reused by compile and finalize
+        this->get_primitive(r, {inputs.front()});
         return r;
     }
     // Custom desc class since its missing in dnnl
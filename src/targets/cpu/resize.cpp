@@ -0,0 +1,142 @@
+#include <migraphx/config.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/reflect.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/op/resize.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+/**
+ * Computes a resize a row at a time. The input rows used by each output row and their weights
+ * come from the taps of the outer dimensions, and each row is interpolated along the last
+ * dimension with the taps stored a tap at a time, so the inner loops read the indices and
+ * weights contiguously and can be vectorized.
+ */
+struct cpu_resize : auto_register_op<cpu_resize>
+{
+    op::resize op;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+
+    std::string name() const { return "cpu::resize"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        check_shapes{inputs, *this}.has(1).standard().min_ndims(1);
+        return op.compute_shape(inputs);
+    }
+
+    argument
+    // cppcheck-suppress constParameter
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        const auto& in_shape = args[0].get_shape();
+        const auto& out_lens = output_shape.lens();
+        auto taps            = op.compute_taps(in_shape.lens());
+        auto ndim            = taps.size();
+        auto out_w           = out_lens.back();
+        auto rows            = output_shape.elements() / out_w;
+        const auto& xt       = taps.back();
+
+        std::vector<std::size_t> xindex(xt.count * out_w);
+        std::vector<float> xweight(xt.count * out_w);
+        for(std::size_t x = 0; x < out_w; x++)
+        {
+            for(std::size_t j = 0; j < xt.count; j++)
+            {
+                xindex[j * out_w + x]  = xt.index[x * xt.count + j];
+                xweight[j * out_w + x] = xt.weight[x * xt.count + j];
+            }
+        }
+
+        visit_all(args.back(), args[0])([&](auto output, auto input) {
+            const auto* in_ptr = input.data();
+            auto* out_ptr      = output.data();
+            auto grain         = std::max<std::size_t>(1, 1024 / out_w);
+            ctx.bulk_execute(rows, grain, [&](auto start, auto end) {
+                std::vector<float> acc(out_w);
+                std::vector<std::size_t> out_idx(ndim - 1);
+                std::vector<std::size_t> k(ndim - 1);
+                std::vector<std::pair<std::size_t, float>> in_rows;
+                for(auto r = start; r < end; r++)
+                {
+                    for(std::size_t d = ndim - 1, q = r; d > 0; d--)
+                    {
+                        out_idx[d - 1] = q % out_lens[d - 1];
+                        q /= out_lens[d - 1];
+                    }
+                    // Find the input rows for every combination of the taps in the outer
+                    // dimensions
+                    in_rows.clear();
+                    std::fill(k.begin(), k.end(), 0);
+                    for(;;)
+                    {
+                        std::size_t offset = 0;
+                        float w            = 1;
+                        for(std::size_t d = 0; d + 1 < ndim; d++)
+                        {
+                            auto t = out_idx[d] * taps[d].count + k[d];
+                            offset += taps[d].index[t] * in_shape.strides()[d];
+                            w *= taps[d].weight[t];
+                        }
+                        if(w != 0)
+                            in_rows.emplace_back(offset, w);
+                        std::size_t d = ndim - 1;
+                        while(d > 0 and ++k[d - 1] == taps[d - 1].count)
+                            k[--d] = 0;
+                        if(d == 0)
+                            break;
+                    }
+
+                    auto* out_row = out_ptr + r * out_w;
+                    if(xt.count == 1 and in_rows.size() == 1 and in_rows.front().second == 1)
+                    {
+                        const auto* in_row = in_ptr + in_rows.front().first;
+                        for(std::size_t x = 0; x < out_w; x++)
+                            out_row[x] = in_row[xindex[x]];
+                        continue;
+                    }
+                    std::fill(acc.begin(), acc.end(), 0.0f);
+                    for(const auto& row : in_rows)
+                    {
+                        const auto* in_row = in_ptr + row.first;
+                        for(std::size_t j = 0; j < xt.count; j++)
+                        {
+                            const auto* index = xindex.data() + j * out_w;
+                            const auto* w     = xweight.data() + j * out_w;
+                            for(std::size_t x = 0; x < out_w; x++)
+                                acc[x] += row.second * w[x] * float(in_row[index[x]]);
+                        }
+                    }
+                    for(std::size_t x = 0; x < out_w; x++)
+                        out_row[x] = acc[x];
+                }
+            });
+        });
+
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
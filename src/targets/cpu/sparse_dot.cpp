@@ -0,0 +1,118 @@
+#include <migraphx/config.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/reflect.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/op/sparse_dot.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+// When there are fewer rows of a than this, K is split into parts that are summed afterwards,
+// where each part has at least min_part_k rows of the weights
+constexpr std::size_t max_parts  = 16;
+constexpr std::size_t min_part_k = 64;
+
+/**
+ * Computes a dot with block-sparse weights one row of a at a time. For each value of the row,
+ * the stored blocks of the matching row of the weights are scaled and added to an accumulator
+ * for the output row, so only the stored weights are read, and each block is added with a
+ * contiguous loop that can be vectorized. Zeros in a are skipped, which also skips their blocks.
+ */
+struct cpu_sparse_dot : auto_register_op<cpu_sparse_dot>
+{
+    op::sparse_dot op;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+
+    std::string name() const { return "cpu::sparse_dot"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        return op.compute_shape(inputs);
+    }
+
+    argument
+    // cppcheck-suppress constParameter
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        auto k              = args[0].get_shape().lens().back();
+        auto n              = op.n;
+        auto bs             = op.block_size;
+        auto rows           = output_shape.elements() / n;
+        auto npad           = (n + bs - 1) / bs * bs;
+        auto parts          = std::max<std::size_t>(1, std::min(k / min_part_k, max_parts / rows));
+        auto kpart          = (k + parts - 1) / parts;
+        const auto* values  = args[1].cast<float>();
+        const auto* columns = args[2].cast<std::int32_t>();
+        const auto* offsets = args[3].cast<std::int32_t>();
+        std::vector<float> partial(parts > 1 ? rows * parts * npad : 0);
+
+        visit_all(args.back(), args[0])([&](auto output, auto a) {
+            const auto* a_ptr = a.data();
+            auto* out_ptr     = output.data();
+            ctx.bulk_execute(rows * parts, 1, [&](auto start, auto end) {
+                std::vector<float> acc(npad);
+                for(auto t = start; t < end; t++)
+                {
+                    auto r    = t / parts;
+                    auto part = t % parts;
+                    std::fill(acc.begin(), acc.end(), 0.0f);
+                    auto kend = std::min(k, (part + 1) * kpart);
+                    for(auto j = part * kpart; j < kend; j++)
+                    {
+                        float x = a_ptr[r * k + j];
+                        if(x == 0)
+                            continue;
+                        for(auto b = offsets[j]; b < offsets[j + 1]; b++)
+                        {
+                            auto* dst       = acc.data() + columns[b] * bs;
+                            const auto* src = values + b * bs;
+                            for(std::size_t c = 0; c < bs; c++)
+                                dst[c] += x * src[c];
+                        }
+                    }
+                    if(parts == 1)
+                        std::copy(acc.begin(), acc.begin() + n, out_ptr + r * n);
+                    else
+                        std::copy(acc.begin(), acc.end(), partial.begin() + t * npad);
+                }
+            });
+            if(parts == 1)
+                return;
+            for(std::size_t r = 0; r < rows; r++)
+            {
+                for(std::size_t c = 0; c < n; c++)
+                {
+                    float sum = 0;
+                    for(std::size_t part = 0; part < parts; part++)
+                        sum += partial[(r * parts + part) * npad + c];
+                    out_ptr[r * n + c] = sum;
+                }
+            }
+        });
+
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -9,8 +9,10 @@
 #include <migraphx/eliminate_concat.hpp>
 #include <migraphx/eliminate_contiguous.hpp>
 #include <migraphx/eliminate_data_type.hpp>
+#include <migraphx/eliminate_duplicate_literals.hpp>
 #include <migraphx/eliminate_identity.hpp>
 #include <migraphx/eliminate_pad.hpp>
+#include <migraphx/inplace_write_slice.hpp>
 #include <migraphx/memory_coloring.hpp>
 #include <migraphx/propagate_constant.hpp>
 #include <migraphx/register_target.hpp>
@@ -24,12 +26,14 @@
 #include <migraphx/simplify_algebra.hpp>
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/preallocate_param.hpp>
+#include <migraphx/cpu/compile_ops.hpp>
 #include <migraphx/cpu/fuse_ops.hpp>
 #include <migraphx/cpu/write_literals.hpp>
 #include <migraphx/cpu/allocation_model.hpp>
 #include <migraphx/cpu/target.hpp>
 #include <migraphx/cpu/context.hpp>
 #include <migraphx/cpu/lowering.hpp>
+#include <migraphx/cpu/numa.hpp>
 #include <migraphx/pass.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/normalize_ops.hpp>
@@ -41,7 +45,7 @@ namespace cpu {
 std::string target::name() const { return "cpu"; }
 
 // cppcheck-suppress constParameter
-std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_options&) const
+std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_options& options) const
 {
     auto& ctx = any_cast<context>(gctx);
     std::set<shape::type_t> unsupported_types(shape::types().begin(), shape::types().end());
@@ -68,8 +72,11 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             simplify_algebra{},
             auto_contiguous{},
             simplify_reshapes{},
-            propagate_constant{},
+            propagate_constant{options.fold_cache},
             dead_code_elimination{},
+            eliminate_duplicate_literals{},
+            dead_code_elimination{},
+            inplace_write_slice{},
             lowering{},
             eliminate_contiguous{"dnnl::reorder"},
             dead_code_elimination{},
@@ -77,12 +84,21 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             fuse_ops{&ctx},
             dead_code_elimination{},
-            write_literals{},
+            write_literals{nullptr, ctx.numa_node},
             dead_code_elimination{},
             memory_coloring{"cpu::allocate"},
             dead_code_elimination{},
             preallocate_param{"scratch", cpu_allocation_model{}},
-            dead_code_elimination{}};
+            dead_code_elimination{},
+            compile_ops{&gctx}};
+}
+
+migraphx::context target::get_context() const
+{
+    context ctx;
+    if(numa_enabled())
+        ctx.numa_node = numa_next_node();
+    return ctx;
 }
 
 argument target::allocate(const shape& s) const { return fill_argument(s, 0); }
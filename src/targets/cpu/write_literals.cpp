@@ -2,11 +2,22 @@
 #include <migraphx/module.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/iterator_for.hpp>
+#include <migraphx/literal_store.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/cpu/numa.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_SHARE_LITERALS)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_DUPLICATE_LITERALS)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_NUMA)
+
 struct cpu_literal
 {
     argument data;
@@ -30,13 +41,54 @@ struct cpu_literal
     }
 };
 
+// Copy the data into a new buffer allocated by the calling thread
+static argument copy_literal(const literal& l)
+{
+    if(l.empty())
+        return l.get_argument();
+    argument a{l.get_shape()};
+    std::memcpy(a.data(), l.data(), l.get_shape().bytes());
+    return a;
+}
+
 void write_literals::apply(module& m) const
 {
+    auto* s = store;
+    if(s == nullptr and enabled(MIGRAPHX_CPU_SHARE_LITERALS{}))
+        s = &get_numa_literal_store(numa_node);
+    std::vector<instruction_ref> literals;
     for(auto ins : iterator_for(m))
     {
-        if(ins->name() != "@literal")
-            continue;
-        m.replace_instruction(ins, cpu_literal{ins->get_literal().get_argument()});
+        if(ins->name() == "@literal")
+            literals.push_back(ins);
+    }
+    std::vector<argument> data(literals.size());
+    std::size_t saved = 0;
+    // The buffers are written from a thread on the node so their pages are allocated there
+    numa_run_on_node(numa_node, [&] {
+        std::transform(literals.begin(), literals.end(), data.begin(), [&](auto ins) {
+            const auto& l = ins->get_literal();
+            if(s == nullptr)
+                return numa_node < 0 ? l.get_argument() : copy_literal(l);
+            auto before = s->bytes_saved();
+            auto a      = s->insert(l);
+            saved += s->bytes_saved() - before;
+            return a;
+        });
+    });
+    for(std::size_t i = 0; i < literals.size(); i++)
+        m.replace_instruction(literals[i], cpu_literal{data[i]});
+    if(enabled(MIGRAPHX_TRACE_DUPLICATE_LITERALS{}) and s != nullptr)
+        std::cout << m.name() << ": shared " << saved << " bytes of literals, "
+                  << s->bytes_saved() << " bytes saved in the store" << std::endl;
+    if(enabled(MIGRAPHX_TRACE_NUMA{}))
+    {
+        std::map<int, std::size_t> bytes;
+        for(auto&& a : data)
+            bytes[numa_node_of(a)] += a.get_shape().bytes();
+        for(auto&& p : bytes)
+            std::cout << m.name() << ": " << p.second << " bytes of literals on node " << p.first
+                      << std::endl;
     }
 }
 
@@ -32,6 +32,8 @@
 #include <unordered_map>
 #include <utility>
 #include <iostream>
+#include <array>
+#include <type_traits>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -189,6 +191,92 @@ auto visit_quantize(T&& x, Ts&&... xs)
     };
 }
 
+// Returns a pointer to the data packed in the standard layout, copying into the buffer when the
+// tensor is not standard
+template <class T>
+const T* standard_data(tensor_view<T> x, std::vector<std::remove_cv_t<T>>& buffer)
+{
+    if(x.get_shape().standard())
+        return x.data();
+    shape s{x.get_shape().type(), x.get_shape().lens()};
+    buffer.resize(s.elements());
+    shape_for_each(x.get_shape(),
+                   [&](const auto& idx) { buffer[s.index(idx)] = x(idx.begin(), idx.end()); });
+    return buffer.data();
+}
+
+// Computes, for a kernel position and a range of positions of iter_lens, the offset of the
+// position within a plane of target_lens that the kernel touches, or -1 when it falls in the
+// padding. The offsets are computed for a chunk at a time so they don't need to be stored for
+// the whole plane.
+struct window_offsets
+{
+    template <class Op>
+    window_offsets(const Op& op,
+                   const std::vector<std::size_t>& iter_lens,
+                   const std::vector<std::size_t>& kernel_lens,
+                   const std::vector<std::size_t>& target_lens)
+        : iter_s(shape::float_type, iter_lens),
+          kernel_s(shape::float_type, kernel_lens),
+          target_s(shape::float_type, target_lens),
+          stride(op.stride.begin(), op.stride.end()),
+          dilation(op.dilation.begin(), op.dilation.end()),
+          padding(op.padding.begin(), op.padding.end())
+    {
+    }
+
+    std::size_t kernel_size() const { return kernel_s.elements(); }
+
+    // Writes the offsets of kernel position k for the n positions starting at p0
+    void compute(std::size_t k, std::size_t p0, std::size_t n, std::ptrdiff_t* out) const
+    {
+        if(n == 0)
+            return;
+        auto kidx  = kernel_s.multi(k);
+        auto o     = iter_s.multi(p0);
+        auto ndims = o.size();
+        for(std::size_t i = 0; i < n; i++)
+        {
+            std::ptrdiff_t offset = 0;
+            for(std::size_t d = 0; d < ndims; d++)
+            {
+                auto x = std::ptrdiff_t(o[d] * stride[d] + kidx[d] * dilation[d]) -
+                         std::ptrdiff_t(padding[d]);
+                if(x < 0 or x >= std::ptrdiff_t(target_s.lens()[d]))
+                {
+                    offset = -1;
+                    break;
+                }
+                offset += x * target_s.strides()[d];
+            }
+            out[i] = offset;
+            // Move to the next position
+            for(auto d = ndims; d > 0; d--)
+            {
+                if(++o[d - 1] < iter_s.lens()[d - 1])
+                    break;
+                o[d - 1] = 0;
+            }
+        }
+    }
+
+    private:
+    shape iter_s;
+    shape kernel_s;
+    shape target_s;
+    std::vector<std::size_t> stride;
+    std::vector<std::size_t> dilation;
+    std::vector<std::size_t> padding;
+};
+
+// Number of output positions computed together by a thread
+constexpr std::size_t conv_block = 256;
+// Number of im2col elements unfolded at a time, so large images don't need a column buffer for
+// every output position
+constexpr std::size_t conv_col_budget = std::size_t{1} << 20;
+
+// Convolution computed as im2col followed by a gemm. Every output element is accumulated by a
+// single thread in a fixed order, so the result does not depend on the number of threads.
 template <class Op>
 struct ref_convolution : auto_register_op<ref_convolution<Op>>
 {
@@ -213,62 +301,117 @@ struct ref_convolution : auto_register_op<ref_convolution<Op>>
     {
         argument result{output_shape};
         visit_quantize(result, args[0], args[1])([&](auto output, auto input, auto weights) {
-            auto in_lens = input.get_shape().lens();
-
+            using in_type  = std::remove_cv_t<typename decltype(input)::value_type>;
+            using wei_type = std::remove_cv_t<typename decltype(weights)::value_type>;
+            std::vector<in_type> in_buffer;
+            std::vector<wei_type> wei_buffer;
+            const auto* in_ptr  = standard_data(input, in_buffer);
+            const auto* wei_ptr = standard_data(weights, wei_buffer);
+            auto* out_ptr       = output.data();
+
+            auto in_lens  = input.get_shape().lens();
             auto wei_lens = weights.get_shape().lens();
-            auto wei_n    = wei_lens[0];
-            auto wei_c    = wei_lens[1];
-            std::vector<std::size_t> win_size(wei_lens.begin() + 1, wei_lens.end());
-
-            par_for(output_shape.elements(), [&](auto i) {
-                auto idx_o = output_shape.multi(i);
-                auto w     = idx_o[1];
-                auto n_dim = idx_o.size();
-
-                std::vector<std::ptrdiff_t> win_start;
-                for(std::size_t dim = 2; dim < n_dim; ++dim)
+            auto out_lens = output_shape.lens();
+            std::vector<std::size_t> in_spatial(in_lens.begin() + 2, in_lens.end());
+            std::vector<std::size_t> kernel(wei_lens.begin() + 2, wei_lens.end());
+            std::vector<std::size_t> out_spatial(out_lens.begin() + 2, out_lens.end());
+            window_offsets offsets{op, out_spatial, kernel, in_spatial};
+
+            std::size_t batch    = in_lens[0];
+            std::size_t in_c     = in_lens[1];
+            std::size_t wei_n    = wei_lens[0];
+            std::size_t wei_c    = wei_lens[1];
+            std::size_t groups   = op.group;
+            std::size_t m_group  = wei_n / groups;
+            std::size_t in_plane = input.get_shape().elements() / (batch * in_c);
+            std::size_t npos     = output_shape.elements() / (batch * wei_n);
+            std::size_t ksize    = offsets.kernel_size();
+            std::size_t kdim     = wei_c * ksize;
+            std::size_t pblocks  = (npos + conv_block - 1) / conv_block;
+
+            auto gemm_block = [&](std::size_t n, std::size_t m, std::size_t pb, auto get_col) {
+                std::array<double, conv_block> acc{};
+                auto p0 = pb * conv_block;
+                auto np = std::min(conv_block, npos - p0);
+                for(std::size_t k = 0; k < kdim; k++)
                 {
-                    auto d_2 = dim - 2;
-                    win_start.push_back(std::ptrdiff_t(idx_o[dim] * op.stride[d_2]) -
-                                        std::ptrdiff_t(op.padding[d_2]));
+                    double w = wei_ptr[m * kdim + k];
+                    const auto* c = get_col(k, p0);
+                    for(std::size_t j = 0; j < np; j++)
+                        acc[j] += w * double(c[j]);
                 }
-                const auto group_id = w / (wei_n / op.group);
-
-                shape win_shape{output_shape.type(), win_size};
+                auto* y = out_ptr + (n * wei_n + m) * npos + p0;
+                std::copy(acc.begin(), acc.begin() + np, y);
+            };
 
-                double acc = 0.0;
-                shape_for_each(win_shape, [&](auto idx_win) {
-                    auto k           = idx_win[0];
-                    const auto in_ch = group_id * wei_c + k;
-                    std::vector<std::ptrdiff_t> idx(idx_o.begin(), idx_o.end());
-                    idx[1] = in_ch;
-                    std::transform(idx_win.begin() + 1,
-                                   idx_win.end(),
-                                   win_start.begin(),
-                                   idx.begin() + 2,
-                                   [](std::ptrdiff_t ii, std::ptrdiff_t jj) { return ii + jj; });
-                    std::vector<std::ptrdiff_t> idx_wei(idx_o.size());
-                    idx_wei[0] = w;
-                    std::copy(idx_win.begin(), idx_win.end(), idx_wei.begin() + 1);
-                    if(std::all_of(idx.begin() + 2, idx.end(), [&](auto ii) { return ii >= 0; }) and
-                       std::equal(idx.begin(),
-                                  idx.end(),
-                                  in_lens.begin(),
-                                  in_lens.end(),
-                                  std::less<std::ptrdiff_t>{}))
+            if(wei_c == 1)
+            {
+                // Depthwise: every output channel only reads one input channel, so the window is
+                // read directly from the input
+                par_for(batch * wei_n * pblocks, 1, [&](auto i) {
+                    auto pb = i % pblocks;
+                    auto m  = (i / pblocks) % wei_n;
+                    auto n  = i / (pblocks * wei_n);
+                    const auto* x = in_ptr + (n * in_c + m / m_group) * in_plane;
+                    std::array<double, conv_block> acc{};
+                    std::array<std::ptrdiff_t, conv_block> koff{};
+                    auto p0 = pb * conv_block;
+                    auto np = std::min(conv_block, npos - p0);
+                    for(std::size_t k = 0; k < ksize; k++)
                     {
-                        acc +=
-                            input(idx.begin(), idx.end()) * weights(idx_wei.begin(), idx_wei.end());
+                        double w = wei_ptr[m * ksize + k];
+                        offsets.compute(k, p0, np, koff.data());
+                        for(std::size_t j = 0; j < np; j++)
+                        {
+                            if(koff[j] >= 0)
+                                acc[j] += w * double(x[koff[j]]);
+                        }
                     }
+                    auto* y = out_ptr + (n * wei_n + m) * npos + p0;
+                    std::copy(acc.begin(), acc.begin() + np, y);
                 });
+                return;
+            }
 
-                output[i] = acc;
-            });
+            std::size_t chunk =
+                conv_block * std::max<std::size_t>(1, conv_col_budget / (kdim * conv_block));
+            std::vector<in_type> col(kdim * std::min(chunk, npos));
+            std::vector<std::ptrdiff_t> chunk_offsets(ksize * std::min(chunk, npos));
+            for(std::size_t c0 = 0; c0 < npos; c0 += chunk)
+            {
+                auto cn = std::min(chunk, npos - c0);
+                auto b0 = c0 / conv_block;
+                auto nb = (cn + conv_block - 1) / conv_block;
+                par_for(ksize, 1, [&](auto k) {
+                    offsets.compute(k, c0, cn, chunk_offsets.data() + k * cn);
+                });
+                for(std::size_t n = 0; n < batch; n++)
+                {
+                    for(std::size_t g = 0; g < groups; g++)
+                    {
+                        const auto* x = in_ptr + (n * in_c + g * wei_c) * in_plane;
+                        par_for(kdim, 1, [&](auto k) {
+                            const auto* xc   = x + (k / ksize) * in_plane;
+                            const auto* koff = chunk_offsets.data() + (k % ksize) * cn;
+                            auto* c          = col.data() + k * cn;
+                            for(std::size_t p = 0; p < cn; p++)
+                                c[p] = koff[p] < 0 ? in_type(0) : xc[koff[p]];
+                        });
+                        par_for(m_group * nb, 1, [&](auto i) {
+                            gemm_block(n, g * m_group + i / nb, b0 + i % nb, [&](auto k, auto p) {
+                                return col.data() + k * cn + (p - c0);
+                            });
+                        });
+                    }
+                }
+            }
         });
         return result;
     }
 };
 
+// Deconvolution computed as a gemm followed by col2im. Every output channel is accumulated by a
+// single thread in a fixed order, so the result does not depend on the number of threads.
 template <class Op>
 struct ref_deconvolution : auto_register_op<ref_deconvolution<Op>>
 {
@@ -291,72 +434,75 @@ struct ref_deconvolution : auto_register_op<ref_deconvolution<Op>>
         argument result{output_shape};
         visit_all(result, args[0], args[1])([&](auto output, auto input, auto weights) {
             using type = typename decltype(output)::value_type;
+            std::vector<type> in_buffer;
+            std::vector<type> wei_buffer;
+            const auto* in_ptr  = standard_data(input, in_buffer);
+            const auto* wei_ptr = standard_data(weights, wei_buffer);
+            auto* out_ptr       = output.data();
 
             std::fill(output.begin(), output.end(), type{0});
 
-            auto in_lens = input.get_shape().lens();
-            auto in_n    = in_lens[0];
-            auto in_c    = in_lens[1];
-
-            auto wei   = weights.get_shape().lens();
-            auto wei_n = wei[0];
-            auto wei_c = wei[1];
-
+            auto in_lens  = input.get_shape().lens();
+            auto wei_lens = weights.get_shape().lens();
             auto out_lens = output_shape.lens();
-            auto kdims    = op.kdims();
-
-            std::vector<std::size_t> win_size{in_c};
-            std::copy(in_lens.begin() + 2, in_lens.end(), std::back_inserter(win_size));
-            std::copy(wei.begin() + 2, wei.end(), std::back_inserter(win_size));
-            shape win_shape{output_shape.type(), win_size};
-
-            par_dfor(in_n, wei_c)([&](int o, int k) {
-
-                shape_for_each(win_shape, [&](auto idx_win) {
-                    const int w = idx_win[0];
-
-                    auto input_dims_start = idx_win.begin() + 1;
-                    auto wei_dims_start   = idx_win.begin() + kdims + 1;
-
-                    std::vector<std::ptrdiff_t> win_start;
-                    for(std::size_t n = 0; n < kdims; ++n)
-                    {
-                        win_start.push_back(std::ptrdiff_t(*(input_dims_start + n) * op.stride[n]) -
-                                            std::ptrdiff_t(op.padding[n]));
-                    }
-
-                    const int group_id = w / (wei_n / op.group);
-                    const int in_ch    = group_id * wei_c + k;
-
-                    std::vector<std::ptrdiff_t> idx_out{o, in_ch};
-
-                    for(size_t n = 0; n < kdims; n++)
-                    {
-                        idx_out.push_back(win_start[n] + *(wei_dims_start + n) * op.dilation[n]);
-                    }
-
-                    std::vector<std::ptrdiff_t> idx_wei{w, k};
-                    std::copy(wei_dims_start, idx_win.end(), std::back_inserter(idx_wei));
-
-                    std::vector<std::ptrdiff_t> idx_in{o, w};
-                    std::copy(input_dims_start, wei_dims_start, std::back_inserter(idx_in));
-
-                    if(std::all_of(
-                           idx_out.begin() + 2, idx_out.end(), [&](auto ii) { return ii >= 0; }) and
-                       std::equal(idx_out.begin() + 2,
-                                  idx_out.end(),
-                                  out_lens.begin() + 2,
-                                  out_lens.end(),
-                                  std::less<std::ptrdiff_t>{}))
+            std::vector<std::size_t> in_spatial(in_lens.begin() + 2, in_lens.end());
+            std::vector<std::size_t> kernel(wei_lens.begin() + 2, wei_lens.end());
+            std::vector<std::size_t> out_spatial(out_lens.begin() + 2, out_lens.end());
+            window_offsets offsets{op, in_spatial, kernel, out_spatial};
+
+            std::size_t batch     = in_lens[0];
+            std::size_t in_c      = in_lens[1];
+            std::size_t wei_c     = wei_lens[1];
+            std::size_t out_c     = out_lens[1];
+            std::size_t groups    = op.group;
+            std::size_t c_group   = in_c / groups;
+            std::size_t in_plane  = input.get_shape().elements() / (batch * in_c);
+            std::size_t out_plane = output_shape.elements() / (batch * out_c);
+            std::size_t ksize     = offsets.kernel_size();
+            std::size_t kdim      = wei_c * ksize;
+            std::size_t chunk     = std::max<std::size_t>(1, conv_col_budget / kdim);
+
+            std::vector<double> col(kdim * std::min(chunk, in_plane));
+            std::vector<std::ptrdiff_t> chunk_offsets(ksize * std::min(chunk, in_plane));
+            for(std::size_t c0 = 0; c0 < in_plane; c0 += chunk)
+            {
+                auto cn = std::min(chunk, in_plane - c0);
+                par_for(ksize, 1, [&](auto k) {
+                    offsets.compute(k, c0, cn, chunk_offsets.data() + k * cn);
+                });
+                for(std::size_t n = 0; n < batch; n++)
+                {
+                    for(std::size_t g = 0; g < groups; g++)
                     {
-                        output(idx_out.begin(), idx_out.end()) +=
-                            input(idx_in.begin(), idx_in.end()) *
-                            weights(idx_wei.begin(), idx_wei.end());
+                        // col = transpose(weights) * input for the channels of the group
+                        par_for(kdim, 1, [&](auto k) {
+                            auto* c = col.data() + k * cn;
+                            std::fill(c, c + cn, 0.0);
+                            for(std::size_t w = g * c_group; w < (g + 1) * c_group; w++)
+                            {
+                                double wk     = wei_ptr[w * kdim + k];
+                                const auto* x = in_ptr + (n * in_c + w) * in_plane + c0;
+                                for(std::size_t p = 0; p < cn; p++)
+                                    c[p] += wk * double(x[p]);
+                            }
+                        });
+                        // Scatter the columns into the output
+                        par_for(wei_c, 1, [&](auto oc) {
+                            auto* y = out_ptr + (n * out_c + g * wei_c + oc) * out_plane;
+                            for(std::size_t k = 0; k < ksize; k++)
+                            {
+                                const auto* c    = col.data() + (oc * ksize + k) * cn;
+                                const auto* koff = chunk_offsets.data() + k * cn;
+                                for(std::size_t p = 0; p < cn; p++)
+                                {
+                                    if(koff[p] >= 0)
+                                        y[koff[p]] += c[p];
+                                }
+                            }
+                        });
                     }
-                });
-
-            });
-
+                }
+            }
         });
         return result;
     }
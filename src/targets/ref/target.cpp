@@ -7,6 +7,7 @@
 #include <migraphx/rewrite_rnn.hpp>
 #include <migraphx/eliminate_pad.hpp>
 #include <migraphx/insert_pad.hpp>
+#include <migraphx/inplace_write_slice.hpp>
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/normalize_ops.hpp>
@@ -28,6 +29,7 @@ std::vector<pass> target::get_passes(migraphx::context&, const compile_options&)
             dead_code_elimination{},
             auto_contiguous{},
             dead_code_elimination{},
+            inplace_write_slice{},
             lowering{},
             dead_code_elimination{}};
 }
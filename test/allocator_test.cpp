@@ -0,0 +1,125 @@
+#include <migraphx/allocator.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/literal.hpp>
+#include <cstdint>
+#include <sstream>
+#include "test.hpp"
+
+struct counting_allocator
+{
+    std::shared_ptr<std::size_t> allocated   = std::make_shared<std::size_t>(0);
+    std::shared_ptr<std::size_t> deallocated = std::make_shared<std::size_t>(0);
+
+    std::string name() const { return "counting_allocator"; }
+    char* allocate(std::size_t bytes) const
+    {
+        (*allocated)++;
+        return migraphx::aligned_allocator{}.allocate(bytes);
+    }
+    void deallocate(char* p, std::size_t bytes) const
+    {
+        (*deallocated)++;
+        migraphx::aligned_allocator{}.deallocate(p, bytes);
+    }
+};
+
+// Restores the previous allocator at the end of the test
+struct allocator_guard
+{
+    migraphx::allocator previous = migraphx::get_allocator();
+    allocator_guard(migraphx::allocator a) { migraphx::set_allocator(std::move(a)); }
+    ~allocator_guard() { migraphx::set_allocator(previous); }
+};
+
+bool is_aligned(const void* p, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+TEST_CASE(argument_alignment)
+{
+    for(std::size_t n : {1, 3, 17, 1000})
+    {
+        migraphx::argument a{{migraphx::shape::float_type, {n}}};
+        EXPECT(is_aligned(a.data(), 64));
+        EXPECT(a.get_shape().bytes() == n * 4);
+    }
+    migraphx::literal l{migraphx::shape{migraphx::shape::int8_type, {3}}, {1, 2, 3}};
+    EXPECT(is_aligned(l.data(), 64));
+    EXPECT(is_aligned(l.get_argument().data(), 64));
+}
+
+TEST_CASE(argument_zero_initialized)
+{
+    migraphx::argument a{{migraphx::shape::int32_type, {64}}};
+    a.visit([](auto v) { EXPECT(std::all_of(v.begin(), v.end(), [](auto x) { return x == 0; })); });
+}
+
+TEST_CASE(custom_allocator)
+{
+    counting_allocator ca;
+    {
+        allocator_guard g{ca};
+        EXPECT(migraphx::get_allocator().name() == "counting_allocator");
+        migraphx::argument a{{migraphx::shape::float_type, {8}}};
+        migraphx::literal l{1.0f};
+        EXPECT(*ca.allocated == 2);
+        EXPECT(*ca.deallocated == 0);
+    }
+    EXPECT(*ca.deallocated == 2);
+}
+
+TEST_CASE(buffer_outlives_allocator)
+{
+    counting_allocator ca;
+    std::shared_ptr<char> buffer;
+    {
+        allocator_guard g{ca};
+        buffer = migraphx::allocate_buffer(16);
+    }
+    EXPECT(migraphx::get_allocator().name() == "aligned_allocator");
+    EXPECT(*ca.deallocated == 0);
+    buffer.reset();
+    EXPECT(*ca.deallocated == 1);
+}
+
+TEST_CASE(allocation_stats)
+{
+    auto before = migraphx::get_allocation_stats();
+    {
+        auto buffer = migraphx::allocate_buffer(1024);
+        auto during = migraphx::get_allocation_stats();
+        EXPECT(during.allocations == before.allocations + 1);
+        EXPECT(during.bytes_in_use == before.bytes_in_use + 1024);
+        EXPECT(during.peak_bytes >= during.bytes_in_use);
+    }
+    auto after = migraphx::get_allocation_stats();
+    EXPECT(after.deallocations == before.deallocations + 1);
+    EXPECT(after.bytes_in_use == before.bytes_in_use);
+    EXPECT(after.total_bytes == before.total_bytes + 1024);
+    std::stringstream ss;
+    ss << after;
+    EXPECT(not ss.str().empty());
+}
+
+TEST_CASE(huge_pages)
+{
+    // Explicit huge pages fall back to default pages when none are reserved
+    for(auto pages : {migraphx::huge_pages::transparent, migraphx::huge_pages::explicit_pages})
+    {
+        migraphx::aligned_allocator a{64, pages, 1024 * 1024};
+        std::size_t n = 3 * 1024 * 1024;
+        auto* p       = a.allocate(n);
+        EXPECT(p != nullptr);
+        EXPECT(is_aligned(p, pages == migraphx::huge_pages::transparent ? n / 3 : 4096));
+        p[0]     = 1;
+        p[n - 1] = 1;
+        a.deallocate(p, n);
+        // Small buffers are not rounded up to huge pages
+        auto* q = a.allocate(100);
+        EXPECT(is_aligned(q, 64));
+        a.deallocate(q, 100);
+    }
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
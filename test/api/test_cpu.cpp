@@ -1,5 +1,6 @@
 #include <migraphx/migraphx.h>
 #include <migraphx/migraphx.hpp>
+#include <atomic>
 #include "test.hpp"
 
 TEST_CASE(load_and_run)
@@ -41,6 +42,36 @@ TEST_CASE(load_and_run_init_list)
     CHECK(bool{shapes_before.front() == outputs.front().get_shape()});
 }
 
+TEST_CASE(run_queue)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    p.compile(migraphx::target("ref"));
+    migraphx::program_parameters pp;
+    auto param_shapes = p.get_parameter_shapes();
+    for(auto&& name : param_shapes.names())
+    {
+        pp.add(name, migraphx::argument::generate(param_shapes[name]));
+    }
+    auto expected = p.eval(pp);
+    std::atomic<int> completed{0};
+    {
+        migraphx::run_queue q{p, 2, 4};
+        std::vector<migraphx::run_request> requests;
+        for(int i = 0; i < 4; i++)
+            requests.push_back(q.submit(pp, {}, [&](migraphx_run_status s) {
+                if(s == migraphx_run_completed)
+                    completed++;
+            }));
+        for(auto&& r : requests)
+        {
+            auto outputs = r.get();
+            CHECK(r.done());
+            CHECK(bool{outputs.front() == expected.front()});
+        }
+    }
+    CHECK(completed == 4);
+}
+
 TEST_CASE(quantize_fp16)
 {
     auto p1        = migraphx::parse_onnx("gemm_ex_test.onnx");
@@ -155,6 +186,17 @@ TEST_CASE(strided_shape)
     EXPECT(s.strides() == strides);
 }
 
+TEST_CASE(dlpack_roundtrip)
+{
+    std::vector<float> data = {1, 2, 3, 4};
+    auto s                  = migraphx::shape(migraphx_shape_float_type, {2, 2});
+    auto a                  = migraphx::argument(s, data.data());
+    auto b                  = migraphx::argument::from_dlpack(a.to_dlpack());
+    EXPECT(b.data() == a.data());
+    EXPECT(b.get_shape().lengths() == s.lengths());
+    EXPECT(bool{a == b});
+}
+
 TEST_CASE(get_main_module)
 {
     auto p              = migraphx::parse_onnx("constant_fill_test.onnx");
@@ -0,0 +1,51 @@
+#include <migraphx/run_queue.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/cpu/target.hpp>
+#include <algorithm>
+#include "test.hpp"
+
+// The intermediate results are kept in the scratch memory of the program
+migraphx::program create_program(const migraphx::shape& s)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", s);
+    auto y   = mm->add_parameter("y", s);
+    auto add = mm->add_instruction(migraphx::make_op("add"), x, y);
+    auto mul = mm->add_instruction(migraphx::make_op("mul"), add, x);
+    mm->add_instruction(migraphx::make_op("sub"), mul, y);
+    p.compile(migraphx::cpu::target{});
+    return p;
+}
+
+TEST_CASE(run_queue_workers)
+{
+    migraphx::shape s{migraphx::shape::float_type, {64, 64}};
+    const std::size_t n = 32;
+    std::vector<std::vector<float>> xs(n);
+    std::vector<std::vector<float>> ys(n);
+    migraphx::run_queue q{create_program(s), {4, n}};
+    std::vector<migraphx::run_request> requests;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        xs[i] = std::vector<float>(s.elements(), i);
+        ys[i] = std::vector<float>(s.elements(), i + 1);
+        requests.push_back(q.submit({{"x", migraphx::argument{s, xs[i].data()}},
+                                     {"y", migraphx::argument{s, ys[i].data()}}}));
+    }
+    for(std::size_t i = 0; i < n; i++)
+    {
+        auto results = requests[i].get();
+        EXPECT(results.size() == 1);
+        float x        = i;
+        float y        = i + 1;
+        float expected = (x + y) * x - y;
+        results.front().visit([&](auto output) {
+            EXPECT(std::all_of(
+                output.begin(), output.end(), [&](float z) { return z == expected; }));
+        });
+    }
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
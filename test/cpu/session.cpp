@@ -0,0 +1,63 @@
+#include <migraphx/session.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/cpu/target.hpp>
+#include <migraphx/half.hpp>
+#include "test.hpp"
+
+std::vector<float> to_vector(const migraphx::argument& a)
+{
+    std::vector<float> result;
+    a.visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    return result;
+}
+
+// The cpu target only computes in float, so the half cache must still be appended to in place
+migraphx::program create_cache_program(migraphx::shape::type_t t)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{t, {1, 4, 2}};
+    migraphx::shape ks{t, {1, 1, 2}};
+    migraphx::shape ps{migraphx::shape::int64_type, {1}};
+    auto cache = mm->add_parameter("cache", cs);
+    auto key   = mm->add_parameter("key", ks);
+    auto pos   = mm->add_parameter("pos", ps);
+    auto one   = mm->add_literal(migraphx::literal{ps, {1}});
+
+    auto kv = mm->add_instruction(migraphx::make_op("write_slice", {{"axis", 1}}), cache, key, pos);
+
+    auto sum  = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), kv);
+    auto next = mm->add_instruction(migraphx::make_op("add"), pos, one);
+    mm->add_return({sum, next});
+    p.compile(migraphx::cpu::target{});
+    return p;
+}
+
+void run_cache(migraphx::shape::type_t t)
+{
+    migraphx::session sess{create_cache_program(t)};
+    sess.add_state("cache");
+    sess.add_state("pos", 1);
+
+    migraphx::shape ks{t, {1, 1, 2}};
+    std::vector<std::vector<float>> keys = {{1, 2}, {3, 4}, {5, 6}};
+    std::vector<float> sum;
+    for(const auto& k : keys)
+    {
+        migraphx::argument key{ks};
+        key.visit([&](auto v) { std::copy(k.begin(), k.end(), v.begin()); });
+        auto results = sess.eval({{"key", key}});
+        EXPECT(results.size() == 2);
+        sum = to_vector(results.front());
+    }
+    EXPECT(sum == std::vector<float>{9, 12});
+    EXPECT(to_vector(sess.get_state("pos")) == std::vector<float>{3});
+    EXPECT(to_vector(sess.get_state("cache")) == std::vector<float>{1, 2, 3, 4, 5, 6, 0, 0});
+}
+
+TEST_CASE(session_cache_float) { run_cache(migraphx::shape::float_type); }
+
+TEST_CASE(session_cache_half) { run_cache(migraphx::shape::half_type); }
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,103 @@
+#include <migraphx/dlpack.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/shape.hpp>
+#include <numeric>
+#include <vector>
+#include "test.hpp"
+
+TEST_CASE(dlpack_export)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}, {1, 2}};
+    std::vector<float> data(6);
+    std::iota(data.begin(), data.end(), 0);
+    migraphx::argument a{s, data.data()};
+    auto* t = migraphx::to_dlpack(a);
+    EXPECT(t->dl_tensor.data == data.data());
+    EXPECT(t->dl_tensor.ndim == 2);
+    EXPECT(t->dl_tensor.dtype.code == migraphx::dlpack::float_code);
+    EXPECT(t->dl_tensor.dtype.bits == 32);
+    EXPECT(t->dl_tensor.ctx.device_type == migraphx::dlpack::cpu);
+    EXPECT(std::vector<int64_t>(t->dl_tensor.shape, t->dl_tensor.shape + 2) ==
+           std::vector<int64_t>{2, 3});
+    EXPECT(std::vector<int64_t>(t->dl_tensor.strides, t->dl_tensor.strides + 2) ==
+           std::vector<int64_t>{1, 2});
+    t->deleter(t);
+}
+
+TEST_CASE(dlpack_export_owned)
+{
+    migraphx::shape s{migraphx::shape::int32_type, {4}};
+    migraphx::dlpack::managed_tensor* t = nullptr;
+    {
+        migraphx::argument a{s};
+        a.visit([](auto v) { std::iota(v.begin(), v.end(), 1); });
+        t = migraphx::to_dlpack(a);
+    }
+    // The tensor keeps the data alive after the argument is destroyed
+    const auto* p = static_cast<const int32_t*>(t->dl_tensor.data);
+    EXPECT(std::vector<int32_t>(p, p + 4) == std::vector<int32_t>{1, 2, 3, 4});
+    t->deleter(t);
+}
+
+TEST_CASE(dlpack_roundtrip)
+{
+    migraphx::shape s{migraphx::shape::half_type, {2, 2}};
+    migraphx::argument a{s};
+    auto b = migraphx::from_dlpack(migraphx::to_dlpack(a));
+    EXPECT(b.get_shape() == s);
+    EXPECT(b.data() == a.data());
+}
+
+TEST_CASE(dlpack_import)
+{
+    std::vector<uint8_t> data = {1, 2, 3, 4, 5, 6, 7};
+    std::vector<int64_t> lens = {2, 3};
+    bool deleted              = false;
+    migraphx::dlpack::managed_tensor t{};
+    t.dl_tensor.data        = data.data();
+    t.dl_tensor.ctx         = {migraphx::dlpack::cpu, 0};
+    t.dl_tensor.ndim        = 2;
+    t.dl_tensor.dtype       = {migraphx::dlpack::uint_code, 8, 1};
+    t.dl_tensor.shape       = lens.data();
+    t.dl_tensor.strides     = nullptr;
+    t.dl_tensor.byte_offset = 1;
+    t.manager_ctx           = &deleted;
+    t.deleter               = [](migraphx::dlpack::managed_tensor* self) {
+        *static_cast<bool*>(self->manager_ctx) = true;
+    };
+    {
+        auto a = migraphx::from_dlpack(&t);
+        EXPECT(a.get_shape() == migraphx::shape{migraphx::shape::uint8_type, {2, 3}});
+        EXPECT(a.data() == reinterpret_cast<char*>(data.data() + 1));
+        auto b = a; // NOLINT
+        a      = migraphx::argument{};
+        EXPECT(not deleted);
+    }
+    EXPECT(deleted);
+}
+
+TEST_CASE(dlpack_import_scalar)
+{
+    double x = 3.0;
+    migraphx::dlpack::managed_tensor t{};
+    t.dl_tensor.data  = &x;
+    t.dl_tensor.ctx   = {migraphx::dlpack::cpu, 0};
+    t.dl_tensor.ndim  = 0;
+    t.dl_tensor.dtype = {migraphx::dlpack::float_code, 64, 1};
+    auto a            = migraphx::from_dlpack(&t);
+    EXPECT(a.get_shape() == migraphx::shape{migraphx::shape::double_type});
+    EXPECT(a.at<double>() == 3.0);
+}
+
+TEST_CASE(dlpack_import_device)
+{
+    float x = 0;
+    migraphx::dlpack::managed_tensor t{};
+    t.dl_tensor.data  = &x;
+    t.dl_tensor.ctx   = {2, 0};
+    t.dl_tensor.ndim  = 0;
+    t.dl_tensor.dtype = {migraphx::dlpack::float_code, 32, 1};
+    EXPECT(test::throws([&] { migraphx::from_dlpack(&t); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,106 @@
+#include <migraphx/dynamic_batcher.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/ref/target.hpp>
+#include <sstream>
+#include "test.hpp"
+
+migraphx::program create_program(std::size_t batch)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {batch, 3}};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_parameter("y", s);
+    mm->add_instruction(migraphx::make_op("add"), x, y);
+    p.compile(migraphx::ref::target{});
+    return p;
+}
+
+std::vector<float> to_vector(const migraphx::argument& a)
+{
+    std::vector<float> result;
+    a.visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    return result;
+}
+
+TEST_CASE(dynamic_batcher_submit)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 3}};
+    std::vector<std::vector<float>> xs;
+    for(int i = 0; i < 10; i++)
+        xs.push_back({float(i), float(i + 1), float(i + 2)});
+    std::vector<float> y = {1, 1, 1};
+    migraphx::dynamic_batcher_stats stats;
+    {
+        migraphx::dynamic_batcher b{create_program(4), {std::chrono::milliseconds{50}, 0}};
+        EXPECT(b.batch_size() == 4);
+        std::vector<std::future<std::vector<migraphx::argument>>> results;
+        for(auto&& x : xs)
+            results.push_back(b.submit(
+                {{"x", migraphx::argument{s, x.data()}}, {"y", migraphx::argument{s, y.data()}}}));
+        for(std::size_t i = 0; i < results.size(); i++)
+        {
+            auto outputs = results[i].get();
+            EXPECT(outputs.size() == 1);
+            EXPECT(outputs.front().get_shape() == s);
+            EXPECT(to_vector(outputs.front()) ==
+                   std::vector<float>{xs[i][0] + 1, xs[i][1] + 1, xs[i][2] + 1});
+        }
+        stats = b.stats();
+    }
+    EXPECT(stats.requests == 10);
+    EXPECT(stats.batches >= 3);
+    EXPECT(stats.average_batch_size() > 1);
+    std::stringstream ss;
+    ss << stats;
+    EXPECT(not ss.str().empty());
+}
+
+TEST_CASE(dynamic_batcher_max_batch)
+{
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    std::vector<float> x = {1, 2, 3};
+    migraphx::dynamic_batcher b{create_program(8), {std::chrono::milliseconds{50}, 2}};
+    migraphx::parameter_map sample = {{"x", migraphx::argument{s, x.data()}},
+                                      {"y", migraphx::argument{s, x.data()}}};
+    auto r1                        = b.submit(sample);
+    auto r2                        = b.submit(sample);
+    EXPECT(to_vector(r1.get().front()) == std::vector<float>{2, 4, 6});
+    EXPECT(to_vector(r2.get().front()) == std::vector<float>{2, 4, 6});
+    EXPECT(b.stats().batches == 1);
+}
+
+TEST_CASE(dynamic_batcher_missing_parameter)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 3}};
+    std::vector<float> x = {1, 2, 3};
+    migraphx::dynamic_batcher b{create_program(2), {std::chrono::microseconds{0}, 0}};
+    auto r = b.submit({{"x", migraphx::argument{s, x.data()}}});
+    EXPECT(test::throws([&] { r.get(); }));
+}
+
+TEST_CASE(dynamic_batcher_bad_request)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 3}};
+    migraphx::shape bad{migraphx::shape::float_type, {1, 4}};
+    std::vector<float> x = {1, 2, 3, 4};
+    migraphx::dynamic_batcher b{create_program(2), {std::chrono::milliseconds{50}, 0}};
+    auto r1 = b.submit({{"x", migraphx::argument{bad, x.data()}},
+                        {"y", migraphx::argument{s, x.data()}}});
+    auto r2 = b.submit({{"x", migraphx::argument{s, x.data()}},
+                        {"y", migraphx::argument{s, x.data()}}});
+    EXPECT(test::throws([&] { r1.get(); }));
+    EXPECT(to_vector(r2.get().front()) == std::vector<float>{2, 4, 6});
+    EXPECT(b.stats().requests == 1);
+}
+
+TEST_CASE(dynamic_batcher_no_batch)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    mm->add_literal(1.0f);
+    EXPECT(test::throws([&] { migraphx::dynamic_batcher{p}; }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -68,4 +68,80 @@ TEST_CASE(quant)
     EXPECT(mm1 == mm2);
 }
 
+TEST_CASE(fixed_type_inputs)
+{
+    migraphx::shape as{migraphx::shape::half_type, {2, 4}};
+    migraphx::shape ws{migraphx::shape::half_type, {3, 4}};
+    migraphx::shape ss{migraphx::shape::float_type, {3, 1}};
+    migraphx::module mm1;
+    {
+        auto a = mm1.add_parameter("a", as);
+        auto w = mm1.add_parameter("w", ws);
+        auto s = mm1.add_parameter("s", ss);
+        mm1.add_instruction(migraphx::make_op("dequantize_dot", {{"bits", 16}}), a, w, s);
+    }
+    run_pass(mm1, {migraphx::shape::half_type});
+
+    migraphx::module mm2;
+    {
+        auto a      = mm2.add_parameter("a", as);
+        auto w      = mm2.add_parameter("w", ws);
+        auto s      = mm2.add_parameter("s", ss);
+        auto floata = mm2.add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::float_type}}), a);
+        auto dot = mm2.add_instruction(
+            migraphx::make_op("dequantize_dot", {{"bits", 16}}), floata, w, s);
+        mm2.add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::half_type}}), dot);
+    }
+    EXPECT(mm1 == mm2);
+}
+
+TEST_CASE(fixed_type_inputs_int8)
+{
+    migraphx::shape as{migraphx::shape::half_type, {2, 4}};
+    migraphx::shape ws{migraphx::shape::int8_type, {3, 4}};
+    migraphx::shape ss{migraphx::shape::float_type, {3, 1}};
+    migraphx::module mm1;
+    {
+        auto a = mm1.add_parameter("a", as);
+        auto w = mm1.add_parameter("w", ws);
+        auto s = mm1.add_parameter("s", ss);
+        mm1.add_instruction(migraphx::make_op("dequantize_dot"), a, w, s);
+    }
+    run_pass(mm1, {migraphx::shape::half_type, migraphx::shape::int8_type});
+
+    migraphx::module mm2;
+    {
+        auto a      = mm2.add_parameter("a", as);
+        auto w      = mm2.add_parameter("w", ws);
+        auto s      = mm2.add_parameter("s", ss);
+        auto floata = mm2.add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::float_type}}), a);
+        auto dot = mm2.add_instruction(migraphx::make_op("dequantize_dot"), floata, w, s);
+        mm2.add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::half_type}}), dot);
+    }
+    EXPECT(mm1 == mm2);
+}
+
+TEST_CASE(fixed_type_inputs_write_slice)
+{
+    migraphx::shape cs{migraphx::shape::half_type, {1, 4, 2}};
+    migraphx::shape ks{migraphx::shape::half_type, {1, 1, 2}};
+    migraphx::shape ps{migraphx::shape::int64_type, {1}};
+    auto create_module = [&] {
+        migraphx::module m;
+        auto cache = m.add_parameter("cache", cs);
+        auto key   = m.add_parameter("key", ks);
+        auto pos   = m.add_parameter("pos", ps);
+        m.add_instruction(migraphx::make_op("write_slice", {{"axis", 1}}), cache, key, pos);
+        return m;
+    };
+    auto mm1 = create_module();
+    run_pass(mm1, {migraphx::shape::half_type, migraphx::shape::int64_type});
+    // The cache is updated in place so it must not be converted
+    EXPECT(mm1 == create_module());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,104 @@
+#include <migraphx/eliminate_duplicate_literals.hpp>
+#include <migraphx/literal_store.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/instruction.hpp>
+#include <basic_ops.hpp>
+#include <migraphx/make_op.hpp>
+
+#include <test.hpp>
+
+void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(
+        m, {migraphx::eliminate_duplicate_literals{}, migraphx::dead_code_elimination{}});
+}
+
+TEST_CASE(duplicate_literals)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    std::vector<float> data = {1, 2, 3, 4, 5, 6};
+    migraphx::module m1;
+    {
+        auto l1  = m1.add_literal(migraphx::literal{s, data});
+        auto l2  = m1.add_literal(migraphx::literal{s, data});
+        auto sum = m1.add_instruction(migraphx::make_op("add"), l1, l2);
+        m1.add_instruction(pass_op{}, sum);
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto l1  = m2.add_literal(migraphx::literal{s, data});
+        auto sum = m2.add_instruction(migraphx::make_op("add"), l1, l1);
+        m2.add_instruction(pass_op{}, sum);
+    }
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(different_literals)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::module m1;
+    {
+        auto l1  = m1.add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+        auto l2  = m1.add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 7}});
+        auto sum = m1.add_instruction(migraphx::make_op("add"), l1, l2);
+        m1.add_instruction(pass_op{}, sum);
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(different_shapes)
+{
+    std::vector<float> data = {1, 2, 3, 4, 5, 6};
+    migraphx::module m1;
+    {
+        auto l1 = m1.add_literal(migraphx::literal{{migraphx::shape::float_type, {2, 3}}, data});
+        auto l2 = m1.add_literal(migraphx::literal{{migraphx::shape::float_type, {3, 2}}, data});
+        auto t  = m1.add_instruction(migraphx::make_op("transpose", {{"dims", {1, 0}}}), l2);
+        auto sum = m1.add_instruction(migraphx::make_op("add"), l1, t);
+        m1.add_instruction(pass_op{}, sum);
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(store_shares_data)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    migraphx::literal l1{s, {1, 2, 3, 4}};
+    migraphx::literal l2{s, {1, 2, 3, 4}};
+    migraphx::literal l3{s, {1, 2, 3, 5}};
+    migraphx::literal_store store;
+    auto a1 = store.insert(l1);
+    auto a2 = store.insert(l2);
+    auto a3 = store.insert(l3);
+    EXPECT(a1.data() == a2.data());
+    EXPECT(a1.data() != a3.data());
+    EXPECT(a1 == l1.get_argument());
+    EXPECT(a3 == l3.get_argument());
+    EXPECT(store.size() == 2);
+    EXPECT(store.bytes_requested() == 3 * s.bytes());
+    EXPECT(store.bytes_saved() == s.bytes());
+}
+
+TEST_CASE(store_releases_data)
+{
+    migraphx::shape s{migraphx::shape::int32_type, {3}};
+    migraphx::literal l{s, {1, 2, 3}};
+    migraphx::literal_store store;
+    {
+        auto a = store.insert(l);
+        EXPECT(store.size() == 1);
+    }
+    EXPECT(store.size() == 0);
+    auto a = store.insert(l);
+    EXPECT(store.size() == 1);
+    EXPECT(store.bytes_saved() == 0);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -4,6 +4,7 @@
 #include <migraphx/instruction.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/compile_options.hpp>
+#include <memory>
 #include <sstream>
 #include "test.hpp"
 #include <basic_ops.hpp>
@@ -475,6 +476,148 @@ TEST_CASE(eval_context3)
     EXPECT(not is_shared(t.ctx, p.get_context()));
 }
 
+struct count_op
+{
+    std::shared_ptr<int> count = std::make_shared<int>(0);
+
+    template <class Self, class F>
+    static auto reflect(Self&, F)
+    {
+        return migraphx::pack();
+    }
+
+    std::string name() const { return "count"; }
+    migraphx::argument
+    compute(migraphx::context&, const migraphx::shape&, std::vector<migraphx::argument> args) const
+    {
+        (*count)++;
+        return args.front();
+    }
+
+    migraphx::shape compute_shape(std::vector<migraphx::shape> inputs) const
+    {
+        return inputs.front();
+    }
+};
+
+TEST_CASE(eval_outputs)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    count_op c1{};
+    count_op c2{};
+    auto one  = mm->add_literal(1);
+    auto two  = mm->add_literal(2);
+    auto x    = mm->add_instruction(c1, one);
+    auto y    = mm->add_instruction(c2, two);
+    auto sum  = mm->add_instruction(sum_op{}, x, two);
+    auto diff = mm->add_instruction(minus_op{}, y, one);
+    mm->add_return({sum, diff});
+    p.compile(id_target{});
+
+    auto results = p.eval({}, {1});
+    EXPECT(results.size() == 1);
+    EXPECT(results.front() == migraphx::literal{1});
+    EXPECT(*c1.count == 0);
+    EXPECT(*c2.count == 1);
+
+    results = p.eval({}, {1, 0});
+    EXPECT(results.size() == 2);
+    EXPECT(results[0] == migraphx::literal{1});
+    EXPECT(results[1] == migraphx::literal{3});
+    EXPECT(*c1.count == 1);
+    EXPECT(*c2.count == 2);
+
+    EXPECT(p.eval({}, {}).empty());
+    EXPECT(*c1.count == 1);
+    EXPECT(*c2.count == 2);
+
+    EXPECT(test::throws([&] { p.eval({}, {2}); }));
+}
+
+TEST_CASE(eval_outputs_params)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto one = mm->add_literal(1);
+    auto two = mm->add_literal(2);
+    auto x   = mm->add_parameter("x", one->get_shape());
+    auto y   = mm->add_instruction(sum_op{}, x, one);
+    mm->add_return({y, two});
+    p.compile(id_target{});
+    EXPECT(test::throws([&] { p.eval({}); }));
+    auto results = p.eval({}, {1});
+    EXPECT(results.front() == migraphx::literal{2});
+}
+
+TEST_CASE(eval_outputs_side_effects)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    count_op c{};
+    auto one = mm->add_literal(1);
+    auto two = mm->add_literal(2);
+    mm->add_instruction(c, one);
+    auto sum = mm->add_instruction(sum_op{}, one, two);
+    mm->add_return({sum, two});
+    p.compile(id_target{});
+    p.eval({}, {1});
+    EXPECT(*c.count == 1);
+}
+
+TEST_CASE(eval_outputs_changed)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    count_op c1{};
+    count_op c2{};
+    auto one  = mm->add_literal(1);
+    auto two  = mm->add_literal(2);
+    auto x    = mm->add_instruction(c1, one);
+    auto y    = mm->add_instruction(c2, two);
+    auto sum  = mm->add_instruction(sum_op{}, x, two);
+    auto diff = mm->add_instruction(minus_op{}, y, one);
+    mm->add_return({sum, diff, y});
+    p.compile(id_target{});
+
+    // The module keeps its size, but the output now depends on another instruction
+    migraphx::instruction::replace_argument(diff, y, x);
+    auto results = p.eval({}, {1});
+    EXPECT(results.front() == migraphx::literal{0});
+    EXPECT(*c1.count == 1);
+    EXPECT(*c2.count == 0);
+
+    auto p2 = p;
+    results = p2.eval({}, {0});
+    EXPECT(results.front() == migraphx::literal{3});
+    EXPECT(*c1.count == 2);
+    EXPECT(*c2.count == 0);
+}
+
+TEST_CASE(eval_outputs_erased)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    count_op c1{};
+    count_op c2{};
+    auto one  = mm->add_literal(1);
+    auto two  = mm->add_literal(2);
+    auto x    = mm->add_instruction(c1, one);
+    auto y    = mm->add_instruction(c2, two);
+    auto diff = mm->add_instruction(minus_op{}, y, one);
+    mm->add_return({x, y, diff});
+    p.compile(id_target{});
+
+    // Replace the output with a new instruction that uses x, and erase the one it was compiled with
+    auto diff2 = mm->insert_instruction(diff, minus_op{}, x, one);
+    mm->replace_instruction(diff, diff2);
+    mm->remove_instruction(diff);
+    auto results = p.eval({}, {2});
+    EXPECT(results.front() == migraphx::literal{0});
+    EXPECT(*c1.count == 1);
+    EXPECT(*c2.count == 0);
+}
+
 struct cout_redirect
 {
     cout_redirect()                     = delete;
@@ -0,0 +1,156 @@
+#include <migraphx/half_convert.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/op/convert.hpp>
+#include <migraphx/verify.hpp>
+#include <test.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Sizes around the width of the vector instructions so the remainder is also checked
+static std::vector<std::size_t> sizes() { return {0, 1, 7, 8, 9, 15, 16, 17, 1000}; }
+
+// Values that need more bits than a half has, so they must be rounded
+static std::vector<float> create_values(std::size_t n)
+{
+    std::vector<float> result(n);
+    for(std::size_t i = 0; i < n; i++)
+        result[i] = std::ldexp(float(int(i % 41) - 20) + 1.0f / 3.0f, int(i % 23) - 11);
+    return result;
+}
+
+// Rounds to the nearest half with ties to even, computed in double with the default rounding
+// mode, instead of with the half library which truncates
+static float round_to_half(float x)
+{
+    if(x == 0 or std::isnan(x) or std::isinf(x))
+        return x;
+    auto e = std::max(std::ilogb(x), -14);
+    auto r = std::ldexp(std::nearbyint(std::ldexp(double(x), 10 - e)), e - 10);
+    if(std::abs(r) > 65504)
+        return std::copysign(std::numeric_limits<float>::infinity(), x);
+    return r;
+}
+
+TEST_CASE(float_to_half_bulk)
+{
+    for(auto n : sizes())
+    {
+        auto x = create_values(n);
+        std::vector<migraphx::half> result(n);
+        migraphx::float_to_half(x.data(), n, result.data());
+        for(std::size_t i = 0; i < n; i++)
+            EXPECT(float(result[i]) == round_to_half(x[i]));
+    }
+}
+
+TEST_CASE(float_to_half_ties)
+{
+    // Halfway between two halfs, for normal and subnormal values, and the overflow to infinity
+    std::vector<float> x = {1.0f + std::ldexp(1.0f, -11),
+                            1.0f + 3.0f * std::ldexp(1.0f, -11),
+                            -(1.0f + std::ldexp(1.0f, -11)),
+                            std::ldexp(1.0f, -25),
+                            3.0f * std::ldexp(1.0f, -25),
+                            std::ldexp(1.0f, -14) - std::ldexp(1.0f, -25),
+                            65519.0f,
+                            65520.0f,
+                            0.1f};
+    std::vector<float> expected = {1.0f,
+                                   1.0f + std::ldexp(1.0f, -9),
+                                   -1.0f,
+                                   0.0f,
+                                   std::ldexp(1.0f, -23),
+                                   std::ldexp(1.0f, -14),
+                                   65504.0f,
+                                   std::numeric_limits<float>::infinity(),
+                                   round_to_half(0.1f)};
+    for(std::size_t i = 0; i < x.size(); i++)
+        EXPECT(float(migraphx::float_to_half(x[i])) == expected[i]);
+    // Repeat the values so both the vector instructions and the remainder convert them
+    std::vector<float> xs;
+    for(int i = 0; i < 3; i++)
+        xs.insert(xs.end(), x.begin(), x.end());
+    std::vector<migraphx::half> result(xs.size());
+    migraphx::float_to_half(xs.data(), xs.size(), result.data());
+    for(std::size_t i = 0; i < xs.size(); i++)
+        EXPECT(float(result[i]) == expected[i % x.size()]);
+}
+
+TEST_CASE(half_to_float_bulk)
+{
+    for(auto n : sizes())
+    {
+        auto x = create_values(n);
+        std::vector<migraphx::half> h(x.begin(), x.end());
+        std::vector<float> result(n);
+        migraphx::half_to_float(h.data(), n, result.data());
+        for(std::size_t i = 0; i < n; i++)
+            EXPECT(result[i] == float(h[i]));
+    }
+}
+
+TEST_CASE(half_special_values)
+{
+    std::vector<float> x = {0.0f,
+                            -0.0f,
+                            1.0f,
+                            -2.5f,
+                            65504.0f,
+                            std::numeric_limits<float>::infinity(),
+                            -std::numeric_limits<float>::infinity(),
+                            std::numeric_limits<float>::quiet_NaN(),
+                            6.0e-8f,
+                            1.0e-5f};
+    std::vector<migraphx::half> h(x.size());
+    std::vector<float> result(x.size());
+    migraphx::float_to_half(x.data(), x.size(), h.data());
+    migraphx::half_to_float(h.data(), h.size(), result.data());
+    for(std::size_t i = 0; i < x.size(); i++)
+    {
+        if(std::isnan(x[i]))
+            EXPECT(std::isnan(result[i]));
+        else
+            EXPECT(result[i] == round_to_half(x[i]));
+    }
+    EXPECT(std::signbit(result[1]));
+}
+
+TEST_CASE(literal_half_from_float)
+{
+    auto x = create_values(37);
+    migraphx::literal l{{migraphx::shape::half_type, {37}}, x};
+    std::vector<float> result;
+    l.visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    for(std::size_t i = 0; i < x.size(); i++)
+        EXPECT(result[i] == round_to_half(x[i]));
+
+    std::vector<migraphx::half> h(x.begin(), x.end());
+    migraphx::literal lf{{migraphx::shape::float_type, {37}}, h};
+    std::vector<float> result2;
+    lf.visit([&](auto v) { result2.assign(v.begin(), v.end()); });
+    EXPECT(migraphx::verify_range(result2, result));
+}
+
+TEST_CASE(literal_half_from_float_transposed)
+{
+    auto x = create_values(42);
+    migraphx::literal l{{migraphx::shape::half_type, {6, 7}, {1, 6}}, x.begin(), x.end()};
+    const auto* h = reinterpret_cast<const migraphx::half*>(l.data());
+    for(std::size_t r = 0; r < 6; r++)
+    {
+        for(std::size_t c = 0; c < 7; c++)
+            EXPECT(float(h[r + c * 6]) == round_to_half(x[r * 7 + c]));
+    }
+}
+
+TEST_CASE(convert_apply_half)
+{
+    auto f = migraphx::op::convert{migraphx::shape::half_type}.apply();
+    for(auto x : create_values(100))
+        EXPECT(f(x) == round_to_half(x));
+    EXPECT(f(1.0e6f) == 65504.0f);
+    EXPECT(f(-1.0e6f) == -65504.0f);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,53 @@
+#include <migraphx/inplace_write_slice.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/instruction.hpp>
+#include <basic_ops.hpp>
+
+#include <test.hpp>
+
+void run_pass(migraphx::module& m) { migraphx::run_passes(m, {migraphx::inplace_write_slice{}}); }
+
+migraphx::instruction_ref add_write_slice(migraphx::module& m, migraphx::instruction_ref data)
+{
+    auto update = m.add_parameter("update", {migraphx::shape::float_type, {1}});
+    auto offset = m.add_parameter("offset", {migraphx::shape::int64_type, {1}});
+    return m.add_instruction(migraphx::make_op("write_slice", {{"axis", 0}}), data, update, offset);
+}
+
+bool is_inplace(migraphx::instruction_ref ins)
+{
+    return ins->get_operator().to_value()["inplace"].to<bool>();
+}
+
+TEST_CASE(param_inplace)
+{
+    migraphx::module m;
+    auto data = m.add_parameter("data", {migraphx::shape::float_type, {4}});
+    auto ws   = add_write_slice(m, data);
+    m.add_return({ws});
+    run_pass(m);
+    EXPECT(is_inplace(std::prev(m.end(), 2)));
+}
+
+TEST_CASE(param_used_twice)
+{
+    migraphx::module m;
+    auto data = m.add_parameter("data", {migraphx::shape::float_type, {4}});
+    auto ws   = add_write_slice(m, data);
+    m.add_return({ws, data});
+    run_pass(m);
+    EXPECT(not is_inplace(ws));
+}
+
+TEST_CASE(literal_copied)
+{
+    migraphx::module m;
+    auto data = m.add_literal(migraphx::literal{{migraphx::shape::float_type, {4}}, {1, 2, 3, 4}});
+    auto ws   = add_write_slice(m, data);
+    m.add_return({ws});
+    run_pass(m);
+    EXPECT(not is_inplace(ws));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
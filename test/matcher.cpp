@@ -1076,4 +1076,103 @@ TEST_CASE(match_finder)
     match::find_matches(mm, match_find_sum{sum}, match_find_literal{sum});
 }
 
+TEST_CASE(match_root_names)
+{
+    EXPECT(match::get_root_names(match::name("sum")) == std::vector<std::string>{"sum"});
+    EXPECT(match::get_root_names(match::name("sum")(match::arg(0)(match::name("pass")))) ==
+           std::vector<std::string>{"sum"});
+    EXPECT(match::get_root_names(match::name("sum").bind("x")) == std::vector<std::string>{"sum"});
+    EXPECT(match::get_root_names(match::name("sum", "minus")) ==
+           std::vector<std::string>{"minus", "sum"});
+    EXPECT(match::get_root_names(match::any()).empty());
+    EXPECT(match::get_root_names(match::standard_shape()).empty());
+    EXPECT(match::get_root_names(match::any_of(match::name("sum"))).empty());
+}
+
+struct match_find_sum_pass
+{
+    auto matcher() const
+    {
+        return match::name("sum")(match::output(match::name("pass").bind("pass")));
+    }
+
+    void apply(migraphx::module& m, match::matcher_result r) const
+    {
+        m.replace_instruction(r.instructions["pass"], r.result);
+    }
+};
+
+static migraphx::module create_sum_pass_chain()
+{
+    migraphx::module mm;
+    auto one  = mm.add_literal(1);
+    auto two  = mm.add_literal(2);
+    auto sum  = mm.add_instruction(sum_op{}, one, two);
+    auto pass = mm.add_instruction(pass_op{}, sum);
+    pass      = mm.add_instruction(pass_op{}, pass);
+    pass      = mm.add_instruction(pass_op{}, pass);
+    mm.add_instruction(minus_op{}, pass, one);
+    return mm;
+}
+
+static std::ptrdiff_t count_passes(const migraphx::module& mm)
+{
+    return std::count_if(
+        mm.begin(), mm.end(), [](const auto& ins) { return ins.name() == "pass"; });
+}
+
+TEST_CASE(match_finder_single_sweep)
+{
+    auto mm = create_sum_pass_chain();
+    match::find_matches(mm, match_find_sum_pass{});
+    auto last = std::prev(mm.end());
+    EXPECT(last->name() == "minus");
+    EXPECT(last->inputs().front()->name() == "pass");
+}
+
+TEST_CASE(match_finder_fixpoint)
+{
+    auto mm = create_sum_pass_chain();
+    match::find_matches_fixpoint(mm, match_find_sum_pass{});
+    auto last = std::prev(mm.end());
+    EXPECT(last->name() == "minus");
+    EXPECT(last->inputs().front()->name() == "sum");
+    EXPECT(count_passes(mm) == 0);
+}
+
+TEST_CASE(match_finder_fixpoint_no_match)
+{
+    migraphx::module mm;
+    auto one = mm.add_literal(1);
+    auto two = mm.add_literal(2);
+    auto sum = mm.add_instruction(sum_op{}, one, two);
+    mm.add_instruction(pass_op{}, sum);
+    match::find_matches_fixpoint(mm, match_find_sum{sum}, match_find_literal{sum});
+    EXPECT(mm.size() == 4);
+}
+
+struct match_renew_sum
+{
+    auto matcher() const { return match::name("sum"); }
+
+    void apply(migraphx::module& m, const match::matcher_result& r) const
+    {
+        auto sum = m.insert_instruction(r.result, sum_op{}, r.result->inputs());
+        m.replace_instruction(r.result, sum);
+    }
+};
+
+TEST_CASE(match_finder_fixpoint_terminates)
+{
+    migraphx::module mm;
+    auto one = mm.add_literal(1);
+    auto two = mm.add_literal(2);
+    auto sum = mm.add_instruction(sum_op{}, one, two);
+    mm.add_instruction(pass_op{}, sum);
+    // Every rewrite creates a new instruction, so only the limit on the whole module stops it
+    match::find_matches_fixpoint(mm, match_renew_sum{});
+    mm.validate();
+    EXPECT(mm.size() == 4);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
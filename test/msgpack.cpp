@@ -1,6 +1,8 @@
 #include <migraphx/msgpack.hpp>
 #include <migraphx/value.hpp>
+#include <migraphx/stringutils.hpp>
 #include <msgpack.hpp>
+#include <algorithm>
 #include <map>
 #include "test.hpp"
 
@@ -124,4 +126,50 @@ TEST_CASE(test_msgpack_array_class)
     EXPECT(migraphx::from_msgpack(buffer) == v);
 }
 
+TEST_CASE(test_msgpack_binary)
+{
+    std::vector<char> data = {1, 2, 3, 4};
+    migraphx::value v      = migraphx::value::binary{data.data(), data.size()};
+    auto buffer            = migraphx::to_msgpack(v);
+    EXPECT(migraphx::from_msgpack(buffer) == v);
+}
+
+TEST_CASE(test_msgpack_nested)
+{
+    migraphx::value v = {{"a", {1, 2, 3}},
+                         {"b", {{"c", {{{"d", "x"}}, {{"d", "y"}}}}, {"e", nullptr}}},
+                         {"f", {true, -1, 2.5}}};
+    auto buffer       = migraphx::to_msgpack(v);
+    EXPECT(migraphx::from_msgpack(buffer) == v);
+}
+
+TEST_CASE(test_msgpack_read_binary)
+{
+    std::vector<char> data = {1, 2, 3};
+    migraphx::value bin    = migraphx::value::binary{data.data(), data.size()};
+    migraphx::value v      = {{"a", {{{"b", bin}}, {{"c", bin}}}}, {"d", bin}};
+    auto buffer            = migraphx::to_msgpack(v);
+    std::vector<std::string> keys;
+    auto u = migraphx::from_msgpack(
+        buffer.data(),
+        buffer.size(),
+        [&](const std::vector<std::string>& k, const char* b, std::size_t n) {
+            EXPECT(n == data.size());
+            EXPECT(std::equal(b, b + n, data.begin()));
+            keys.push_back(migraphx::join_strings(k, "/"));
+            return migraphx::value(keys.size());
+        });
+    EXPECT(keys == std::vector<std::string>{"a//b", "a//c", "d"});
+    EXPECT(u.at("a")[0].at("b").to<int>() == 1);
+    EXPECT(u.at("a")[1].at("c").to<int>() == 2);
+    EXPECT(u.at("d").to<int>() == 3);
+}
+
+TEST_CASE(test_msgpack_truncated)
+{
+    migraphx::value v = {{"a", {1, 2, 3}}, {"b", "abc"}};
+    auto buffer       = migraphx::to_msgpack(v);
+    EXPECT(test::throws([&] { migraphx::from_msgpack(buffer.data(), buffer.size() - 2); }));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
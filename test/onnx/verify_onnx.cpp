@@ -311,6 +311,37 @@ TEST_CASE(resize_downsample_f_test)
     EXPECT(migraphx::verify_range(result_vector, gold));
 }
 
+TEST_CASE(resize_upsample_cubic_test)
+{
+    migraphx::program p = migraphx::parse_onnx("resize_upsample_cubic_test.onnx");
+    p.compile(migraphx::ref::target{});
+
+    migraphx::shape sx{migraphx::shape::float_type, {1, 1, 4, 4}};
+    std::vector<float> dx(sx.elements());
+    std::iota(dx.begin(), dx.end(), 1.0f);
+
+    migraphx::parameter_map pp;
+    pp["X"] = migraphx::argument(sx, dx.data());
+
+    auto result = p.eval(pp).back();
+    std::vector<float> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+
+    std::vector<float> gold = {
+        0.47265625, 0.76953125, 1.24609375, 1.875,      2.28125,    2.91015625, 3.38671875,
+        3.68359375, 1.66015625, 1.95703125, 2.43359375, 3.0625,     3.46875,    4.09765625,
+        4.57421875, 4.87109375, 3.56640625, 3.86328125, 4.33984375, 4.96875,    5.375,
+        6.00390625, 6.48046875, 6.77734375, 6.08203125, 6.37890625, 6.85546875, 7.484375,
+        7.890625,   8.51953125, 8.99609375, 9.29296875, 7.70703125, 8.00390625, 8.48046875,
+        9.109375,   9.515625,   10.1445312, 10.6210938, 10.9179688, 10.2226562, 10.5195312,
+        10.9960938, 11.625,     12.03125,   12.6601562, 13.1367188, 13.4335938, 12.1289062,
+        12.4257812, 12.9023438, 13.53125,   13.9375,    14.5664062, 15.0429688, 15.3398438,
+        13.3164062, 13.6132812, 14.0898438, 14.71875,   15.125,     15.7539062, 16.2304688,
+        16.5273438};
+
+    EXPECT(migraphx::verify_range(result_vector, gold));
+}
+
 TEST_CASE(resize_upsample_linear_ac_test)
 {
     migraphx::program p = migraphx::parse_onnx("resize_upsample_linear_ac_test.onnx");
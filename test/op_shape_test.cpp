@@ -192,6 +192,30 @@ TEST_CASE(deconvolution_shape)
         weights_3d);
 }
 
+TEST_CASE(dequantize_dot_shape)
+{
+    migraphx::shape a{migraphx::shape::float_type, {2, 3, 9}};
+    migraphx::shape weights{migraphx::shape::int8_type, {5, 9}};
+    migraphx::shape packed{migraphx::shape::uint8_type, {5, 5}};
+    migraphx::shape half_weights{migraphx::shape::half_type, {5, 9}};
+    migraphx::shape scales{migraphx::shape::float_type, {5, 1}};
+    migraphx::shape group_scales{migraphx::shape::float_type, {5, 3}};
+    migraphx::shape output{migraphx::shape::float_type, {2, 3, 5}};
+    expect_shape(output, migraphx::make_op("dequantize_dot"), a, weights, scales);
+    expect_shape(output,
+                 migraphx::make_op("dequantize_dot", {{"bits", 4}, {"group_size", 4}}),
+                 a,
+                 packed,
+                 group_scales);
+    expect_shape(
+        output, migraphx::make_op("dequantize_dot", {{"bits", 16}}), a, half_weights, scales);
+    throws_shape(migraphx::make_op("dequantize_dot"), a, packed, scales);
+    throws_shape(migraphx::make_op("dequantize_dot", {{"bits", 16}}), a, weights, scales);
+    throws_shape(migraphx::make_op("dequantize_dot"), a, weights, group_scales);
+    throws_shape(migraphx::make_op("dequantize_dot", {{"bits", 2}}), a, weights, scales);
+    throws_shape(migraphx::make_op("dequantize_dot"), weights, weights, scales);
+}
+
 TEST_CASE(flatten_shape)
 {
     migraphx::shape input{migraphx::shape::float_type, {2, 4, 6, 8}};
@@ -1209,6 +1233,31 @@ TEST_CASE(reshape_shape)
     }
 }
 
+TEST_CASE(resize_shape)
+{
+    migraphx::shape input{migraphx::shape::float_type, {1, 3, 4, 6}};
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {1, 3, 8, 9}},
+                 migraphx::make_op("resize", {{"sizes", {1, 3, 8, 9}}}),
+                 input);
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {1, 3, 2, 3}},
+                 migraphx::make_op("resize",
+                                   {{"sizes", {1, 3, 2, 3}},
+                                    {"scales", {1.0f, 1.0f, 0.5f, 0.5f}},
+                                    {"mode", "cubic"}}),
+                 input);
+    throws_shape(migraphx::make_op("resize", {{"sizes", {3, 8, 9}}}), input);
+    throws_shape(migraphx::make_op("resize", {{"sizes", {1, 3, 8, 9}}, {"scales", {2.0f, 1.5f}}}),
+                 input);
+    throws_shape(migraphx::make_op("resize", {{"sizes", {1, 3, 8, 9}}, {"mode", "area"}}), input);
+    throws_shape(migraphx::make_op("resize",
+                                   {{"sizes", {1, 3, 8, 9}},
+                                    {"coordinate_transformation_mode", "tf_crop_and_resize"}}),
+                 input);
+    throws_shape(
+        migraphx::make_op("resize", {{"sizes", {1, 3, 8, 9}}, {"nearest_mode", "round"}}),
+        input);
+}
+
 TEST_CASE(rnn)
 {
     {
@@ -1494,6 +1543,39 @@ TEST_CASE(test_scalar_nelemnts)
     throws_shape(migraphx::make_op("scalar", {{"scalar_bcst_dims", {2, 3, 4, 5}}}), input);
 }
 
+TEST_CASE(sparse_dot_shape)
+{
+    migraphx::shape vs{migraphx::shape::float_type, {6, 4}};
+    migraphx::shape cs{migraphx::shape::int32_type, {6}};
+    migraphx::shape rs{migraphx::shape::int32_type, {9}};
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {2, 3, 10}},
+                 migraphx::make_op("sparse_dot", {{"n", 10}, {"block_size", 4}}),
+                 migraphx::shape{migraphx::shape::float_type, {2, 3, 8}},
+                 vs,
+                 cs,
+                 rs);
+    throws_shape(migraphx::make_op("sparse_dot", {{"n", 10}, {"block_size", 4}}),
+                 migraphx::shape{migraphx::shape::float_type, {2, 3, 7}},
+                 vs,
+                 cs,
+                 rs);
+    throws_shape(migraphx::make_op("sparse_dot", {{"n", 10}, {"block_size", 2}}),
+                 migraphx::shape{migraphx::shape::float_type, {3, 8}},
+                 vs,
+                 cs,
+                 rs);
+    throws_shape(migraphx::make_op("sparse_dot", {{"n", 10}, {"block_size", 4}}),
+                 migraphx::shape{migraphx::shape::float_type, {3, 8}},
+                 vs,
+                 migraphx::shape{migraphx::shape::int32_type, {5}},
+                 rs);
+    throws_shape(migraphx::make_op("sparse_dot", {{"n", 10}, {"block_size", 4}}),
+                 migraphx::shape{migraphx::shape::int32_type, {3, 8}},
+                 vs,
+                 cs,
+                 rs);
+}
+
 TEST_CASE(test_squeeze)
 {
     migraphx::shape s1{migraphx::shape::float_type, {4, 1, 3, 1, 3}};
@@ -1583,4 +1665,36 @@ TEST_CASE(step_test)
     }
 }
 
+TEST_CASE(write_slice_shape)
+{
+    migraphx::shape data{migraphx::shape::float_type, {2, 8, 4}};
+    migraphx::shape offset{migraphx::shape::int64_type, {1}};
+    expect_shape(data,
+                 migraphx::make_op("write_slice", {{"axis", 1}}),
+                 data,
+                 migraphx::shape{migraphx::shape::float_type, {2, 1, 4}},
+                 offset);
+    expect_shape(data,
+                 migraphx::make_op("write_slice", {{"axis", -2}}),
+                 data,
+                 migraphx::shape{migraphx::shape::float_type, {2, 3, 4}},
+                 offset);
+    throws_shape(migraphx::make_op("write_slice", {{"axis", 1}}),
+                 data,
+                 migraphx::shape{migraphx::shape::float_type, {2, 9, 4}},
+                 offset);
+    throws_shape(migraphx::make_op("write_slice", {{"axis", 1}}),
+                 data,
+                 migraphx::shape{migraphx::shape::float_type, {2, 1, 3}},
+                 offset);
+    throws_shape(migraphx::make_op("write_slice", {{"axis", 1}}),
+                 data,
+                 migraphx::shape{migraphx::shape::half_type, {2, 1, 4}},
+                 offset);
+    throws_shape(migraphx::make_op("write_slice", {{"axis", 1}}),
+                 data,
+                 migraphx::shape{migraphx::shape::float_type, {2, 1, 4}},
+                 migraphx::shape{migraphx::shape::int64_type, {2}});
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
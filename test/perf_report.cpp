@@ -27,4 +27,24 @@ TEST_CASE(perf_report)
     EXPECT(not migraphx::contains(output, "fast"));
 }
 
+TEST_CASE(perf_report_counters)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    std::stringstream ss;
+    auto one = mm->add_literal(1);
+    auto two = mm->add_literal(2);
+    mm->add_instruction(migraphx::make_op("add"), one, two);
+    p.compile(migraphx::ref::target{});
+    p.perf_report(ss, 2, {}, true);
+
+    std::string output = ss.str();
+    EXPECT(migraphx::contains(output, "Summary:"));
+    EXPECT(migraphx::contains(output, "Rate:"));
+    // The counters are either reported or their absence is
+    EXPECT(migraphx::contains(output, "cycles") or
+           migraphx::contains(output, "Hardware counters are not available"));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
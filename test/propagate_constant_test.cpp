@@ -3,6 +3,7 @@
 #include <migraphx/pass_manager.hpp>
 #include <basic_ops.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/instruction.hpp>
 
 #include <test.hpp>
 
@@ -111,4 +112,134 @@ TEST_CASE(const_scalar)
     EXPECT(m1 == m2);
 }
 
+TEST_CASE(const_multiple_outputs)
+{
+    migraphx::module m1;
+    auto one  = m1.add_literal(1);
+    auto two  = m1.add_literal(2);
+    auto sum  = m1.add_instruction(migraphx::make_op("add"), one, two);
+    auto mul1 = m1.add_instruction(migraphx::make_op("mul"), sum, two);
+    auto mul2 = m1.add_instruction(migraphx::make_op("mul"), sum, sum);
+    m1.add_instruction(pass_op{}, sum, mul1, mul2);
+    run_pass(m1);
+
+    migraphx::module m2;
+    auto l1 = m2.add_literal(3);
+    auto l2 = m2.add_literal(6);
+    auto l3 = m2.add_literal(9);
+    m2.add_instruction(pass_op{}, l1, l2, l3);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(const_transpose_shares_data)
+{
+    migraphx::module m1;
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto x  = m1.add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+    auto t  = m1.add_instruction(migraphx::make_op("transpose", {{"dims", {1, 0}}}), x);
+    auto* p = x->get_literal().data();
+    m1.add_instruction(pass_op{}, t);
+    run_pass(m1);
+
+    auto l = std::prev(m1.end(), 2);
+    EXPECT(l->name() == "@literal");
+    EXPECT(l->get_shape().transposed());
+    // The folded literal is a view of the original data
+    EXPECT(l->get_literal().data() == p);
+}
+
+TEST_CASE(const_fold_cache)
+{
+    auto create_module = [] {
+        migraphx::module m;
+        auto one = m.add_literal(1);
+        auto two = m.add_literal(2);
+        auto sum = m.add_instruction(migraphx::make_op("add"), one, two);
+        auto mul = m.add_instruction(migraphx::make_op("mul"), sum, two);
+        m.add_instruction(pass_op{}, mul);
+        return m;
+    };
+    migraphx::constant_fold_cache cache;
+    auto run_cached = [&](migraphx::module& m) {
+        migraphx::run_passes(
+            m, {migraphx::propagate_constant{&cache}, migraphx::dead_code_elimination{}});
+    };
+    auto m1 = create_module();
+    run_cached(m1);
+    EXPECT(cache.size() == 1);
+    EXPECT(cache.hits() == 0);
+
+    auto m2 = create_module();
+    run_cached(m2);
+    EXPECT(cache.hits() == 1);
+    EXPECT(m1 == m2);
+
+    // Different literals with the same operators are not reused
+    migraphx::module m3;
+    {
+        auto one = m3.add_literal(1);
+        auto two = m3.add_literal(3);
+        auto sum = m3.add_instruction(migraphx::make_op("add"), one, two);
+        auto mul = m3.add_instruction(migraphx::make_op("mul"), sum, two);
+        m3.add_instruction(pass_op{}, mul);
+    }
+    run_cached(m3);
+    EXPECT(cache.hits() == 1);
+    migraphx::module m4;
+    m4.add_instruction(pass_op{}, m4.add_literal(12));
+    EXPECT(m3 == m4);
+}
+
+TEST_CASE(const_fold_cache_capacity)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    migraphx::literal x{s, {1, 2, 3, 4}};
+    migraphx::literal y{s, {5, 6, 7, 8}};
+    // Room for two results that share their input
+    migraphx::constant_fold_cache cache{3 * s.bytes()};
+    cache.insert("a", {x}, y);
+    cache.insert("b", {x}, y);
+    EXPECT(cache.size() == 1);
+    EXPECT(cache.bytes() == 2 * s.bytes());
+    EXPECT(cache.find("a", {x}).empty());
+    EXPECT(not cache.find("b", {x}).empty());
+
+    // The least recently used result is dropped first
+    migraphx::constant_fold_cache cache2{4 * s.bytes()};
+    cache2.insert("a", {x}, y);
+    cache2.insert("b", {y}, x);
+    EXPECT(not cache2.find("a", {x}).empty());
+    cache2.insert("c", {x}, x);
+    EXPECT(cache2.size() == 2);
+    EXPECT(not cache2.find("a", {x}).empty());
+    EXPECT(cache2.find("b", {y}).empty());
+    EXPECT(not cache2.find("c", {x}).empty());
+
+    // Results that don't fit are not kept
+    migraphx::shape big{migraphx::shape::float_type, {16}};
+    cache2.insert("d", {x, y}, migraphx::literal{big, std::vector<float>(16)});
+    EXPECT(cache2.find("d", {x, y}).empty());
+    EXPECT(cache2.size() == 2);
+}
+
+TEST_CASE(const_write_slice)
+{
+    auto create_module = [] {
+        migraphx::module m;
+        migraphx::shape s{migraphx::shape::float_type, {4}};
+        migraphx::shape us{migraphx::shape::float_type, {1}};
+        auto data   = m.add_literal(migraphx::literal{s, {1, 2, 3, 4}});
+        auto update = m.add_literal(migraphx::literal{us, {5}});
+        auto offset = m.add_literal(migraphx::literal{{migraphx::shape::int64_type, {1}}, {2}});
+        auto ws     = m.add_instruction(
+            migraphx::make_op("write_slice", {{"axis", 0}}), data, update, offset);
+        m.add_instruction(pass_op{}, ws);
+        return m;
+    };
+    auto m1 = create_module();
+    run_pass(m1);
+    // Folding would write into the buffer of the literal, which can be shared
+    EXPECT(m1 == create_module());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
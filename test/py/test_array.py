@@ -78,6 +78,17 @@ def test_input():
         assert_eq(a1.tolist(), m.tolist())
 
 
+def test_dlpack():
+    data = list(range(6))
+    a1 = migraphx.argument(create_buffer('f', data, [2, 3]))
+    a2 = migraphx.from_dlpack(a1)
+    assert_eq(a1.__dlpack_device__(), (1, 0))
+    assert_eq(a1.get_shape().lens(), a2.get_shape().lens())
+    assert_eq(a2.tolist(), data)
+    a3 = migraphx.from_dlpack(a2.__dlpack__())
+    assert_eq(a3, a1)
+
+
 def test_output():
     p = migraphx.parse_onnx("conv_relu_maxpool_test.onnx")
     p.compile(migraphx.get_target("gpu"))
@@ -98,4 +109,5 @@ def test_output():
 
 
 test_input()
+test_dlpack()
 test_output()
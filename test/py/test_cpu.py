@@ -53,6 +53,41 @@ def test_add_scalar():
     print(r)
 
 
+def test_run_async():
+    p = migraphx.parse_onnx("add_scalar_test.onnx")
+    p.compile(migraphx.get_target("ref"))
+
+    params = {}
+    params["0"] = migraphx.argument(
+        create_buffer("B", list(range(120)), [2, 3, 4, 5]))
+    params["1"] = migraphx.argument(create_buffer("B", [1], ()))
+    expected = p.run(params)[-1]
+
+    out = memoryview(bytearray(120)).cast("B", [2, 3, 4, 5])
+    f = p.run_async(params, outputs=[out])
+    f.wait()
+    assert f.done()
+    r = f.get()[-1]
+    assert r.tolist() == expected.tolist()
+
+    r = p.run(params, outputs=[out])[-1]
+    assert r.tolist() == expected.tolist()
+
+
+def test_run_async_concurrent():
+    p = migraphx.parse_onnx("conv_relu_maxpool_test.onnx")
+    p.compile(migraphx.get_target("ref"))
+    params = {}
+    for key, value in p.get_parameter_shapes().items():
+        params[key] = migraphx.generate_argument(value)
+    expected = p.run(params)[-1].tolist()
+
+    # Both runs use the same program so they must not evaluate at the same time
+    futures = [p.run_async(params) for i in range(2)]
+    for f in futures:
+        assert f.get()[-1].tolist() == expected
+
+
 def test_module():
     p = migraphx.parse_onnx("add_scalar_test.onnx")
     mm = p.get_main_module()
@@ -64,3 +99,5 @@ test_conv_relu()
 test_module()
 if sys.version_info >= (3, 0):
     test_add_scalar()
+    test_run_async()
+    test_run_async_concurrent()
@@ -1290,4 +1290,134 @@ TEST_CASE(int8_quantization_conv)
     }
 }
 
+std::vector<float> run_ref(migraphx::program p, const migraphx::parameter_map& m)
+{
+    p.compile(migraphx::ref::target{});
+    std::vector<float> result;
+    p.eval(m).back().visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    return result;
+}
+
+TEST_CASE(quantize_weights_int8)
+{
+    // Every channel has a largest magnitude of 127 so the weights are exact
+    std::vector<float> w(32 * 6);
+    for(std::size_t i = 0; i < w.size(); i++)
+        w[i] = i < 6 ? 127 : float(int((i * 37) % 255) - 127);
+    auto create_program = [&] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto a   = mm->add_parameter("a", {migraphx::shape::float_type, {2, 3, 32}});
+        auto b   = mm->add_literal(migraphx::literal{{migraphx::shape::float_type, {32, 6}}, w});
+        auto bb  = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", {2, 32, 6}}}), b);
+        mm->add_instruction(migraphx::make_op("dot"), a, bb);
+        return p;
+    };
+    auto p = create_program();
+    migraphx::quantize_weights(p);
+    auto* mm = p.get_main_module();
+    EXPECT(std::none_of(mm->begin(), mm->end(), [](auto& ins) { return ins.name() == "dot"; }));
+    auto qdot = std::find_if(
+        mm->begin(), mm->end(), [](auto& ins) { return ins.name() == "dequantize_dot"; });
+    EXPECT(bool{qdot != mm->end()});
+    EXPECT(qdot->inputs()[1]->get_shape() ==
+           migraphx::shape{migraphx::shape::int8_type, {6, 32}});
+    EXPECT(qdot->inputs()[2]->get_shape() == migraphx::shape{migraphx::shape::float_type, {6, 1}});
+
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {2, 3, 32}});
+    EXPECT(migraphx::verify_range(run_ref(p, m), run_ref(create_program(), m)));
+}
+
+TEST_CASE(quantize_weights_int4_groups)
+{
+    // An odd size is padded when packing, and the first value of each group sets its scale
+    const std::size_t k = 9;
+    const std::size_t n = 5;
+    std::vector<float> w(k * n);
+    for(std::size_t i = 0; i < k; i++)
+    {
+        for(std::size_t j = 0; j < n; j++)
+            w[i * n + j] = i % 4 == 0 ? 7 : float(int((i + 2 * j) % 15) - 7);
+    }
+    auto create_program = [&] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto a   = mm->add_parameter("a", {migraphx::shape::float_type, {4, k}});
+        auto b   = mm->add_literal(migraphx::literal{{migraphx::shape::float_type, {k, n}}, w});
+        mm->add_instruction(migraphx::make_op("dot", {{"alpha", 0.5f}}), a, b);
+        return p;
+    };
+    auto p = create_program();
+    migraphx::quantize_weights(p, 4, 4);
+    auto* mm  = p.get_main_module();
+    auto qdot = std::find_if(
+        mm->begin(), mm->end(), [](auto& ins) { return ins.name() == "dequantize_dot"; });
+    EXPECT(bool{qdot != mm->end()});
+    EXPECT(qdot->inputs()[1]->get_shape() ==
+           migraphx::shape{migraphx::shape::uint8_type, {n, 5}});
+    EXPECT(qdot->inputs()[2]->get_shape() == migraphx::shape{migraphx::shape::float_type, {n, 3}});
+
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {4, k}});
+    EXPECT(migraphx::verify_range(run_ref(p, m), run_ref(create_program(), m)));
+}
+
+TEST_CASE(quantize_weights_half)
+{
+    // Small integers and halves are exact in half
+    std::vector<float> w(20 * 7);
+    for(std::size_t i = 0; i < w.size(); i++)
+        w[i] = float(int((i * 13) % 31) - 15) / 2;
+    auto create_program = [&] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto a   = mm->add_parameter("a", {migraphx::shape::float_type, {3, 20}});
+        auto b   = mm->add_literal(migraphx::literal{{migraphx::shape::float_type, {20, 7}}, w});
+        mm->add_instruction(migraphx::make_op("dot", {{"alpha", 2.0f}}), a, b);
+        return p;
+    };
+    auto p = create_program();
+    migraphx::quantize_weights(p, 16, 4);
+    auto* mm  = p.get_main_module();
+    auto qdot = std::find_if(
+        mm->begin(), mm->end(), [](auto& ins) { return ins.name() == "dequantize_dot"; });
+    EXPECT(bool{qdot != mm->end()});
+    EXPECT(qdot->inputs()[1]->get_shape() ==
+           migraphx::shape{migraphx::shape::half_type, {7, 20}});
+    EXPECT(qdot->inputs()[2]->get_shape() == migraphx::shape{migraphx::shape::float_type, {7, 1}});
+
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {3, 20}});
+    EXPECT(migraphx::verify_range(run_ref(p, m), run_ref(create_program(), m)));
+}
+
+TEST_CASE(quantize_weights_error)
+{
+    auto create_program = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto a   = mm->add_parameter("a", {migraphx::shape::float_type, {24, 3}});
+        auto b   = mm->add_literal(
+            migraphx::generate_literal({migraphx::shape::float_type, {24, 40}}, 1));
+        auto at = mm->add_instruction(migraphx::make_op("transpose", {{"dims", {1, 0}}}), a);
+        mm->add_instruction(migraphx::make_op("dot"), at, b);
+        return p;
+    };
+    migraphx::parameter_map m;
+    m["a"]        = migraphx::generate_argument({migraphx::shape::float_type, {24, 3}});
+    auto expected = run_ref(create_program(), m);
+    for(std::size_t bits : {8, 4})
+    {
+        auto p = create_program();
+        migraphx::quantize_weights(p, bits, 8);
+        double error = 0;
+        migraphx::verify_range(run_ref(p, m), expected, 80, &error);
+        EXPECT(error < (bits == 8 ? 0.01 : 0.1));
+    }
+    auto p = create_program();
+    EXPECT(test::throws([&] { migraphx::quantize_weights(p, 2); }));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
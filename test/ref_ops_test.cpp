@@ -1032,6 +1032,67 @@ TEST_CASE(conv2d_test)
     EXPECT(migraphx::verify_range(results_vector, s));
 }
 
+// Compares with a direct convolution, on an image large enough that the im2col buffer is filled
+// in several chunks
+TEST_CASE(conv2d_dilation_test)
+{
+    std::size_t n = 1, c = 4, h = 130, w = 260, m = 3, k = 3, pad = 2, dil = 2;
+    migraphx::shape a_shape{migraphx::shape::float_type, {n, c, h, w}};
+    migraphx::shape c_shape{migraphx::shape::float_type, {m, c, k, k}};
+    std::vector<float> a(a_shape.elements());
+    std::vector<float> wei(c_shape.elements());
+    for(std::size_t i = 0; i < a.size(); i++)
+        a[i] = float(i % 17) / 8.0f - 1.0f;
+    for(std::size_t i = 0; i < wei.size(); i++)
+        wei[i] = float(i % 7) / 4.0f - 0.75f;
+
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto al  = mm->add_literal(migraphx::literal{a_shape, a});
+    auto cl  = mm->add_literal(migraphx::literal{c_shape, wei});
+    mm->add_instruction(
+        migraphx::make_op("convolution",
+                          {{"padding", {pad, pad}}, {"stride", {1, 1}}, {"dilation", {dil, dil}}}),
+        al,
+        cl);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+
+    std::size_t oh = h + 2 * pad - dil * (k - 1);
+    std::size_t ow = w + 2 * pad - dil * (k - 1);
+    EXPECT(result.get_shape().lens() == std::vector<std::size_t>{n, m, oh, ow});
+    std::vector<float> gold(m * oh * ow);
+    for(std::size_t oc = 0; oc < m; oc++)
+    {
+        for(std::size_t y = 0; y < oh; y++)
+        {
+            for(std::size_t x = 0; x < ow; x++)
+            {
+                double sum = 0;
+                for(std::size_t ic = 0; ic < c; ic++)
+                {
+                    for(std::size_t ky = 0; ky < k; ky++)
+                    {
+                        for(std::size_t kx = 0; kx < k; kx++)
+                        {
+                            auto iy = y + ky * dil;
+                            auto ix = x + kx * dil;
+                            if(iy < pad or ix < pad or iy >= h + pad or ix >= w + pad)
+                                continue;
+                            auto wi = ((oc * c + ic) * k + ky) * k + kx;
+                            sum += a[(ic * h + iy - pad) * w + ix - pad] * wei[wi];
+                        }
+                    }
+                }
+                gold[(oc * oh + y) * ow + x] = sum;
+            }
+        }
+    }
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify_range(results_vector, gold));
+}
+
 TEST_CASE(conv3d_test)
 {
     migraphx::program p;
@@ -1443,6 +1504,28 @@ TEST_CASE(fp16_test)
     EXPECT(migraphx::verify_range(results_vector, gold));
 }
 
+TEST_CASE(convert_half_saturate_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 5}};
+    std::vector<float> data = {
+        1.5f, -2.25f, 1.0e6f, -1.0e6f, 65504.0f, 0.0f, 3.0f, -7.0f, 0.5f, 9.0f};
+    auto l  = mm->add_literal(migraphx::literal{s, data});
+    auto lt = mm->add_instruction(migraphx::make_op("transpose", {{"dims", {1, 0}}}), l);
+    auto h  = mm->add_instruction(
+        migraphx::make_op("convert", {{"target_type", migraphx::shape::half_type}}), lt);
+    mm->add_instruction(
+        migraphx::make_op("convert", {{"target_type", migraphx::shape::float_type}}), h);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold = {
+        1.5f, 0.0f, -2.25f, 3.0f, 65504.0f, -7.0f, -65504.0f, 0.5f, 65504.0f, 9.0f};
+    EXPECT(migraphx::verify_range(results_vector, gold));
+}
+
 TEST_CASE(fp32_fp16_test)
 {
     auto create_program = [] {
@@ -3740,6 +3823,56 @@ TEST_CASE(reshape_test)
     }
 }
 
+TEST_CASE(resize_cubic_exclude_outside_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 4, 4}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 1);
+    auto l = mm->add_literal(migraphx::literal{s, data});
+    mm->add_instruction(migraphx::make_op("resize",
+                                          {{"sizes", {1, 1, 8, 8}},
+                                           {"scales", {1.0f, 1.0f, 2.0f, 2.0f}},
+                                           {"mode", "cubic"},
+                                           {"cubic_coeff_a", -0.5f},
+                                           {"exclude_outside", true}}),
+                        l);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold = {
+        0.55882353, 0.81494204, 1.3569825,  1.8970588,  2.3970588,  2.9371352,  3.4791756,
+        3.7352941,  1.5832976,  1.8394161,  2.3814565,  2.9215328,  3.4215328,  3.9616092,
+        4.5036496,  4.7597681,  3.7514594,  4.0075779,  4.5496183,  5.0896947,  5.5896947,
+        6.129771,   6.6718114,  6.92793,    5.9117647,  6.1678832,  6.7099237,  7.25,
+        7.75,       8.2900763,  8.8321168,  9.0882353,  7.9117647,  8.1678832,  8.7099237,
+        9.25,       9.75,       10.290076,  10.832117,  11.088235,  10.07207,   10.328189,
+        10.870229,  11.410305,  11.910305,  12.450382,  12.992422,  13.248541,  12.240232,
+        12.49635,   13.038391,  13.578467,  14.078467,  14.618543,  15.160584,  15.416702,
+        13.264706,  13.520824,  14.062865,  14.602941,  15.102941,  15.643018,  16.185058,
+        16.441176};
+    EXPECT(migraphx::verify_range(results_vector, gold));
+}
+
+TEST_CASE(resize_linear_transposed_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 2}};
+    auto l  = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4}});
+    auto tl = mm->add_instruction(migraphx::make_op("transpose", {{"dims", {1, 0}}}), l);
+    mm->add_instruction(migraphx::make_op("resize", {{"sizes", {4, 4}}, {"mode", "linear"}}), tl);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold = {
+        1, 1.5, 2.5, 3, 1.25, 1.75, 2.75, 3.25, 1.75, 2.25, 3.25, 3.75, 2, 2.5, 3.5, 4};
+    EXPECT(migraphx::verify_range(results_vector, gold));
+}
+
 TEST_CASE(reverse_test_axis0)
 {
     migraphx::shape in_shape{migraphx::shape::float_type, {2, 16}};
@@ -4248,4 +4381,104 @@ TEST_CASE(unsqueeze_test)
     }
 }
 
+TEST_CASE(write_slice_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 4, 2}};
+    migraphx::shape us{migraphx::shape::float_type, {2, 2, 2}};
+    migraphx::shape os{migraphx::shape::int64_type, {1}};
+    auto data   = mm->add_parameter("data", s);
+    auto update = mm->add_parameter("update", us);
+    auto offset = mm->add_parameter("offset", os);
+
+    auto r =
+        mm->add_instruction(migraphx::make_op("write_slice", {{"axis", 1}}), data, update, offset);
+    mm->add_return({r});
+    p.compile(migraphx::ref::target{});
+
+    std::vector<float> data_vec(s.elements(), 0);
+    std::vector<float> update_vec   = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<int64_t> offset_vec = {1};
+    migraphx::parameter_map params;
+    params["data"]   = migraphx::argument(s, data_vec.data());
+    params["update"] = migraphx::argument(us, update_vec.data());
+    params["offset"] = migraphx::argument(os, offset_vec.data());
+    auto result      = p.eval(params).back();
+    EXPECT(result.data() == reinterpret_cast<char*>(data_vec.data()));
+    std::vector<float> gold = {0, 0, 1, 2, 3, 4, 0, 0, 0, 0, 5, 6, 7, 8, 0, 0};
+    EXPECT(migraphx::verify_range(data_vec, gold));
+
+    offset_vec = {3};
+    EXPECT(test::throws([&] { p.eval(params); }));
+}
+
+TEST_CASE(write_slice_literal_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    migraphx::shape us{migraphx::shape::float_type, {1}};
+    migraphx::shape os{migraphx::shape::int64_type, {1}};
+    auto data   = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4}});
+    auto update = mm->add_parameter("update", us);
+    auto offset = mm->add_parameter("offset", os);
+    auto r =
+        mm->add_instruction(migraphx::make_op("write_slice", {{"axis", 0}}), data, update, offset);
+    auto sum = mm->add_instruction(migraphx::make_op("add"), data, r);
+    mm->add_return({r, sum});
+    p.compile(migraphx::ref::target{});
+
+    std::vector<float> update_vec   = {5};
+    std::vector<int64_t> offset_vec = {1};
+    migraphx::parameter_map params;
+    params["update"] = migraphx::argument(us, update_vec.data());
+    params["offset"] = migraphx::argument(os, offset_vec.data());
+    auto results     = p.eval(params);
+    std::vector<float> r1;
+    std::vector<float> sum1;
+    results[0].visit([&](auto v) { r1.assign(v.begin(), v.end()); });
+    results[1].visit([&](auto v) { sum1.assign(v.begin(), v.end()); });
+    EXPECT(migraphx::verify_range(r1, std::vector<float>{1, 5, 3, 4}));
+    // The literal still holds its values for the other users
+    EXPECT(migraphx::verify_range(sum1, std::vector<float>{2, 7, 6, 8}));
+
+    offset_vec = {3};
+    results    = p.eval(params);
+    results[0].visit([&](auto v) { r1.assign(v.begin(), v.end()); });
+    EXPECT(migraphx::verify_range(r1, std::vector<float>{1, 2, 3, 5}));
+}
+
+TEST_CASE(write_slice_shared_param_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    migraphx::shape us{migraphx::shape::float_type, {1}};
+    migraphx::shape os{migraphx::shape::int64_type, {1}};
+    auto data   = mm->add_parameter("data", s);
+    auto update = mm->add_parameter("update", us);
+    auto offset = mm->add_parameter("offset", os);
+    auto r =
+        mm->add_instruction(migraphx::make_op("write_slice", {{"axis", 0}}), data, update, offset);
+    auto neg = mm->add_instruction(migraphx::make_op("neg"), data);
+    mm->add_return({r, neg});
+    p.compile(migraphx::ref::target{});
+
+    std::vector<float> data_vec     = {1, 2, 3, 4};
+    std::vector<float> update_vec   = {5};
+    std::vector<int64_t> offset_vec = {0};
+    migraphx::parameter_map params;
+    params["data"]   = migraphx::argument(s, data_vec.data());
+    params["update"] = migraphx::argument(us, update_vec.data());
+    params["offset"] = migraphx::argument(os, offset_vec.data());
+    auto results     = p.eval(params);
+    // The data is read by another instruction, so it is copied instead of written in place
+    EXPECT(results[0].data() != reinterpret_cast<char*>(data_vec.data()));
+    EXPECT(migraphx::verify_range(data_vec, std::vector<float>{1, 2, 3, 4}));
+    std::vector<float> r1;
+    results[0].visit([&](auto v) { r1.assign(v.begin(), v.end()); });
+    EXPECT(migraphx::verify_range(r1, std::vector<float>{5, 2, 3, 4}));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,89 @@
+#include <migraphx/rewrite_resize.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ranges.hpp>
+#include <test.hpp>
+#include <migraphx/make_op.hpp>
+
+#include <migraphx/verify.hpp>
+#include <algorithm>
+
+static void opt_resize(migraphx::module& m)
+{
+    migraphx::rewrite_resize rr;
+    migraphx::dead_code_elimination dce;
+    rr.apply(m);
+    dce.apply(m);
+}
+
+static migraphx::program create_resize_program(const migraphx::value& v, bool transpose)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {1, 2, 3, 5}};
+    auto input = mm->add_literal(migraphx::generate_literal(s, 1));
+    if(transpose)
+        input =
+            mm->add_instruction(migraphx::make_op("transpose", {{"dims", {0, 1, 3, 2}}}), input);
+    auto ret = mm->add_instruction(migraphx::make_op("resize", v), input);
+    mm->add_return({ret});
+    return p;
+}
+
+static void test_rewrite_resize(const migraphx::value& v, bool transpose = false)
+{
+    migraphx::program p1 = create_resize_program(v, transpose);
+    migraphx::program p2 = create_resize_program(v, transpose);
+    opt_resize(*p2.get_main_module());
+    EXPECT(migraphx::none_of(*p2.get_main_module(),
+                             [](const auto& ins) { return ins.name() == "resize"; }));
+    p1.compile(migraphx::ref::target{});
+    p2.compile(migraphx::ref::target{});
+    auto result1 = p1.eval({}).back();
+    auto result2 = p2.eval({}).back();
+    EXPECT(result1.get_shape() == result2.get_shape());
+    visit_all(result1, result2)([&](auto r1, auto r2) { EXPECT(migraphx::verify_range(r1, r2)); });
+}
+
+TEST_CASE(rewrite_resize_nearest)
+{
+    test_rewrite_resize({{"sizes", {1, 2, 7, 4}}});
+    test_rewrite_resize({{"sizes", {1, 2, 10, 2}},
+                         {"coordinate_transformation_mode", "asymmetric"},
+                         {"nearest_mode", "ceil"}},
+                        true);
+}
+
+TEST_CASE(rewrite_resize_linear)
+{
+    test_rewrite_resize({{"sizes", {1, 2, 6, 8}}, {"mode", "linear"}});
+    test_rewrite_resize({{"sizes", {1, 2, 3, 3}},
+                         {"mode", "linear"},
+                         {"coordinate_transformation_mode", "align_corners"}},
+                        true);
+}
+
+TEST_CASE(rewrite_resize_cubic)
+{
+    test_rewrite_resize({{"sizes", {1, 2, 7, 9}}, {"mode", "cubic"}});
+    test_rewrite_resize({{"sizes", {1, 2, 8, 5}}, {"mode", "cubic"}, {"exclude_outside", true}},
+                        true);
+}
+
+TEST_CASE(rewrite_resize_nearest_gather)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 2}};
+    auto x = m.add_parameter("x", s);
+    m.add_instruction(migraphx::make_op("resize", {{"sizes", {1, 1, 4, 6}}}), x);
+    opt_resize(m);
+    EXPECT(std::count_if(
+               m.begin(), m.end(), [](const auto& ins) { return ins.name() == "gather"; }) == 1);
+    EXPECT(std::prev(m.end())->get_shape() ==
+           migraphx::shape{migraphx::shape::float_type, {1, 1, 4, 6}});
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
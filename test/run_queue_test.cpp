@@ -0,0 +1,140 @@
+#include <migraphx/run_queue.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/ref/target.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "test.hpp"
+
+migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_parameter("y", s);
+    mm->add_instruction(migraphx::make_op("add"), x, y);
+    p.compile(migraphx::ref::target{});
+    return p;
+}
+
+migraphx::parameter_map create_params(std::vector<float>& x, std::vector<float>& y)
+{
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    return {{"x", migraphx::argument{s, x.data()}}, {"y", migraphx::argument{s, y.data()}}};
+}
+
+std::vector<float> to_vector(const migraphx::argument& a)
+{
+    std::vector<float> result;
+    a.visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    return result;
+}
+
+// Blocks the worker until it is released, so requests stay in the queue
+struct blocker
+{
+    std::mutex m;
+    std::condition_variable cv;
+    bool started  = false;
+    bool released = false;
+
+    migraphx::run_callback callback()
+    {
+        return [this](migraphx::run_status) {
+            std::unique_lock<std::mutex> lock(m);
+            started = true;
+            cv.notify_all();
+            cv.wait(lock, [&] { return released; });
+        };
+    }
+
+    void wait_started()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&] { return started; });
+    }
+
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            released = true;
+        }
+        cv.notify_all();
+    }
+};
+
+TEST_CASE(run_queue_submit)
+{
+    std::vector<float> x = {1, 2, 3};
+    std::vector<float> y = {4, 5, 6};
+    std::atomic<int> completed{0};
+    {
+        migraphx::run_queue q{create_program(), {2, 4}};
+        std::vector<migraphx::run_request> requests;
+        for(int i = 0; i < 8; i++)
+            requests.push_back(q.submit(create_params(x, y), {}, [&](migraphx::run_status s) {
+                if(s == migraphx::run_status::completed)
+                    completed++;
+            }));
+        for(auto&& r : requests)
+        {
+            auto results = r.get();
+            EXPECT(results.size() == 1);
+            EXPECT(to_vector(results.front()) == std::vector<float>{5, 7, 9});
+            EXPECT(bool{r.status() == migraphx::run_status::completed});
+        }
+    }
+    // The callbacks have finished once the workers are joined
+    EXPECT(completed == 8);
+}
+
+TEST_CASE(run_queue_outputs)
+{
+    std::vector<float> x = {1, 2, 3};
+    std::vector<float> y = {4, 5, 6};
+    std::vector<float> z(3);
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    migraphx::run_queue q{create_program()};
+    auto r = q.submit(create_params(x, y), {migraphx::argument{s, z.data()}});
+    r.wait();
+    EXPECT(r.done());
+    EXPECT(r.get().front().data() == reinterpret_cast<char*>(z.data()));
+    EXPECT(z == std::vector<float>{5, 7, 9});
+}
+
+TEST_CASE(run_queue_reject_and_cancel)
+{
+    std::vector<float> x = {1, 2, 3};
+    std::vector<float> y = {4, 5, 6};
+    blocker b;
+    migraphx::run_queue q{create_program(), {1, 1}};
+    auto r1 = q.submit(create_params(x, y), {}, b.callback());
+    b.wait_started();
+    auto r2 = q.try_submit(create_params(x, y));
+    EXPECT(bool{r2.status() == migraphx::run_status::queued});
+    EXPECT(q.size() == 1);
+    auto r3 = q.try_submit(create_params(x, y));
+    EXPECT(bool{r3.status() == migraphx::run_status::rejected});
+    EXPECT(test::throws([&] { r3.get(); }));
+    EXPECT(q.cancel(r2));
+    EXPECT(not q.cancel(r1));
+    EXPECT(bool{r2.status() == migraphx::run_status::cancelled});
+    EXPECT(q.size() == 0);
+    b.release();
+    EXPECT(to_vector(r1.get().front()) == std::vector<float>{5, 7, 9});
+}
+
+TEST_CASE(run_queue_failure)
+{
+    std::vector<float> x = {1, 2, 3};
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    migraphx::run_queue q{create_program()};
+    auto r = q.submit({{"x", migraphx::argument{s, x.data()}}});
+    EXPECT(test::throws([&] { r.get(); }));
+    EXPECT(bool{r.status() == migraphx::run_status::failed});
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -3,6 +3,7 @@
 #include <migraphx/load_save.hpp>
 #include "test.hpp"
 #include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
 
 #include <cstdio>
 
@@ -56,6 +57,33 @@ TEST_CASE(as_file)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(as_msgpack_literals)
+{
+    migraphx::program p1;
+    auto* mm = p1.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 16}};
+    auto x = mm->add_parameter("x", s);
+
+    auto* then_mod = p1.create_module("then_mod");
+    auto l1        = then_mod->add_literal(migraphx::generate_literal(s, 1));
+    then_mod->add_return({then_mod->add_instruction(migraphx::make_op("add"), x, l1)});
+
+    auto* else_mod = p1.create_module("else_mod");
+    auto l2        = else_mod->add_literal(migraphx::generate_literal(s, 2));
+    else_mod->add_return({else_mod->add_instruction(migraphx::make_op("mul"), x, l2)});
+
+    auto l3   = mm->add_literal(migraphx::generate_literal(s, 3));
+    auto l4   = mm->add_literal(migraphx::literal{{migraphx::shape::int8_type, {3}}, {1, 2, 3}});
+    auto cond = mm->add_parameter("cond", {migraphx::shape::bool_type, {1}});
+    auto ret  = mm->add_instruction(migraphx::make_op("if"), {cond}, {then_mod, else_mod});
+    mm->add_return({ret, l3, l4});
+
+    std::vector<char> buffer = migraphx::save_buffer(p1);
+    migraphx::program p2     = migraphx::load_buffer(buffer);
+    EXPECT(p1.sort() == p2.sort());
+    EXPECT(p1.to_value() == p2.to_value());
+}
+
 TEST_CASE(compiled)
 {
     migraphx::program p1 = create_program();
@@ -65,6 +93,18 @@ TEST_CASE(compiled)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(compiled_offload_copy)
+{
+    migraphx::program p1 = create_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p1.compile(migraphx::ref::target{}, options);
+    migraphx::program p2;
+    p2.from_value(p1.to_value());
+    EXPECT(p2.get_target_name() == "ref");
+    EXPECT(p2.is_offload_copy());
+}
+
 TEST_CASE(unknown_format)
 {
     migraphx::file_options options;
@@ -0,0 +1,121 @@
+#include <migraphx/session.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/verify.hpp>
+#include "test.hpp"
+
+std::vector<float> to_vector(const migraphx::argument& a)
+{
+    std::vector<float> result;
+    a.visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    return result;
+}
+
+migraphx::program create_accumulate_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    auto x     = mm->add_parameter("x", s);
+    auto h     = mm->add_parameter("h", s);
+    auto hnext = mm->add_instruction(migraphx::make_op("add"), x, h);
+    mm->add_return({hnext});
+    p.compile(migraphx::ref::target{});
+    return p;
+}
+
+// Appends the new key to the cache at the position held by the session and returns the sum of
+// the keys seen so far along with the next position
+migraphx::program create_cache_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{migraphx::shape::float_type, {1, 4, 2}};
+    migraphx::shape ks{migraphx::shape::float_type, {1, 1, 2}};
+    migraphx::shape ps{migraphx::shape::int64_type, {1}};
+    auto cache = mm->add_parameter("cache", cs);
+    auto key   = mm->add_parameter("key", ks);
+    auto pos   = mm->add_parameter("pos", ps);
+    auto one   = mm->add_literal(migraphx::literal{ps, {1}});
+
+    auto kv = mm->add_instruction(migraphx::make_op("write_slice", {{"axis", 1}}), cache, key, pos);
+
+    auto sum  = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), kv);
+    auto next = mm->add_instruction(migraphx::make_op("add"), pos, one);
+    mm->add_return({sum, next, kv});
+    p.compile(migraphx::ref::target{});
+    return p;
+}
+
+TEST_CASE(session_accumulate)
+{
+    migraphx::session sess{create_accumulate_program()};
+    sess.add_state("h", 0);
+    EXPECT(sess.has_state("h"));
+    EXPECT(sess.get_state_names() == std::vector<std::string>{"h"});
+
+    std::vector<float> x = {1, 2, 3};
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    for(int i = 0; i < 3; i++)
+        sess.eval({{"x", migraphx::argument(s, x.data())}});
+    EXPECT(migraphx::verify_range(to_vector(sess.get_state("h")), std::vector<float>{3, 6, 9}));
+
+    sess.reset();
+    EXPECT(migraphx::verify_range(to_vector(sess.get_state("h")), std::vector<float>{0, 0, 0}));
+
+    std::vector<float> h = {1, 1, 1};
+    sess.set_state("h", migraphx::argument(s, h.data()));
+    auto result = sess.eval({{"x", migraphx::argument(s, x.data())}}).back();
+    EXPECT(migraphx::verify_range(to_vector(result), std::vector<float>{2, 3, 4}));
+}
+
+TEST_CASE(session_cache_append)
+{
+    migraphx::session sess{create_cache_program()};
+    sess.add_state("cache");
+    sess.add_state("pos", 1);
+    auto cache = sess.get_state("cache");
+
+    migraphx::shape ks{migraphx::shape::float_type, {1, 1, 2}};
+    std::vector<std::vector<float>> sums;
+    for(int i = 0; i < 4; i++)
+    {
+        std::vector<float> key = {float(i + 1), float(10 * (i + 1))};
+        auto results           = sess.eval({{"key", migraphx::argument(ks, key.data())}});
+        // The cache is updated in place instead of being copied back
+        EXPECT(results.back().data() == cache.data());
+        sums.push_back(to_vector(results.front()));
+    }
+    EXPECT(sess.get_state("cache").data() == cache.data());
+    EXPECT(migraphx::verify_range(to_vector(cache),
+                                  std::vector<float>{1, 10, 2, 20, 3, 30, 4, 40}));
+    EXPECT(migraphx::verify_range(sums.back(), std::vector<float>{10, 100}));
+    EXPECT(migraphx::verify_range(sums.front(), std::vector<float>{1, 10}));
+    sess.get_state("pos").visit([](auto pos) { EXPECT(pos.front() == 4); });
+
+    // The cache is full
+    std::vector<float> key = {5, 50};
+    EXPECT(test::throws([&] { sess.eval({{"key", migraphx::argument(ks, key.data())}}); }));
+}
+
+TEST_CASE(session_invalid_state)
+{
+    migraphx::session sess{create_accumulate_program()};
+    EXPECT(test::throws([&] { sess.add_state("y"); }));
+    EXPECT(test::throws([&] {
+        sess.add_state("h", migraphx::generate_argument({migraphx::shape::float_type, {2}}));
+    }));
+    sess.add_state("h", 0);
+    EXPECT(test::throws([&] { sess.add_state("h"); }));
+    EXPECT(test::throws([&] { sess.get_state("x"); }));
+
+    std::vector<float> x = {1, 2, 3};
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    EXPECT(test::throws([&] {
+        sess.eval({{"x", migraphx::argument(s, x.data())}, {"h", migraphx::argument(s, x.data())}});
+    }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
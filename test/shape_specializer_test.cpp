@@ -0,0 +1,140 @@
+#include <migraphx/shape_specializer.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/verify.hpp>
+#include "test.hpp"
+#include <thread>
+
+migraphx::program create_program(std::size_t batch)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape ws{migraphx::shape::float_type, {3, 4}};
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {batch, 3}});
+    auto w   = mm->add_literal(migraphx::generate_literal(ws));
+    auto b   = mm->add_literal(migraphx::generate_literal(ws, 1));
+    auto wb  = mm->add_instruction(migraphx::make_op("add"), w, b);
+    auto dot = mm->add_instruction(migraphx::make_op("dot"), x, wb);
+    auto r   = mm->add_instruction(migraphx::make_op("relu"), dot);
+    mm->add_return({r});
+    return p;
+}
+
+std::vector<float> run(migraphx::program p, const migraphx::argument& x)
+{
+    p.compile(migraphx::ref::target{});
+    std::vector<float> result;
+    p.eval({{"x", x}}).back().visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    return result;
+}
+
+TEST_CASE(specialize_parameters)
+{
+    auto p = create_program(2);
+    migraphx::shape s{migraphx::shape::float_type, {5, 3}};
+    auto sp = migraphx::specialize_parameters(p, {{"x", s}});
+    EXPECT(sp.get_parameter_shape("x") == s);
+    EXPECT(sp.get_output_shapes().front() ==
+           migraphx::shape{migraphx::shape::float_type, {5, 4}});
+    EXPECT(p.get_parameter_shape("x") == migraphx::shape{migraphx::shape::float_type, {2, 3}});
+
+    auto x = migraphx::generate_argument(s);
+    EXPECT(migraphx::verify_range(run(sp, x), run(create_program(5), x)));
+}
+
+TEST_CASE(specialize_parameters_error)
+{
+    auto p = create_program(2);
+    EXPECT(test::throws([&] {
+        migraphx::specialize_parameters(p, {{"y", {migraphx::shape::float_type, {5, 3}}}});
+    }));
+    EXPECT(test::throws([&] {
+        migraphx::specialize_parameters(p, {{"x", {migraphx::shape::float_type, {5, 2}}}});
+    }));
+
+    migraphx::program p2;
+    auto* mm = p2.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {2, 3}});
+    mm->add_instruction(migraphx::make_op("reshape", {{"dims", {3, 2}}}), x);
+    EXPECT(test::throws([&] {
+        migraphx::specialize_parameters(p2, {{"x", {migraphx::shape::float_type, {4, 3}}}});
+    }));
+}
+
+TEST_CASE(shape_specializer_eval)
+{
+    migraphx::shape_specializer ss{create_program(1), migraphx::ref::target{}};
+    EXPECT(ss.size() == 0);
+    for(std::size_t batch : {4, 7, 4, 1, 7})
+    {
+        auto x       = migraphx::generate_argument({migraphx::shape::float_type, {batch, 3}});
+        auto results = ss.eval({{"x", x}});
+        std::vector<float> result;
+        results.back().visit([&](auto v) { result.assign(v.begin(), v.end()); });
+        EXPECT(migraphx::verify_range(result, run(create_program(batch), x)));
+    }
+    EXPECT(ss.size() == 3);
+
+    auto p4 = ss.compile({{"x", {migraphx::shape::float_type, {4, 3}}}});
+    EXPECT(p4->is_compiled());
+    EXPECT(p4 == ss.compile({{"x", {migraphx::shape::float_type, {4, 3}}}}));
+    EXPECT(ss.size() == 3);
+}
+
+TEST_CASE(shape_specializer_capacity)
+{
+    migraphx::shape_specializer ss{create_program(1), migraphx::ref::target{}, {}, 2};
+    auto compile = [&](std::size_t batch) {
+        return ss.compile({{"x", {migraphx::shape::float_type, {batch, 3}}}});
+    };
+    auto p1 = compile(1);
+    auto p2 = compile(2);
+    // Using the first program again makes the second one the least recently used
+    EXPECT(p1 == compile(1));
+    auto p3 = compile(3);
+    EXPECT(ss.size() == 2);
+    EXPECT(p1 == compile(1));
+    EXPECT(p3 == compile(3));
+    EXPECT(p2 != compile(2));
+    EXPECT(ss.size() == 2);
+    // A dropped program can still be run
+    auto x = migraphx::generate_argument({migraphx::shape::float_type, {2, 3}});
+    std::vector<float> result;
+    p2->eval({{"x", x}}).back().visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    EXPECT(migraphx::verify_range(result, run(create_program(2), x)));
+
+    EXPECT(test::throws([] {
+        migraphx::shape_specializer{create_program(1), migraphx::ref::target{}, {}, 0};
+    }));
+}
+
+TEST_CASE(shape_specializer_concurrent_eval)
+{
+    migraphx::shape_specializer ss{create_program(1), migraphx::ref::target{}};
+    std::vector<std::size_t> batches = {3, 5, 3, 5, 3, 5, 3, 5};
+    std::vector<migraphx::argument> inputs;
+    std::transform(batches.begin(), batches.end(), std::back_inserter(inputs), [](auto batch) {
+        return migraphx::generate_argument({migraphx::shape::float_type, {batch, 3}}, batch);
+    });
+    std::vector<std::vector<float>> results(batches.size());
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < batches.size(); i++)
+    {
+        threads.emplace_back([&, i] {
+            for(int j = 0; j < 4; j++)
+            {
+                ss.eval({{"x", inputs[i]}}).back().visit(
+                    [&](auto v) { results[i].assign(v.begin(), v.end()); });
+            }
+        });
+    }
+    for(auto& th : threads)
+        th.join();
+    EXPECT(ss.size() == 2);
+    for(std::size_t i = 0; i < batches.size(); i++)
+        EXPECT(migraphx::verify_range(results[i], run(create_program(batches[i]), inputs[i])));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -689,6 +689,60 @@ TEST_CASE(optimize_resize_ind_non_const)
     EXPECT(m == create_resize_module());
 }
 
+TEST_CASE(optimize_resize_op)
+{
+    migraphx::shape sx{migraphx::shape::float_type, {1, 1, 2, 2}};
+    migraphx::module m1;
+    {
+        auto inx = m1.add_parameter("X", sx);
+        auto rs  = m1.add_instruction(migraphx::make_op("resize", {{"sizes", {1, 1, 4, 6}}}), inx);
+        auto r   = m1.add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), rs);
+        m1.add_return({r});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto inx                  = m2.add_parameter("X", sx);
+        std::vector<int64_t> dims = {1, 1, 2, 1, 2, 1};
+        auto rspx = m2.add_instruction(migraphx::make_op("reshape", {{"dims", dims}}), inx);
+        std::vector<int64_t> mb_dims = {1, 1, 2, 2, 2, 3};
+        auto mbx                     = m2.add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", mb_dims}}), rspx);
+        auto std_mb                    = m2.add_instruction(migraphx::make_op("contiguous"), mbx);
+        std::vector<int64_t> orig_dims = {1, 1, 4, 6};
+        auto rmb = m2.add_instruction(migraphx::make_op("reshape", {{"dims", orig_dims}}), std_mb);
+        auto r   = m2.add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), rmb);
+        m2.add_return({r});
+    }
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(optimize_resize_op_not_apply)
+{
+    migraphx::shape sx{migraphx::shape::float_type, {1, 1, 2, 2}};
+    auto create_resize_module = [&](const migraphx::value& v) {
+        migraphx::module m;
+        auto inx = m.add_parameter("X", sx);
+        auto r   = m.add_instruction(migraphx::make_op("resize", v), inx);
+        m.add_return({r});
+        return m;
+    };
+
+    std::vector<migraphx::value> attributes = {
+        {{"sizes", {1, 1, 4, 4}}, {"mode", "linear"}},
+        {{"sizes", {1, 1, 4, 4}},
+         {"coordinate_transformation_mode", "asymmetric"},
+         {"nearest_mode", "ceil"}},
+        {{"sizes", {1, 1, 3, 4}}}};
+    for(const auto& v : attributes)
+    {
+        auto m = create_resize_module(v);
+        run_pass(m);
+        EXPECT(m == create_resize_module(v));
+    }
+}
+
 TEST_CASE(optimize_where_true)
 {
     migraphx::shape s{migraphx::shape::float_type, {1, 1, 3, 2}};
@@ -936,4 +990,122 @@ TEST_CASE(reshape_cont_nonpw)
     EXPECT(m1 == create_module());
 }
 
+TEST_CASE(transpose_pointwise)
+{
+    auto create_module = [] {
+        migraphx::module m;
+        migraphx::shape s{migraphx::shape::float_type, {1, 3, 4, 5}};
+        auto x    = m.add_parameter("x", s);
+        auto y    = m.add_parameter("y", s);
+        auto xt   = m.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 3, 1}}}), x);
+        auto yt   = m.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 3, 1}}}), y);
+        auto add  = m.add_instruction(migraphx::make_op("add"), xt, yt);
+        auto relu = m.add_instruction(migraphx::make_op("relu"), add);
+        auto t = m.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 3, 1, 2}}}), relu);
+        m.add_return({t});
+        return m;
+    };
+
+    auto m1 = create_module();
+    run_pass(m1);
+
+    auto create_opt_module = [] {
+        migraphx::module m;
+        migraphx::shape s{migraphx::shape::float_type, {1, 3, 4, 5}};
+        auto x    = m.add_parameter("x", s);
+        auto y    = m.add_parameter("y", s);
+        auto add  = m.add_instruction(migraphx::make_op("add"), x, y);
+        auto relu = m.add_instruction(migraphx::make_op("relu"), add);
+        m.add_return({relu});
+        return m;
+    };
+
+    EXPECT(m1 == create_opt_module());
+}
+
+TEST_CASE(transpose_pointwise_broadcast)
+{
+    auto create_module = [] {
+        migraphx::module m;
+        migraphx::shape s{migraphx::shape::float_type, {1, 3, 4, 5}};
+        migraphx::shape bs{migraphx::shape::float_type, {3}};
+        auto x  = m.add_parameter("x", s);
+        auto b  = m.add_parameter("b", bs);
+        auto xt = m.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 3, 1}}}), x);
+        auto bb = m.add_instruction(
+            migraphx::make_op("broadcast", {{"axis", 3}, {"dims", {1, 4, 5, 3}}}), b);
+        auto add = m.add_instruction(migraphx::make_op("add"), xt, bb);
+        auto t   = m.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 3, 1, 2}}}), add);
+        m.add_return({t});
+        return m;
+    };
+
+    auto m1 = create_module();
+    run_pass(m1);
+
+    auto create_opt_module = [] {
+        migraphx::module m;
+        migraphx::shape s{migraphx::shape::float_type, {1, 3, 4, 5}};
+        migraphx::shape bs{migraphx::shape::float_type, {3}};
+        auto x  = m.add_parameter("x", s);
+        auto b  = m.add_parameter("b", bs);
+        auto bb = m.add_instruction(
+            migraphx::make_op("broadcast", {{"axis", 3}, {"dims", {1, 4, 5, 3}}}), b);
+        auto bt  = m.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 3, 1, 2}}}), bb);
+        auto add = m.add_instruction(migraphx::make_op("add"), x, bt);
+        m.add_return({add});
+        return m;
+    };
+
+    EXPECT(m1 == create_opt_module());
+}
+
+TEST_CASE(transpose_pointwise_not_apply)
+{
+    auto create_module = [] {
+        migraphx::module m;
+        migraphx::shape s{migraphx::shape::float_type, {1, 3, 4, 5}};
+        migraphx::shape sy{migraphx::shape::float_type, {1, 4, 5, 3}};
+        auto x   = m.add_parameter("x", s);
+        auto y   = m.add_parameter("y", sy);
+        auto xt  = m.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 3, 1}}}), x);
+        auto add = m.add_instruction(migraphx::make_op("add"), xt, y);
+        m.add_return({add});
+        return m;
+    };
+
+    auto m1 = create_module();
+    run_pass(m1);
+
+    EXPECT(m1 == create_module());
+}
+
+TEST_CASE(transpose_reduce)
+{
+    auto create_module = [] {
+        migraphx::module m;
+        migraphx::shape s{migraphx::shape::float_type, {2, 3, 4, 5}};
+        auto x  = m.add_parameter("x", s);
+        auto xt = m.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 3, 1}}}), x);
+        auto rm = m.add_instruction(migraphx::make_op("reduce_mean", {{"axes", {1, -2}}}), xt);
+        m.add_return({rm});
+        return m;
+    };
+
+    auto m1 = create_module();
+    run_pass(m1);
+
+    auto create_opt_module = [] {
+        migraphx::module m;
+        migraphx::shape s{migraphx::shape::float_type, {2, 3, 4, 5}};
+        auto x  = m.add_parameter("x", s);
+        auto rm = m.add_instruction(migraphx::make_op("reduce_mean", {{"axes", {2, 3}}}), x);
+        auto t  = m.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 3, 1}}}), rm);
+        m.add_return({t});
+        return m;
+    };
+
+    EXPECT(m1 == create_opt_module());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
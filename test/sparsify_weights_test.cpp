@@ -0,0 +1,122 @@
+#include <migraphx/sparsify_weights.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ranges.hpp>
+#include <test.hpp>
+#include <migraphx/make_op.hpp>
+
+#include <migraphx/verify.hpp>
+#include <algorithm>
+
+static void opt_sparse(migraphx::module& m, float density, std::size_t block_size)
+{
+    migraphx::sparsify_weights sw{density, block_size, true};
+    migraphx::dead_code_elimination dce;
+    sw.apply(m);
+    dce.apply(m);
+}
+
+// Weights where about one in step values is nonzero
+static migraphx::literal create_weights(const migraphx::shape& s, std::size_t step)
+{
+    std::vector<float> data(s.elements());
+    for(std::size_t i = 0; i < data.size(); i++)
+        data[i] = (i * 7) % step == 0 ? float(i % 13) - 6.0f : 0.0f;
+    return migraphx::literal{s, data};
+}
+
+static migraphx::program create_dot_program(const migraphx::shape& as,
+                                            const migraphx::shape& ws,
+                                            std::size_t step,
+                                            float alpha = 1)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto a   = mm->add_literal(migraphx::generate_literal(as, 1));
+    auto w   = mm->add_literal(create_weights(ws, step));
+    if(ws.lens().size() < as.lens().size())
+    {
+        auto lens = as.lens();
+        std::copy(ws.lens().begin(), ws.lens().end(), lens.end() - 2);
+        w = mm->add_instruction(migraphx::make_op("multibroadcast", {{"output_lens", lens}}), w);
+    }
+    auto dot =
+        mm->add_instruction(migraphx::make_op("dot", {{"alpha", alpha}, {"beta", 0}}), a, w);
+    mm->add_return({dot});
+    return p;
+}
+
+static bool has_sparse_dot(const migraphx::module& m)
+{
+    return migraphx::any_of(m, [](const auto& ins) { return ins.name() == "sparse_dot"; });
+}
+
+static void test_sparsify(const migraphx::shape& as,
+                          const migraphx::shape& ws,
+                          std::size_t step,
+                          std::size_t block_size,
+                          float alpha = 1)
+{
+    migraphx::program p1 = create_dot_program(as, ws, step, alpha);
+    migraphx::program p2 = create_dot_program(as, ws, step, alpha);
+    opt_sparse(*p2.get_main_module(), 0.5, block_size);
+    EXPECT(has_sparse_dot(*p2.get_main_module()));
+    EXPECT(migraphx::none_of(*p2.get_main_module(),
+                             [](const auto& ins) { return ins.name() == "dot"; }));
+    p1.compile(migraphx::ref::target{});
+    p2.compile(migraphx::ref::target{});
+    auto result1 = p1.eval({}).back();
+    auto result2 = p2.eval({}).back();
+    EXPECT(result1.get_shape() == result2.get_shape());
+    visit_all(result1, result2)([&](auto r1, auto r2) { EXPECT(migraphx::verify_range(r1, r2)); });
+}
+
+TEST_CASE(sparsify_csr)
+{
+    test_sparsify(
+        {migraphx::shape::float_type, {3, 40}}, {migraphx::shape::float_type, {40, 30}}, 5, 1);
+}
+
+TEST_CASE(sparsify_block)
+{
+    test_sparsify(
+        {migraphx::shape::float_type, {2, 3, 40}}, {migraphx::shape::float_type, {40, 30}}, 13, 4);
+}
+
+TEST_CASE(sparsify_alpha)
+{
+    test_sparsify(
+        {migraphx::shape::float_type, {5, 17}}, {migraphx::shape::float_type, {17, 9}}, 4, 1, 2);
+}
+
+TEST_CASE(sparsify_dense)
+{
+    migraphx::shape as{migraphx::shape::float_type, {3, 40}};
+    migraphx::shape ws{migraphx::shape::float_type, {40, 30}};
+    auto p = create_dot_program(as, ws, 1);
+    opt_sparse(*p.get_main_module(), 0.5, 1);
+    EXPECT(not has_sparse_dot(*p.get_main_module()));
+
+    // Most blocks of 8 have a nonzero value even though most values are zero
+    auto p2 = create_dot_program(as, ws, 5);
+    opt_sparse(*p2.get_main_module(), 0.5, 8);
+    EXPECT(not has_sparse_dot(*p2.get_main_module()));
+}
+
+TEST_CASE(sparsify_zero)
+{
+    migraphx::module m;
+    migraphx::shape ws{migraphx::shape::float_type, {4, 6}};
+    auto a = m.add_parameter("a", {migraphx::shape::float_type, {2, 4}});
+    auto w = m.add_literal(migraphx::literal{ws, std::vector<float>(ws.elements())});
+    m.add_instruction(migraphx::make_op("dot"), a, w);
+    opt_sparse(m, 0.5, 4);
+    EXPECT(has_sparse_dot(m));
+    EXPECT(std::prev(m.end())->get_shape() ==
+           migraphx::shape{migraphx::shape::float_type, {2, 6}});
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
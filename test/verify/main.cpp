@@ -47,12 +47,18 @@ int main(int argc, const char* argv[])
     rv.disable_test_for("cpu", {"test_if_lp", "test_if_param", "test_if_literal"});
     rv.disable_test_for("gpu",
                         {"batch_quant_dot_2",
+                         "test_dequantize_dot",
+                         "test_dequantize_dot_half",
+                         "test_dequantize_dot_int4",
                          "batch_quant_dot_3",
                          "batch_quant_dot_5",
                          "quant_dot_3args_1",
                          "quant_dot_3args_2",
                          "quant_dot_3args_3",
                          "quant_dot_3args_4",
-                         "quant_dot_3args_5"});
+                         "quant_dot_3args_5",
+                         "test_sparse_dot",
+                         "test_sparse_dot_block",
+                         "test_pooling_4d"});
     rv.run(argc, argv);
 }
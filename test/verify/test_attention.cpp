@@ -0,0 +1,80 @@
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <cmath>
+
+struct test_attention : verify_program<test_attention>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape qs{migraphx::shape::float_type, {2, 3, 40, 16}};
+        migraphx::shape kts{migraphx::shape::float_type, {2, 3, 16, 70}};
+        migraphx::shape vs{migraphx::shape::float_type, {2, 3, 70, 8}};
+        migraphx::shape ms{migraphx::shape::float_type, {2, 1, 40, 70}};
+        std::vector<std::size_t> score_lens{2, 3, 40, 70};
+        auto q            = mm->add_parameter("q", qs);
+        auto kt           = mm->add_parameter("kt", kts);
+        auto v            = mm->add_parameter("v", vs);
+        auto mask         = mm->add_parameter("mask", ms);
+        auto scale        = mm->add_literal(0.25f);
+        auto qk           = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto scale_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", score_lens}}), scale);
+        auto scaled      = mm->add_instruction(migraphx::make_op("mul"), qk, scale_mbcast);
+        auto mask_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", score_lens}}), mask);
+        auto masked  = mm->add_instruction(migraphx::make_op("add"), scaled, mask_mbcast);
+        auto softmax = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 3}}), masked);
+        mm->add_instruction(migraphx::make_op("dot"), softmax, v);
+        return p;
+    }
+};
+
+struct test_attention_transposed : verify_program<test_attention_transposed>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape qs{migraphx::shape::float_type, {4, 33, 8}};
+        migraphx::shape ks{migraphx::shape::float_type, {4, 130, 8}};
+        migraphx::shape vs{migraphx::shape::float_type, {4, 130, 8}};
+        std::vector<std::size_t> score_lens{4, 33, 130};
+        auto q  = mm->add_parameter("q", qs);
+        auto k  = mm->add_parameter("k", ks);
+        auto v  = mm->add_parameter("v", vs);
+        auto kt = mm->add_instruction(
+            migraphx::make_op("transpose", {{"dims", {0, 2, 1}}}), k);
+        auto qk       = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto d        = mm->add_literal(std::sqrt(8.0f));
+        auto d_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", score_lens}}), d);
+        auto scaled  = mm->add_instruction(migraphx::make_op("div"), qk, d_mbcast);
+        auto softmax = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 2}}), scaled);
+        mm->add_instruction(migraphx::make_op("dot"), softmax, v);
+        return p;
+    }
+};
+
+struct test_attention_negative_axis : verify_program<test_attention_negative_axis>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape qs{migraphx::shape::float_type, {3, 20, 16}};
+        migraphx::shape kts{migraphx::shape::float_type, {3, 16, 45}};
+        migraphx::shape vs{migraphx::shape::float_type, {3, 45, 8}};
+        auto q       = mm->add_parameter("q", qs);
+        auto kt      = mm->add_parameter("kt", kts);
+        auto v       = mm->add_parameter("v", vs);
+        auto qk      = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto softmax = mm->add_instruction(migraphx::make_op("softmax", {{"axis", -1}}), qk);
+        mm->add_instruction(migraphx::make_op("dot"), softmax, v);
+        return p;
+    }
+};
@@ -0,0 +1,61 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_dequantize_dot : verify_program<test_dequantize_dot>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape as{migraphx::shape::float_type, {2, 3, 300}};
+        migraphx::shape ws{migraphx::shape::int8_type, {20, 300}};
+        migraphx::shape ss{migraphx::shape::float_type, {20, 3}};
+        auto a       = mm->add_parameter("a", as);
+        auto weights = mm->add_literal(migraphx::generate_literal(ws, 1));
+        auto scales  = mm->add_literal(migraphx::generate_literal(ss, 2));
+        mm->add_instruction(
+            migraphx::make_op("dequantize_dot", {{"bits", 8}, {"group_size", 128}}),
+            a,
+            weights,
+            scales);
+        return p;
+    }
+};
+
+struct test_dequantize_dot_int4 : verify_program<test_dequantize_dot_int4>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape as{migraphx::shape::float_type, {1, 33}};
+        migraphx::shape ws{migraphx::shape::uint8_type, {50, 17}};
+        migraphx::shape ss{migraphx::shape::float_type, {50, 1}};
+        auto a       = mm->add_parameter("a", as);
+        auto weights = mm->add_literal(migraphx::generate_literal(ws, 1));
+        auto scales  = mm->add_literal(migraphx::generate_literal(ss, 2));
+        mm->add_instruction(
+            migraphx::make_op("dequantize_dot", {{"bits", 4}}), a, weights, scales);
+        return p;
+    }
+};
+
+struct test_dequantize_dot_half : verify_program<test_dequantize_dot_half>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape as{migraphx::shape::float_type, {3, 260}};
+        migraphx::shape ws{migraphx::shape::half_type, {40, 260}};
+        migraphx::shape ss{migraphx::shape::float_type, {40, 1}};
+        auto a       = mm->add_parameter("a", as);
+        auto weights = mm->add_literal(migraphx::generate_literal(ws, 1));
+        auto scales  = mm->add_literal(migraphx::generate_literal(ss, 2));
+        mm->add_instruction(
+            migraphx::make_op("dequantize_dot", {{"bits", 16}}), a, weights, scales);
+        return p;
+    }
+};
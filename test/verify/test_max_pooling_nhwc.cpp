@@ -0,0 +1,22 @@
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/pooling.hpp>
+
+struct test_max_pooling_nhwc : verify_program<test_max_pooling_nhwc>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto input =
+            mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, {2, 9, 9, 80}});
+        auto nchw =
+            mm->add_instruction(migraphx::make_op("transpose", {{"dims", {0, 3, 1, 2}}}), input);
+        auto op = migraphx::op::pooling{"max", {1, 0}, {2, 2}, {3, 2}, true};
+        mm->add_instruction(op, nchw);
+        return p;
+    }
+};
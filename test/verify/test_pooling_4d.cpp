@@ -0,0 +1,23 @@
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/pooling.hpp>
+
+struct test_pooling_4d : verify_program<test_pooling_4d>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto input = mm->add_parameter(
+            "x", migraphx::shape{migraphx::shape::float_type, {2, 3, 5, 4, 5, 6}});
+        auto max_op = migraphx::op::pooling{"max", {1, 0, 1, 0}, {2, 1, 2, 1}, {3, 2, 2, 3}};
+        auto avg_op = migraphx::op::pooling{"average", {0, 1, 0, 1}, {1, 2, 1, 2}, {2, 3, 2, 2}};
+        auto mx     = mm->add_instruction(max_op, input);
+        auto avg    = mm->add_instruction(avg_op, input);
+        mm->add_return({mx, avg});
+        return p;
+    }
+};
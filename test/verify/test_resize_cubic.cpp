@@ -0,0 +1,18 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_resize_cubic : verify_program<test_resize_cubic>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {1, 3, 4, 5}};
+        auto x = mm->add_parameter("x", s);
+        mm->add_instruction(
+            migraphx::make_op("resize", {{"sizes", {1, 3, 6, 9}}, {"mode", "cubic"}}), x);
+        return p;
+    }
+};
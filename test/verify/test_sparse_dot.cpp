@@ -0,0 +1,54 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <cstdint>
+
+// Stores about a third of the blocks, with offsets that skip some rows of the weights
+static migraphx::program create_sparse_dot_program(const migraphx::shape& as,
+                                                   std::size_t n,
+                                                   std::size_t block_size)
+{
+    migraphx::program p;
+    auto* mm     = p.get_main_module();
+    auto k       = as.lens().back();
+    auto nblocks = (n + block_size - 1) / block_size;
+    std::vector<std::int32_t> columns;
+    std::vector<std::int32_t> rows = {0};
+    for(std::size_t i = 0; i < k; i++)
+    {
+        for(std::size_t blk = i % 3; blk < nblocks; blk += 3)
+            columns.push_back(blk);
+        rows.push_back(columns.size());
+    }
+    migraphx::shape vs{migraphx::shape::float_type, {columns.size(), block_size}};
+    migraphx::shape cs{migraphx::shape::int32_type, {columns.size()}};
+    migraphx::shape rs{migraphx::shape::int32_type, {rows.size()}};
+    auto a      = mm->add_parameter("a", as);
+    auto values = mm->add_literal(migraphx::generate_literal(vs, 1));
+    auto cols   = mm->add_literal(migraphx::literal{cs, columns});
+    auto offs   = mm->add_literal(migraphx::literal{rs, rows});
+    mm->add_instruction(
+        migraphx::make_op("sparse_dot", {{"n", n}, {"block_size", block_size}}),
+        a,
+        values,
+        cols,
+        offs);
+    return p;
+}
+
+struct test_sparse_dot : verify_program<test_sparse_dot>
+{
+    migraphx::program create_program() const
+    {
+        return create_sparse_dot_program({migraphx::shape::float_type, {2, 3, 200}}, 50, 1);
+    }
+};
+
+struct test_sparse_dot_block : verify_program<test_sparse_dot_block>
+{
+    migraphx::program create_program() const
+    {
+        return create_sparse_dot_program({migraphx::shape::float_type, {1, 300}}, 70, 8);
+    }
+};
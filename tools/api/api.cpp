@@ -10,8 +10,10 @@
 #include <migraphx/ref/target.hpp>
 #include <migraphx/load_save.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/run_queue.hpp>
 #include <migraphx/json.hpp>
 #include <migraphx/convert_to_json.hpp>
+#include <migraphx/dlpack.hpp>
 #include <algorithm>
 
 namespace migraphx {
@@ -177,8 +179,57 @@ bool equal(const T& x, const T& y)
     return x == y;
 }
 
+argument argument_from_dlpack(void* t)
+{
+    return from_dlpack(static_cast<dlpack::managed_tensor*>(t));
+}
+
+void* argument_to_dlpack(const argument& a) { return to_dlpack(a); }
+
 std::vector<argument> run(program& p, const parameter_map& params) { return p.eval(params); }
 
+migraphx_run_status to_run_status(run_status s) { return static_cast<migraphx_run_status>(s); }
+
+run_status to_run_status(migraphx_run_status s) { return static_cast<run_status>(s); }
+
+bool wait_for(const run_request& r, size_t milliseconds)
+{
+    return r.wait_for(std::chrono::milliseconds{milliseconds});
+}
+
+run_queue make_run_queue(const program& p, size_t workers, size_t capacity)
+{
+    run_queue_options options;
+    options.workers  = workers;
+    options.capacity = capacity;
+    return run_queue{p, options};
+}
+
+run_callback make_run_callback(migraphx_run_callback callback, void* data)
+{
+    if(callback == nullptr)
+        return nullptr;
+    return [=](run_status s) { callback(to_run_status(s), data); };
+}
+
+run_request submit(run_queue& q,
+                   const parameter_map& params,
+                   const std::vector<argument>& outputs,
+                   migraphx_run_callback callback,
+                   void* data)
+{
+    return q.submit(params, outputs, make_run_callback(callback, data));
+}
+
+run_request try_submit(run_queue& q,
+                       const parameter_map& params,
+                       const std::vector<argument>& outputs,
+                       migraphx_run_callback callback,
+                       void* data)
+{
+    return q.try_submit(params, outputs, make_run_callback(callback, data));
+}
+
 std::vector<shape> get_output_shapes(program& p) { return p.get_output_shapes(); }
 
 void print_program(const program& p) { std::cout << p << std::endl; }
@@ -61,6 +61,19 @@ typedef struct
     const char* format;
 } migraphx_file_options;
 
+/// Status of a request submitted to a run queue
+typedef enum {
+    migraphx_run_queued,
+    migraphx_run_running,
+    migraphx_run_completed,
+    migraphx_run_failed,
+    migraphx_run_cancelled,
+    migraphx_run_rejected
+} migraphx_run_status;
+
+/// Called from a worker thread when a request finishes, data is the pointer passed on submit
+typedef void (*migraphx_run_callback)(migraphx_run_status status, void* data);
+
 <% generate_c_header() %>
 
 #ifdef __cplusplus
@@ -0,0 +1,94 @@
+#ifndef MIGRAPHX_GUARD_ALLOCATOR_HPP
+#define MIGRAPHX_GUARD_ALLOCATOR_HPP
+
+#include <cassert>
+#include <string>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <migraphx/config.hpp>
+#include <iosfwd>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+#ifdef DOXYGEN
+
+/// An interface for allocating host memory for arguments and literals
+struct allocator
+{
+    /// A name of the allocator
+    std::string name() const;
+    /// Allocate a buffer of the given size, or return nullptr if it can't be allocated
+    char* allocate(std::size_t bytes) const;
+    /// Release a buffer returned by allocate with the same size
+    void deallocate(char* p, std::size_t bytes) const;
+};
+
+#else
+
+<%
+interface('allocator',
+    virtual('name', returns='std::string', const=True),
+    virtual('allocate', bytes='std::size_t', returns='char*', const=True),
+    virtual('deallocate', p='char*', bytes='std::size_t', returns='void', const=True)
+)
+%>
+
+#endif
+
+enum class huge_pages
+{
+    /// Only use the default page size
+    none,
+    /// Ask the kernel to back large buffers with transparent huge pages
+    transparent,
+    /// Map large buffers from the reserved huge page pool, falling back to default pages
+    explicit_pages
+};
+
+/// The default allocator, which aligns buffers and can back large buffers with huge pages
+struct aligned_allocator
+{
+    std::size_t alignment = 64;
+    huge_pages pages      = huge_pages::none;
+    /// Buffers smaller than this always use the default page size
+    std::size_t huge_page_threshold = 2 * 1024 * 1024;
+
+    std::string name() const;
+    char* allocate(std::size_t bytes) const;
+    void deallocate(char* p, std::size_t bytes) const;
+};
+
+struct allocation_stats
+{
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+    /// Bytes currently allocated
+    std::size_t bytes_in_use = 0;
+    /// Largest value of bytes_in_use so far
+    std::size_t peak_bytes = 0;
+    /// Total bytes requested over all allocations
+    std::size_t total_bytes = 0;
+
+    friend std::ostream& operator<<(std::ostream& os, const allocation_stats& s);
+};
+
+/// Allocator used for new buffers, it defaults to an aligned_allocator configured with
+/// MIGRAPHX_HUGE_PAGES set to "transparent" or "explicit"
+allocator get_allocator();
+
+/// Replace the allocator for new buffers, existing buffers are released by their own allocator
+void set_allocator(allocator a);
+
+allocation_stats get_allocation_stats();
+
+/// Allocate a zero-initialized buffer with the current allocator
+std::shared_ptr<char> allocate_buffer(std::size_t bytes);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif